@@ -1,208 +1,219 @@
-#pragma once
-
-namespace Algorithms
-{
-namespace Search
-{
-    template<typename Container>
-    class MaximumSubarray
-    {
-    public:
-        struct ReturnType
-        {
-            typename Container::size_type start;
-            typename Container::size_type end;
-            typename Container::value_type sum;
-
-            ReturnType(
-                const typename Container::size_type& in_start,
-                const typename Container::size_type& in_end,
-                const typename Container::value_type& in_sum) :
-                start(in_start),
-                end(in_end),
-                sum(in_sum)
-            {
-            }
-        };
-
-        static inline ReturnType Search(
-            Container& A
-        )
-        {
-            // Convert to Container::size_type
-            return Search(A, A.cbegin(), A.cend() - 1);
-        }
-
-        static inline  ReturnType Search(
-            Container& A,
-            const typename Container::const_iterator& start,
-            const typename Container::const_iterator& end
-        )
-        {
-            return Search(A, start - A.cbegin(), end - A.cbegin());
-        }
-
-        static ReturnType Search(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end
-        )
-        {
-            using size_type = Container::size_type;
-            using value_type = Container::value_type;
-
-            // length of section to iterate over
-            size_type n = end - start;
-
-            // Booleans to simulate init to -inf
-            bool init_max_sum = true;
-            bool init_sum = true;
-
-            // Default to zero, this will be overriden.  Just here to get rid of un-init warnings
-            value_type max_sum = 0;
-            value_type sum = 0;
-
-            // Track the current lows and highs
-            size_type current_high = 0;
-            size_type current_low = 0;
-
-            // The final best low and high
-            size_type low = 0;
-            size_type high = 0;
-
-            for (size_type j = 0; j < n; ++j)
-            {
-                current_high = j;
-
-                // Our sum is above 0
-                if ((sum > 0) || init_sum)
-                {
-                    if (init_sum)
-                    {
-                        init_sum = false;
-                        sum = A[j];
-                    }
-                    else
-                    {
-                        sum += A[j];
-                    }
-                }
-                // Sum is below zero, reset the current_low var
-                else
-                {
-                    current_low = j;
-                    sum = A[j];
-                }
-
-                // Our sum is now largest
-                if ((sum > max_sum) || init_max_sum)
-                {
-                    if (init_max_sum)
-                    {
-                        init_max_sum = false;
-                    }
-
-                    // Store point at which our sum has become the largest
-                    max_sum = sum;
-                    low = current_low;
-                    high = current_high;
-                }
-            }
-
-            return ReturnType(low, high, max_sum);
-        }
-
-        // Recursive implementation is slower and worse Complexity
-        /*
-        template<typename Container>
-        ReturnType<Container> MaximumSubArray(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end
-        )
-        {
-            using CReturnType = ReturnType<Container>;
-
-            if (start == end)
-            {
-                return CReturnType(start, end, A[start]);
-            }
-            else
-            {
-                Container::size_type middle = start + ((end - start) >> 1);
-
-                CReturnType left     = MaximumSubArray(A, start, middle);
-                CReturnType right    = MaximumSubArray(A, middle + 1, end);
-                CReturnType cross    = FIND_MAX_CROSSING_SUBARRAY(A, start, middle, end);
-
-                if ((left.sum >= right.sum) && (left.sum >= cross.sum))
-                {
-                    return left;
-                }
-                else if ((right.sum >= left.sum) && (right.sum >= cross.sum))
-                {
-                    return right;
-                }
-                else
-                {
-                    return cross;
-                }
-            }
-        }
-
-        template<typename Container>
-        ReturnType<Container>FIND_MAX_CROSSING_SUBARRAY(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& middle,
-            const typename Container::size_type& end
-        )
-        {
-            using CReturnType = ReturnType<Container>;
-
-            Container::size_type    max_left    = 0;
-            Container::size_type    max_right   = 0;
-            Container::value_type   left_sum    = 0;
-            Container::value_type   right_sum   = 0;
-            Container::value_type   sum         = 0;
-            bool init_left_sum = true;
-            bool init_right_sum = true;
-
-            for (Container::size_type i = middle; i > start; --i)
-            {
-                sum += A[i];
-                if ((sum > left_sum) || init_left_sum)
-                {
-                    left_sum = sum;
-                    max_left = i;
-
-                    if (init_left_sum)
-                    {
-                        init_left_sum = false;
-                    }
-                }
-            }
-
-            sum = 0;
-            for (Container::size_type j = middle + 1; j < end; ++j)
-            {
-                sum += A[j];
-
-                if ((sum > right_sum) || init_right_sum)
-                {
-                    right_sum = sum;
-                    max_right = j;
-                }
-
-                if (init_right_sum)
-                {
-                    init_right_sum = false;
-                }
-            }
-
-            return CReturnType(max_left, max_right, left_sum + right_sum);
-        }
-        */
-    };
-}
+#pragma once
+
+#include "../simd/Dispatch.hpp"
+
+namespace Algorithms
+{
+namespace Search
+{
+    template<typename Container>
+    class MaximumSubarray
+    {
+    public:
+        struct ReturnType
+        {
+            typename Container::size_type start;
+            typename Container::size_type end;
+            typename Container::value_type sum;
+
+            ReturnType(
+                const typename Container::size_type& in_start,
+                const typename Container::size_type& in_end,
+                const typename Container::value_type& in_sum) :
+                start(in_start),
+                end(in_end),
+                sum(in_sum)
+            {
+            }
+        };
+
+        static inline ReturnType Search(
+            Container& A
+        )
+        {
+            // Convert to Container::size_type
+            return Search(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline  ReturnType Search(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            return Search(A, start - A.cbegin(), end - A.cbegin());
+        }
+
+        static ReturnType Search(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            using size_type = typename Container::size_type;
+            using value_type = typename Container::value_type;
+
+            if (start > end) { return ReturnType(start, end, 0); }
+
+            // int keys scan several chunks at once if this CPU has a kernel for it, ties come out the same as below
+            if constexpr (Simd::IsInt32Vector<Container>::value)
+            {
+                if (const auto kadane = Simd::Kernels().kadane)
+                {
+                    Simd::KadaneResult result = kadane(A.data() + start, end - start + 1);
+                    return ReturnType(start + result.start, start + result.end, (value_type)result.sum);
+                }
+            }
+
+            // Booleans to simulate init to -inf
+            bool init_max_sum = true;
+            bool init_sum = true;
+
+            // Default to zero, this will be overriden.  Just here to get rid of un-init warnings
+            value_type max_sum = 0;
+            value_type sum = 0;
+
+            // Track the current lows and highs
+            size_type current_high = start;
+            size_type current_low = start;
+
+            // The final best low and high
+            size_type low = start;
+            size_type high = start;
+
+            for (size_type j = start; j <= end; ++j)
+            {
+                current_high = j;
+
+                // Our sum is above 0
+                if ((sum > 0) || init_sum)
+                {
+                    if (init_sum)
+                    {
+                        init_sum = false;
+                        sum = A[j];
+                    }
+                    else
+                    {
+                        sum += A[j];
+                    }
+                }
+                // Sum is below zero, reset the current_low var
+                else
+                {
+                    current_low = j;
+                    sum = A[j];
+                }
+
+                // Our sum is now largest
+                if ((sum > max_sum) || init_max_sum)
+                {
+                    if (init_max_sum)
+                    {
+                        init_max_sum = false;
+                    }
+
+                    // Store point at which our sum has become the largest
+                    max_sum = sum;
+                    low = current_low;
+                    high = current_high;
+                }
+            }
+
+            return ReturnType(low, high, max_sum);
+        }
+
+        // Recursive implementation is slower and worse Complexity
+        /*
+        template<typename Container>
+        ReturnType<Container> MaximumSubArray(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            using CReturnType = ReturnType<Container>;
+
+            if (start == end)
+            {
+                return CReturnType(start, end, A[start]);
+            }
+            else
+            {
+                typename Container::size_type middle = start + ((end - start) >> 1);
+
+                CReturnType left     = MaximumSubArray(A, start, middle);
+                CReturnType right    = MaximumSubArray(A, middle + 1, end);
+                CReturnType cross    = FIND_MAX_CROSSING_SUBARRAY(A, start, middle, end);
+
+                if ((left.sum >= right.sum) && (left.sum >= cross.sum))
+                {
+                    return left;
+                }
+                else if ((right.sum >= left.sum) && (right.sum >= cross.sum))
+                {
+                    return right;
+                }
+                else
+                {
+                    return cross;
+                }
+            }
+        }
+
+        template<typename Container>
+        ReturnType<Container>FIND_MAX_CROSSING_SUBARRAY(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& middle,
+            const typename Container::size_type& end
+        )
+        {
+            using CReturnType = ReturnType<Container>;
+
+            typename Container::size_type    max_left    = 0;
+            typename Container::size_type    max_right   = 0;
+            typename Container::value_type   left_sum    = 0;
+            typename Container::value_type   right_sum   = 0;
+            typename Container::value_type   sum         = 0;
+            bool init_left_sum = true;
+            bool init_right_sum = true;
+
+            for (typename Container::size_type i = middle; i > start; --i)
+            {
+                sum += A[i];
+                if ((sum > left_sum) || init_left_sum)
+                {
+                    left_sum = sum;
+                    max_left = i;
+
+                    if (init_left_sum)
+                    {
+                        init_left_sum = false;
+                    }
+                }
+            }
+
+            sum = 0;
+            for (typename Container::size_type j = middle + 1; j < end; ++j)
+            {
+                sum += A[j];
+
+                if ((sum > right_sum) || init_right_sum)
+                {
+                    right_sum = sum;
+                    max_right = j;
+                }
+
+                if (init_right_sum)
+                {
+                    init_right_sum = false;
+                }
+            }
+
+            return CReturnType(max_left, max_right, left_sum + right_sum);
+        }
+        */
+    };
+}
 }
\ No newline at end of file
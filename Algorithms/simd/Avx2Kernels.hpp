@@ -0,0 +1,299 @@
+#pragma once
+
+#include "Kernels.hpp"
+
+#include <cstring>
+
+#ifdef ALGORITHMS_SIMD_X86
+
+namespace Algorithms
+{
+namespace Simd
+{
+namespace Avx2
+{
+    // Per 8 bit lane mask, the indices of the set lanes packed to the front one byte each.  AVX2 has no compress, so
+    // a permute by one of these stands in for it
+    struct CompressTable
+    {
+        uint64_t indices[256];
+
+        constexpr CompressTable() :
+            indices()
+        {
+            for (int mask = 0; mask < 256; ++mask)
+            {
+                uint64_t packed = 0;
+                int count = 0;
+                for (int lane = 0; lane < 8; ++lane)
+                {
+                    if (mask & (1 << lane))
+                    {
+                        packed |= (uint64_t)lane << (8 * count++);
+                    }
+                }
+                indices[mask] = packed;
+            }
+        }
+    };
+
+    inline constexpr CompressTable s_compress;
+
+    ALGORITHMS_TARGET_AVX2 inline __m256i Compress(__m256i v, unsigned int mask)
+    {
+        __m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)s_compress.indices[mask]));
+        return _mm256_permutevar8x32_epi32(v, indices);
+    }
+
+    // Everything that goes before pivot is packed down over data as it's read, the rest queues up in scratch and is
+    // copied in behind.  Each store can spill up to 8 lanes of junk past the packed front, but never past what's
+    // already been loaded
+    template<bool Descending>
+    ALGORITHMS_TARGET_AVX2 inline size_t Partition(int32_t* data, size_t n, int32_t pivot)
+    {
+        int32_t* right = PartitionScratch(n + 8);
+        const __m256i pivots = _mm256_set1_epi32(pivot);
+
+        size_t left = 0;
+        size_t count = 0;
+        size_t i = 0;
+
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i before = Descending ? _mm256_cmpgt_epi32(v, pivots) : _mm256_cmpgt_epi32(pivots, v);
+            unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(before));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + left), Compress(v, mask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + count), Compress(v, ~mask & 0xFF));
+
+            unsigned int taken = (unsigned int)_mm_popcnt_u32(mask);
+            left += taken;
+            count += 8 - taken;
+        }
+
+        for (; i < n; ++i)
+        {
+            int32_t value = data[i];
+            if (Descending ? value > pivot : value < pivot)
+            {
+                data[left++] = value;
+            }
+            else
+            {
+                right[count++] = value;
+            }
+        }
+
+        std::memcpy(data + left, right, count * sizeof(int32_t));
+        return left;
+    }
+
+    // One step of a bitonic sort across the 8 lanes
+    template<int K, int J>
+    ALGORITHMS_TARGET_AVX2 inline __m256i BitonicStep(__m256i v)
+    {
+        constexpr int keep_min = BitonicMinLanes(K, J, 8);
+
+        const __m256i partner = _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J);
+        __m256i other = _mm256_permutevar8x32_epi32(v, partner);
+
+        return _mm256_blend_epi32(_mm256_max_epi32(v, other), _mm256_min_epi32(v, other), keep_min);
+    }
+
+    // Sorts a bitonic vector
+    ALGORITHMS_TARGET_AVX2 inline __m256i BitonicMerge(__m256i v)
+    {
+        v = BitonicStep<8, 4>(v);
+        v = BitonicStep<8, 2>(v);
+        return BitonicStep<8, 1>(v);
+    }
+
+    ALGORITHMS_TARGET_AVX2 inline __m256i Sort8(__m256i v)
+    {
+        v = BitonicStep<2, 1>(v);
+        v = BitonicStep<4, 2>(v);
+        v = BitonicStep<4, 1>(v);
+        return BitonicMerge(v);
+    }
+
+    // Two sorted vectors into the 8 smallest and the 8 largest, both sorted.  a against b reversed splits them, and
+    // each half comes out bitonic
+    ALGORITHMS_TARGET_AVX2 inline void Merge16(__m256i a, __m256i b, __m256i& low, __m256i& high)
+    {
+        const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+        b = _mm256_permutevar8x32_epi32(b, reverse);
+        low = BitonicMerge(_mm256_min_epi32(a, b));
+        high = BitonicMerge(_mm256_max_epi32(a, b));
+    }
+
+    // Up to 16 keys in two registers, missing lanes padded with whatever sorts last and never written back
+    template<bool Descending>
+    ALGORITHMS_TARGET_AVX2 inline void Network(int32_t* data, size_t n)
+    {
+        const __m256i padding = _mm256_set1_epi32(Descending ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max());
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+        if (n <= 8)
+        {
+            __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n), lanes);
+            __m256i v = Sort8(_mm256_blendv_epi8(padding, _mm256_maskload_epi32(data, mask), mask));
+
+            if (Descending)
+            {
+                v = _mm256_permutevar8x32_epi32(v, reverse);
+            }
+
+            _mm256_maskstore_epi32(data, mask, v);
+            return;
+        }
+
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n - 8), lanes);
+        __m256i a = Sort8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+        __m256i b = Sort8(_mm256_blendv_epi8(padding, _mm256_maskload_epi32(data + 8, mask), mask));
+
+        __m256i low;
+        __m256i high;
+        Merge16(a, b, low, high);
+
+        if (Descending)
+        {
+            __m256i first = _mm256_permutevar8x32_epi32(high, reverse);
+            high = _mm256_permutevar8x32_epi32(low, reverse);
+            low = first;
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), low);
+        _mm256_maskstore_epi32(data + 8, mask, high);
+    }
+
+    // Keeps the 8 keys it hasn't written yet in a register and merges in one vector at a time from whichever run has
+    // the smaller next key, so the only data-dependent choice is one per 8 keys.  The low half of each merge is final
+    ALGORITHMS_TARGET_AVX2 inline void Merge(int32_t* data, size_t n_1, size_t n_2, bool descending)
+    {
+        const size_t n = n_1 + n_2;
+        const __m256i flip = _mm256_set1_epi32(descending ? -1 : 0);
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        int32_t* left = MergeScratch(n + 32);
+        const size_t end_1 = PadRun<8>(left, data, n_1, descending);
+
+        int32_t* right = left + end_1 + 8;
+        const size_t end_2 = PadRun<8>(right, data + n_1, n_2, descending);
+
+        __m256i carry = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+        size_t i = 8;
+        size_t j = 0;
+
+        for (size_t k = 0; k < n; k += 8)
+        {
+            // A finished run only gets picked once both are, and then it's the padding
+            bool take_left = j == end_2 || (i != end_1 && left[i] <= right[j]);
+            const int32_t* next = take_left ? left + i : right + j;
+            i += (take_left && i != end_1) ? 8 : 0;
+            j += (!take_left && j != end_2) ? 8 : 0;
+
+            __m256i low;
+            Merge16(carry, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next)), low, carry);
+            low = _mm256_xor_si256(low, flip);
+
+            if (n - k >= 8)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + k), low);
+            }
+            else
+            {
+                _mm256_maskstore_epi32(data + k, _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - k)), lanes), low);
+            }
+        }
+    }
+
+    // Four chunks side by side, one per 64 bit lane, each running the same scan as KadaneScan.  The chunks only meet
+    // again in KadaneCombine
+    ALGORITHMS_TARGET_AVX2 inline KadaneResult Kadane(const int32_t* data, size_t n)
+    {
+        const size_t length = n / 4;
+
+        KadaneCombine combine;
+        if (length < 16 || n > (size_t)std::numeric_limits<int32_t>::max())
+        {
+            combine.Add(KadaneScan(data, 0, n), n == 0);
+            return combine.Result();
+        }
+
+        const __m256i one = _mm256_set1_epi64x(1);
+
+        __m128i offsets = _mm_setr_epi32(0, (int)length, 2 * (int)length, 3 * (int)length);
+        __m256i index = _mm256_cvtepi32_epi64(offsets);
+
+        __m256i prefix = _mm256_setzero_si256();
+        __m256i best = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+        __m256i best_start = _mm256_setzero_si256();
+        __m256i best_end = _mm256_setzero_si256();
+        __m256i max_prefix = best;
+        __m256i max_prefix_end = _mm256_setzero_si256();
+        __m256i min_prefix = _mm256_setzero_si256();
+        __m256i min_prefix_end = _mm256_sub_epi64(index, one);
+
+        for (size_t t = 0; t < length; ++t)
+        {
+            prefix = _mm256_add_epi64(prefix, _mm256_cvtepi32_epi64(_mm_i32gather_epi32(data, offsets, 4)));
+
+            __m256i difference = _mm256_sub_epi64(prefix, min_prefix);
+            __m256i better = _mm256_cmpgt_epi64(difference, best);
+            best = _mm256_blendv_epi8(best, difference, better);
+            best_start = _mm256_blendv_epi8(best_start, _mm256_add_epi64(min_prefix_end, one), better);
+            best_end = _mm256_blendv_epi8(best_end, index, better);
+
+            __m256i higher = _mm256_cmpgt_epi64(prefix, max_prefix);
+            max_prefix = _mm256_blendv_epi8(max_prefix, prefix, higher);
+            max_prefix_end = _mm256_blendv_epi8(max_prefix_end, index, higher);
+
+            // Keeps the old minimum only where the new prefix is above it, so ties move to the later index
+            __m256i above = _mm256_cmpgt_epi64(prefix, min_prefix);
+            min_prefix = _mm256_blendv_epi8(prefix, min_prefix, above);
+            min_prefix_end = _mm256_blendv_epi8(index, min_prefix_end, above);
+
+            offsets = _mm_add_epi32(offsets, _mm_set1_epi32(1));
+            index = _mm256_add_epi64(index, one);
+        }
+
+        alignas(32) int64_t lanes[8][4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), best);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), best_start);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), best_end);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), prefix);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[4]), max_prefix);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[5]), max_prefix_end);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[6]), min_prefix);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[7]), min_prefix_end);
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            KadaneChunk chunk = {
+                lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane],
+                lanes[4][lane], lanes[5][lane], lanes[6][lane], lanes[7][lane]
+            };
+            combine.Add(chunk, false);
+        }
+
+        combine.Add(KadaneScan(data, 4 * length, n), 4 * length == n);
+        return combine.Result();
+    }
+
+    ALGORITHMS_TARGET_AVX2 inline size_t PartitionKernel(int32_t* data, size_t n, int32_t pivot, bool descending)
+    {
+        return descending ? Partition<true>(data, n, pivot) : Partition<false>(data, n, pivot);
+    }
+
+    ALGORITHMS_TARGET_AVX2 inline void NetworkKernel(int32_t* data, size_t n, bool descending)
+    {
+        descending ? Network<true>(data, n) : Network<false>(data, n);
+    }
+}
+}
+}
+
+#endif
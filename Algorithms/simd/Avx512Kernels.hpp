@@ -0,0 +1,240 @@
+#pragma once
+
+#include "Kernels.hpp"
+
+#include <cstring>
+
+#ifdef ALGORITHMS_SIMD_X86
+
+namespace Algorithms
+{
+namespace Simd
+{
+namespace Avx512
+{
+    // Every lane.  gcc 12 builds the unmasked permute, min, max and widening intrinsics on an uninitialized vector and
+    // warns about it under -Wall, the zero masked forms with every lane set are the same instructions without that
+    const __mmask16 ALL_32 = (__mmask16)0xFFFF;
+    const __mmask8 ALL_64 = (__mmask8)0xFF;
+
+    // Same scheme as the AVX2 partition, with a real compress and 16 lanes at a time
+    template<bool Descending>
+    ALGORITHMS_TARGET_AVX512 inline size_t Partition(int32_t* data, size_t n, int32_t pivot)
+    {
+        int32_t* right = PartitionScratch(n + 16);
+        const __m512i pivots = _mm512_set1_epi32(pivot);
+
+        size_t left = 0;
+        size_t count = 0;
+        size_t i = 0;
+
+        for (; i + 16 <= n; i += 16)
+        {
+            __m512i v = _mm512_loadu_si512(data + i);
+            __mmask16 before = Descending ? _mm512_cmpgt_epi32_mask(v, pivots) : _mm512_cmplt_epi32_mask(v, pivots);
+
+            // Compressing in a register then storing it whole beats a compressing store on every part that has one
+            _mm512_storeu_si512(data + left, _mm512_maskz_compress_epi32(before, v));
+            _mm512_storeu_si512(right + count, _mm512_maskz_compress_epi32((__mmask16)~before, v));
+
+            unsigned int taken = (unsigned int)_mm_popcnt_u32(before);
+            left += taken;
+            count += 16 - taken;
+        }
+
+        for (; i < n; ++i)
+        {
+            int32_t value = data[i];
+            if (Descending ? value > pivot : value < pivot)
+            {
+                data[left++] = value;
+            }
+            else
+            {
+                right[count++] = value;
+            }
+        }
+
+        std::memcpy(data + left, right, count * sizeof(int32_t));
+        return left;
+    }
+
+    template<int K, int J>
+    ALGORITHMS_TARGET_AVX512 inline __m512i BitonicStep(__m512i v)
+    {
+        constexpr __mmask16 keep_min = (__mmask16)BitonicMinLanes(K, J, 16);
+
+        const __m512i partner = _mm512_set_epi32(
+            15 ^ J, 14 ^ J, 13 ^ J, 12 ^ J, 11 ^ J, 10 ^ J, 9 ^ J, 8 ^ J,
+            7 ^ J, 6 ^ J, 5 ^ J, 4 ^ J, 3 ^ J, 2 ^ J, 1 ^ J, 0 ^ J);
+        __m512i other = _mm512_maskz_permutexvar_epi32(ALL_32, partner, v);
+
+        __m512i high = _mm512_maskz_max_epi32(ALL_32, v, other);
+        __m512i low = _mm512_maskz_min_epi32(ALL_32, v, other);
+
+        return _mm512_mask_blend_epi32(keep_min, high, low);
+    }
+
+    // Sorts a bitonic vector
+    ALGORITHMS_TARGET_AVX512 inline __m512i BitonicMerge(__m512i v)
+    {
+        v = BitonicStep<16, 8>(v);
+        v = BitonicStep<16, 4>(v);
+        v = BitonicStep<16, 2>(v);
+        return BitonicStep<16, 1>(v);
+    }
+
+    ALGORITHMS_TARGET_AVX512 inline void Merge32(__m512i a, __m512i b, __m512i& low, __m512i& high)
+    {
+        const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        b = _mm512_maskz_permutexvar_epi32(ALL_32, reverse, b);
+        low = BitonicMerge(_mm512_maskz_min_epi32(ALL_32, a, b));
+        high = BitonicMerge(_mm512_maskz_max_epi32(ALL_32, a, b));
+    }
+
+    // All 16 keys fit in one register, missing lanes padded with whatever sorts last and never written back
+    template<bool Descending>
+    ALGORITHMS_TARGET_AVX512 inline void Network(int32_t* data, size_t n)
+    {
+        const __mmask16 mask = (__mmask16)((1u << n) - 1);
+        const __m512i padding = _mm512_set1_epi32(Descending ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max());
+
+        __m512i v = _mm512_mask_loadu_epi32(padding, mask, data);
+
+        v = BitonicStep<2, 1>(v);
+        v = BitonicStep<4, 2>(v);
+        v = BitonicStep<4, 1>(v);
+        v = BitonicStep<8, 4>(v);
+        v = BitonicStep<8, 2>(v);
+        v = BitonicStep<8, 1>(v);
+        v = BitonicMerge(v);
+
+        if (Descending)
+        {
+            const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            v = _mm512_maskz_permutexvar_epi32(ALL_32, reverse, v);
+        }
+
+        _mm512_mask_storeu_epi32(data, mask, v);
+    }
+
+    // Same scheme as the AVX2 merge, 16 keys at a time
+    ALGORITHMS_TARGET_AVX512 inline void Merge(int32_t* data, size_t n_1, size_t n_2, bool descending)
+    {
+        const size_t n = n_1 + n_2;
+        const __m512i flip = _mm512_set1_epi32(descending ? -1 : 0);
+
+        int32_t* left = MergeScratch(n + 64);
+        const size_t end_1 = PadRun<16>(left, data, n_1, descending);
+
+        int32_t* right = left + end_1 + 16;
+        const size_t end_2 = PadRun<16>(right, data + n_1, n_2, descending);
+
+        __m512i carry = _mm512_loadu_si512(left);
+        size_t i = 16;
+        size_t j = 0;
+
+        for (size_t k = 0; k < n; k += 16)
+        {
+            bool take_left = j == end_2 || (i != end_1 && left[i] <= right[j]);
+            const int32_t* next = take_left ? left + i : right + j;
+            i += (take_left && i != end_1) ? 16 : 0;
+            j += (!take_left && j != end_2) ? 16 : 0;
+
+            __m512i low;
+            Merge32(carry, _mm512_loadu_si512(next), low, carry);
+            low = _mm512_xor_si512(low, flip);
+
+            const __mmask16 mask = n - k >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - k)) - 1);
+            _mm512_mask_storeu_epi32(data + k, mask, low);
+        }
+    }
+
+    // Eight chunks side by side, see the AVX2 version
+    ALGORITHMS_TARGET_AVX512 inline KadaneResult Kadane(const int32_t* data, size_t n)
+    {
+        const size_t length = n / 8;
+
+        KadaneCombine combine;
+        if (length < 16 || n > (size_t)std::numeric_limits<int32_t>::max())
+        {
+            combine.Add(KadaneScan(data, 0, n), n == 0);
+            return combine.Result();
+        }
+
+        const __m512i one = _mm512_set1_epi64(1);
+        const int l = (int)length;
+
+        __m256i offsets = _mm256_setr_epi32(0, l, 2 * l, 3 * l, 4 * l, 5 * l, 6 * l, 7 * l);
+        __m512i index = _mm512_maskz_cvtepi32_epi64(ALL_64, offsets);
+
+        __m512i prefix = _mm512_setzero_si512();
+        __m512i best = _mm512_set1_epi64(std::numeric_limits<int64_t>::min());
+        __m512i best_start = _mm512_setzero_si512();
+        __m512i best_end = _mm512_setzero_si512();
+        __m512i max_prefix = best;
+        __m512i max_prefix_end = _mm512_setzero_si512();
+        __m512i min_prefix = _mm512_setzero_si512();
+        __m512i min_prefix_end = _mm512_sub_epi64(index, one);
+
+        for (size_t t = 0; t < length; ++t)
+        {
+            __m256i next = _mm256_i32gather_epi32(data, offsets, 4);
+            prefix = _mm512_add_epi64(prefix, _mm512_maskz_cvtepi32_epi64(ALL_64, next));
+
+            __m512i difference = _mm512_sub_epi64(prefix, min_prefix);
+            __mmask8 better = _mm512_cmpgt_epi64_mask(difference, best);
+            best = _mm512_mask_mov_epi64(best, better, difference);
+            best_start = _mm512_mask_mov_epi64(best_start, better, _mm512_add_epi64(min_prefix_end, one));
+            best_end = _mm512_mask_mov_epi64(best_end, better, index);
+
+            __mmask8 higher = _mm512_cmpgt_epi64_mask(prefix, max_prefix);
+            max_prefix = _mm512_mask_mov_epi64(max_prefix, higher, prefix);
+            max_prefix_end = _mm512_mask_mov_epi64(max_prefix_end, higher, index);
+
+            __mmask8 lower = _mm512_cmple_epi64_mask(prefix, min_prefix);
+            min_prefix = _mm512_mask_mov_epi64(min_prefix, lower, prefix);
+            min_prefix_end = _mm512_mask_mov_epi64(min_prefix_end, lower, index);
+
+            offsets = _mm256_add_epi32(offsets, _mm256_set1_epi32(1));
+            index = _mm512_add_epi64(index, one);
+        }
+
+        alignas(64) int64_t lanes[8][8];
+        _mm512_store_si512(lanes[0], best);
+        _mm512_store_si512(lanes[1], best_start);
+        _mm512_store_si512(lanes[2], best_end);
+        _mm512_store_si512(lanes[3], prefix);
+        _mm512_store_si512(lanes[4], max_prefix);
+        _mm512_store_si512(lanes[5], max_prefix_end);
+        _mm512_store_si512(lanes[6], min_prefix);
+        _mm512_store_si512(lanes[7], min_prefix_end);
+
+        for (int lane = 0; lane < 8; ++lane)
+        {
+            KadaneChunk chunk = {
+                lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane],
+                lanes[4][lane], lanes[5][lane], lanes[6][lane], lanes[7][lane]
+            };
+            combine.Add(chunk, false);
+        }
+
+        combine.Add(KadaneScan(data, 8 * length, n), 8 * length == n);
+        return combine.Result();
+    }
+
+    ALGORITHMS_TARGET_AVX512 inline size_t PartitionKernel(int32_t* data, size_t n, int32_t pivot, bool descending)
+    {
+        return descending ? Partition<true>(data, n, pivot) : Partition<false>(data, n, pivot);
+    }
+
+    ALGORITHMS_TARGET_AVX512 inline void NetworkKernel(int32_t* data, size_t n, bool descending)
+    {
+        descending ? Network<true>(data, n) : Network<false>(data, n);
+    }
+}
+}
+}
+
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ALGORITHMS_SIMD_X86 1
+#endif
+
+#if defined(ALGORITHMS_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Algorithms
+{
+namespace Simd
+{
+    // Instruction sets there are kernels for, each one implies the ones before it
+    enum class Isa
+    {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    inline const char* IsaName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::AVX2:     return "avx2";
+        case Isa::AVX512:   return "avx512";
+        default:            return "scalar";
+        }
+    }
+
+    // Scalar for anything it doesn't know
+    inline Isa ParseIsa(const char* name)
+    {
+        if (name && std::strcmp(name, "avx512") == 0)  { return Isa::AVX512; }
+        if (name && std::strcmp(name, "avx2") == 0)    { return Isa::AVX2; }
+
+        return Isa::Scalar;
+    }
+
+    // Best instruction set this CPU and OS can run.  AVX2 kernels want AVX2 and POPCNT, AVX-512 ones AVX-512F on top,
+    // and either needs the OS to save the wider registers
+    inline Isa DetectIsa()
+    {
+#if defined(ALGORITHMS_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) { return Isa::Scalar; }
+
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool popcnt = (info[2] & (1 << 23)) != 0;
+        if (!osxsave) { return Isa::Scalar; }
+
+        unsigned long long xcr0 = _xgetbv(0);
+        bool ymm = (xcr0 & 0x6) == 0x6;
+        bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        bool avx512f = (info[1] & (1 << 16)) != 0;
+
+        if (zmm && avx512f && avx2 && popcnt)   { return Isa::AVX512; }
+        if (ymm && avx2 && popcnt)              { return Isa::AVX2; }
+
+        return Isa::Scalar;
+#elif defined(ALGORITHMS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+        // libgcc checks the OS side through xgetbv too
+        __builtin_cpu_init();
+        bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+
+        if (avx2 && __builtin_cpu_supports("avx512f"))  { return Isa::AVX512; }
+        if (avx2)                                       { return Isa::AVX2; }
+
+        return Isa::Scalar;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    // ALGORITHMS_ISA=scalar|avx2|avx512 in the environment can lower what was detected, never raise it
+    inline Isa EnvironmentIsa(Isa detected)
+    {
+        const char* forced = std::getenv("ALGORITHMS_ISA");
+        if (!forced) { return detected; }
+
+        Isa isa = ParseIsa(forced);
+        return isa < detected ? isa : detected;
+    }
+}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CpuFeatures.hpp"
+#include "Kernels.hpp"
+#include "Avx2Kernels.hpp"
+#include "Avx512Kernels.hpp"
+
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace Algorithms
+{
+namespace Simd
+{
+    // One set of kernels per instruction set.  Missing entries mean the sorts and searches keep their own templated
+    // code, which is also the scalar path, so the Scalar table is empty
+    struct KernelTable
+    {
+        Isa isa;
+
+        // Packs every element of data[0, n) that goes before pivot to the front and returns how many there are.
+        // Increasing puts the smaller ones first, descending the larger ones
+        size_t (*partition)(int32_t* data, size_t n, int32_t pivot, bool descending);
+
+        // Sorts data[0, n) for n up to network_max
+        void (*network)(int32_t* data, size_t n, bool descending);
+        size_t network_max;
+
+        // Merges the sorted runs data[0, n_1) and data[n_1, n_1 + n_2) in place, both non-empty.  Only worth it from
+        // merge_min keys
+        void (*merge)(int32_t* data, size_t n_1, size_t n_2, bool descending);
+        size_t merge_min;
+
+        // Maximum subarray of data[0, n), n > 0
+        KadaneResult (*kadane)(const int32_t* data, size_t n);
+    };
+
+    inline const KernelTable& TableFor(Isa isa)
+    {
+#ifdef ALGORITHMS_SIMD_X86
+        static const KernelTable avx512 = { Isa::AVX512, Avx512::PartitionKernel, Avx512::NetworkKernel, 16, Avx512::Merge, 64, Avx512::Kadane };
+        static const KernelTable avx2 = { Isa::AVX2, Avx2::PartitionKernel, Avx2::NetworkKernel, 16, Avx2::Merge, 32, Avx2::Kadane };
+#endif
+        static const KernelTable scalar = { Isa::Scalar, nullptr, nullptr, 0, nullptr, 0, nullptr };
+
+        switch (isa)
+        {
+#ifdef ALGORITHMS_SIMD_X86
+        case Isa::AVX512:   return avx512;
+        case Isa::AVX2:     return avx2;
+#endif
+        default:            return scalar;
+        }
+    }
+
+    namespace Detail
+    {
+        // Picked the first time anything asks, ALGORITHMS_ISA can only lower it
+        inline std::atomic<const KernelTable*>& Active()
+        {
+            static std::atomic<const KernelTable*> active(&TableFor(EnvironmentIsa(DetectIsa())));
+            return active;
+        }
+
+        // Resolves at static initialization, so nothing timed pays for the cpuid
+        inline const bool s_resolved = Active().load() != nullptr;
+    }
+
+    inline const KernelTable& Kernels()
+    {
+        return *Detail::Active().load(std::memory_order_relaxed);
+    }
+
+    inline Isa ActiveIsa()
+    {
+        return Kernels().isa;
+    }
+
+    // For tests and benchmarks, clamped to what the CPU can run.  Returns what it ended up with.  Not meant to be
+    // called while another thread is sorting
+    inline Isa ForceIsa(Isa isa)
+    {
+        Isa detected = DetectIsa();
+        if (isa > detected)
+        {
+            isa = detected;
+        }
+
+        Detail::Active().store(&TableFor(isa), std::memory_order_relaxed);
+        return isa;
+    }
+
+    // The kernels only take contiguous int keys under one of the two plain orderings
+    template<typename Container>
+    struct IsInt32Vector : std::false_type {};
+
+    template<typename Allocator>
+    struct IsInt32Vector<std::vector<int32_t, Allocator>> : std::true_type {};
+
+    template<typename Container, template<typename> typename Compare>
+    constexpr bool Dispatchable =
+        IsInt32Vector<Container>::value &&
+        (std::is_same<Compare<int32_t>, std::greater<int32_t>>::value || std::is_same<Compare<int32_t>, std::less<int32_t>>::value);
+
+    // std::greater is increasing in this library, see Sorter.hpp
+    template<template<typename> typename Compare>
+    constexpr bool Descending = std::is_same<Compare<int32_t>, std::less<int32_t>>::value;
+}
+}
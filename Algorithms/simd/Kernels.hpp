@@ -0,0 +1,204 @@
+#pragma once
+
+#include "CpuFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#ifdef ALGORITHMS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// gcc and clang compile each kernel for its own target without the whole build needing -mavx2, MSVC takes the
+// intrinsics anywhere
+#if defined(ALGORITHMS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ALGORITHMS_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define ALGORITHMS_TARGET_AVX512 __attribute__((target("avx512f,avx2,popcnt")))
+#else
+#define ALGORITHMS_TARGET_AVX2
+#define ALGORITHMS_TARGET_AVX512
+#endif
+
+namespace Algorithms
+{
+namespace Simd
+{
+    // Maximum subarray of a whole range, start and end inclusive.  Sums are 64 bit so int keys can't overflow
+    struct KadaneResult
+    {
+        size_t start;
+        size_t end;
+        int64_t sum;
+    };
+
+    // What the combine step needs to know about one contiguous chunk of a Kadane scan.  Prefixes are relative to the
+    // chunk's start, indices are global, and the empty prefix just before the chunk counts as a minimum of 0
+    struct KadaneChunk
+    {
+        // Best subarray inside the chunk, the earliest end on ties
+        int64_t best;
+        int64_t best_start;
+        int64_t best_end;
+
+        // Sum of the whole chunk
+        int64_t total;
+
+        // Largest non-empty prefix, the earliest on ties
+        int64_t max_prefix;
+        int64_t max_prefix_end;
+
+        // Smallest prefix including the empty one, the latest on ties.  Its index is the last element it covers
+        int64_t min_prefix;
+        int64_t min_prefix_end;
+    };
+
+    // Reference scan every kernel has to agree with, also handles what doesn't fill a whole vector
+    inline KadaneChunk KadaneScan(const int32_t* data, size_t begin, size_t end)
+    {
+        KadaneChunk chunk;
+        chunk.best = std::numeric_limits<int64_t>::min();
+        chunk.best_start = 0;
+        chunk.best_end = 0;
+        chunk.total = 0;
+        chunk.max_prefix = std::numeric_limits<int64_t>::min();
+        chunk.max_prefix_end = 0;
+        chunk.min_prefix = 0;
+        chunk.min_prefix_end = (int64_t)begin - 1;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            chunk.total += data[i];
+
+            int64_t difference = chunk.total - chunk.min_prefix;
+            if (difference > chunk.best)
+            {
+                chunk.best = difference;
+                chunk.best_start = chunk.min_prefix_end + 1;
+                chunk.best_end = (int64_t)i;
+            }
+
+            if (chunk.total > chunk.max_prefix)
+            {
+                chunk.max_prefix = chunk.total;
+                chunk.max_prefix_end = (int64_t)i;
+            }
+
+            if (chunk.total <= chunk.min_prefix)
+            {
+                chunk.min_prefix = chunk.total;
+                chunk.min_prefix_end = (int64_t)i;
+            }
+        }
+
+        return chunk;
+    }
+
+    // Folds chunks left to right into the answer for all of them, ties go the same way a plain Kadane loop breaks them
+    class KadaneCombine
+    {
+    public:
+        void Add(const KadaneChunk& chunk, bool empty)
+        {
+            if (empty) { return; }
+
+            // Best that ends in this chunk but starts before it
+            int64_t previous_min = m_min_prefix - m_offset;
+            int64_t crossing = chunk.max_prefix - previous_min;
+
+            bool inside = chunk.best > crossing || (chunk.best == crossing && chunk.best_end <= chunk.max_prefix_end);
+
+            int64_t best = inside ? chunk.best : crossing;
+            if (best > m_result.sum)
+            {
+                m_result.sum = best;
+                m_result.start = (size_t)(inside ? chunk.best_start : m_min_prefix_end + 1);
+                m_result.end = (size_t)(inside ? chunk.best_end : chunk.max_prefix_end);
+            }
+
+            if (chunk.min_prefix + m_offset <= m_min_prefix)
+            {
+                m_min_prefix = chunk.min_prefix + m_offset;
+                m_min_prefix_end = chunk.min_prefix_end;
+            }
+
+            m_offset += chunk.total;
+        }
+
+        KadaneResult Result() const
+        {
+            return m_result;
+        }
+
+    private:
+        KadaneResult m_result = { 0, 0, std::numeric_limits<int64_t>::min() };
+
+        int64_t m_offset = 0;
+        int64_t m_min_prefix = 0;
+        int64_t m_min_prefix_end = -1;
+    };
+
+    // Lanes of one bitonic sorting step that keep the smaller of their pair.  Lane i is paired with i ^ j, and blocks
+    // of k lanes alternate between ascending and descending
+    constexpr int BitonicMinLanes(int k, int j, int lanes)
+    {
+        int mask = 0;
+        for (int i = 0; i < lanes; ++i)
+        {
+            if (((i & j) == 0) == ((i & k) == 0))
+            {
+                mask |= 1 << i;
+            }
+        }
+
+        return mask;
+    }
+
+    // Where partition kernels park the elements that go right, one per thread so sorts on different threads don't
+    // share it
+    inline int32_t* PartitionScratch(size_t n)
+    {
+        thread_local std::vector<int32_t> scratch;
+        if (scratch.size() < n)
+        {
+            scratch.resize(n);
+        }
+
+        return scratch.data();
+    }
+
+    // Where merge kernels copy both runs to, padded out to whole vectors
+    inline int32_t* MergeScratch(size_t n)
+    {
+        thread_local std::vector<int32_t> scratch;
+        if (scratch.size() < n)
+        {
+            scratch.resize(n);
+        }
+
+        return scratch.data();
+    }
+
+    // Copies a run into merge scratch with Width keys of padding that sort last behind it, so loading the next whole
+    // vector never runs off the end.  Descending flips every bit on the way in, which reverses the order of any two
+    // ints, so the kernels only ever merge ascending.  Returns where the padding starts
+    template<size_t Width>
+    inline size_t PadRun(int32_t* to, const int32_t* from, size_t n, bool descending)
+    {
+        const uint32_t flip = descending ? ~0u : 0u;
+        const size_t end = (n + Width - 1) / Width * Width;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            to[i] = (int32_t)((uint32_t)from[i] ^ flip);
+        }
+        for (size_t i = n; i < end + Width; ++i)
+        {
+            to[i] = std::numeric_limits<int32_t>::max();
+        }
+
+        return end;
+    }
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Sorter.hpp"
+
+namespace Algorithms
+{
+namespace Sort
+{
+    // Insertion sort that binary searches for the slot instead of comparing its way down to it.  log(i) comparisons
+    // per element instead of up to i, the moves stay the same, so it wins when comparisons cost more than moves
+    template<typename Container, template<typename> typename Compare>
+    class BinaryInsertionSort
+    {
+        static Compare<typename Container::value_type> s_compare;
+
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, start - A.cbegin(), end - A.cbegin());
+        }
+
+        static void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            for (typename Container::size_type i = start + 1; i <= end; ++i)
+            {
+                // Already in place, the common case on nearly sorted input
+                if (!s_compare(A[i - 1], A[i])) { continue; }
+
+                typename Container::value_type key = std::move(A[i]);
+
+                // First slot in [start, i) that has to move past key.  Equal keys stay in front, so it's stable
+                typename Container::size_type low = start;
+                typename Container::size_type high = i - 1;
+                while (low < high)
+                {
+                    typename Container::size_type middle = low + ((high - low) >> 1);
+                    if (s_compare(A[middle], key))
+                    {
+                        high = middle;
+                    }
+                    else
+                    {
+                        low = middle + 1;
+                    }
+                }
+
+                std::move_backward(A.begin() + low, A.begin() + i, A.begin() + i + 1);
+                A[low] = std::move(key);
+            }
+        }
+    };
+
+    template<typename Container, template<typename> typename Compare>
+    Compare<typename Container::value_type> BinaryInsertionSort<Container, Compare>::s_compare;
+
+    template<typename Container>
+    using IncreasingBinaryInsertionSort = BinaryInsertionSort<Container, increasing>;
+
+    template<typename Container>
+    using DecreasingBinaryInsertionSort = BinaryInsertionSort<Container, decreasing>;
+}
+}
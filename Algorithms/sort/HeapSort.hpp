@@ -1,54 +1,75 @@
-#pragma once
-
-#include "Sorter.hpp"
-
-namespace Algorithms
-{
-namespace Sort
-{
-    template<typename Container, template<typename, template<typename> typename> typename Heap, template<typename> typename Compare>
-    class HeapSort
-    {
-    public:
-        using compare = Compare<typename Container::value_type>;
-
-        static inline void Sort(
-            Container& A
-        )
-        {
-            Sort(A, A.cbegin(), A.cend() - 1);
-        }
-
-        static inline void Sort(
-            Container& A,
-            const typename Container::const_iterator& start,
-            const typename Container::const_iterator& end
-        )
-        {
-            Sort(A, start - A.cbegin(), end - A.cbegin());
-        }
-
-        static inline void Sort(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end
-        )
-        {
-            Heap<Container::value_type, Compare> sorter(Container(A.cbegin() + start, A.cbegin() + end + 1));
-
-            Container::size_type i = start;
-            while (!sorter.Empty())
-            {
-                A[i] = sorter.ExtractTop();
-                ++i;
-            }
-        }
-    };
-
-    template<typename Container, template<typename, template<typename> typename> typename Heap>
-    using IncreasingHeapSort = HeapSort<Container, Heap, increasing>;
-
-    template<typename Container, template<typename, template<typename> typename> typename Heap>
-    using DecreasingHeapSort = HeapSort<Container, Heap, decreasing>;
-}
-}
+#pragma once
+
+#include "Sorter.hpp"
+
+#include <type_traits>
+
+namespace Algorithms
+{
+namespace Sort
+{
+    template<typename Container, template<typename, template<typename> typename> typename Heap, template<typename> typename Compare>
+    class HeapSort
+    {
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        /***************************************************************************************************************
+        * Value heaps hand back the value itself, node heaps hand back a node holding it
+        *
+        ***************************************************************************************************************/
+        template<typename Top>
+        static inline typename Container::value_type Value(const Top& top)
+        {
+            if constexpr (std::is_same<Top, typename Container::value_type>::value)
+            {
+                return top;
+            }
+            else
+            {
+                return top->Key();
+            }
+        }
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            Sort(A, start - A.cbegin(), end - A.cbegin());
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            // Node heaps build in bulk, and their nodes go away with the heap
+            Heap<typename Container::value_type, Compare> sorter(A.cbegin() + start, A.cbegin() + end + 1);
+
+            // The top is whatever Compare puts last, so fill from the back
+            typename Container::size_type i = end + 1;
+            while (!sorter.Empty())
+            {
+                --i;
+                A[i] = Value(sorter.ExtractTop());
+            }
+        }
+    };
+
+    template<typename Container, template<typename, template<typename> typename> typename Heap>
+    using IncreasingHeapSort = HeapSort<Container, Heap, increasing>;
+
+    template<typename Container, template<typename, template<typename> typename> typename Heap>
+    using DecreasingHeapSort = HeapSort<Container, Heap, decreasing>;
+}
+}
@@ -1,33 +1,108 @@
-#pragma once
-
-#include "Sorter.hpp"
-
-namespace Algorithms
-{
-namespace Sort
-{
-    template<typename Container, template<typename> typename Compare>
-    class IntroSort
-    {
-    public:
-        static inline void Sort(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end
-        )
-        {
-            // Convert to Container::size_type
-            Sort(A, (int)start, (int)end);
-        }
-
-    private:
-
-    };
-
-    template<typename Container>
-    using IncreasingIntroSort = IntroSort<Container, increasing>;
-
-    template<typename Container>
-    using DecreasingIntroSort = IntroSort<Container, decreasing>;
-}
-}
\ No newline at end of file
+#pragma once
+
+#include "Sorter.hpp"
+#include "QuickSort.hpp"
+#include "HeapSort.hpp"
+#include "SortTuning.hpp"
+#include "BinaryHeap.hpp"
+
+namespace Algorithms
+{
+namespace Sort
+{
+    // Quicksort that gives up on a range once it has partitioned it 2*log2(n) deep and heap sorts it instead, so bad
+    // pivots can't make it quadratic.  Short ranges go to the small sorter at the cutoff tuned for SmartQuickSort, see
+    // SortTuning.hpp
+    template<typename Container, template<typename> typename Compare>
+    class IntroSort
+    {
+        using QUICK_SORT = QuickSort<Container, Compare>;
+        using HEAP_SORT = HeapSort<Container, Datastructures::Heaps::BinaryHeap, Compare>;
+        using SMALL_SORTER = Tuning::SmartQuickSmallSorter<Container, Compare>;
+
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            if (A.empty()) { return; }
+
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, (typename Container::size_type)(start - A.cbegin()), (typename Container::size_type)(end - A.cbegin()));
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            if (start >= end) { return; }
+
+            int depth = 0;
+            for (typename Container::size_type n = end - start + 1; n > 1; n >>= 1)
+            {
+                depth += 2;
+            }
+
+            Sort(A, (int)start, (int)end, depth);
+        }
+
+    private:
+
+        static void Sort(
+            Container& A,
+            int start,
+            int end,
+            int depth
+        )
+        {
+            while (end - start >= (int)Tuning::SMART_QUICK_THRESHOLD)
+            {
+                if (depth == 0)
+                {
+                    HEAP_SORT::Sort(A, (typename Container::size_type)start, (typename Container::size_type)end);
+                    return;
+                }
+                --depth;
+
+                int pivot = (int)QUICK_SORT::RANDOMIZED_PARTITION(A, start, end);
+
+                // Recurse into the smaller side, loop on the larger
+                if (pivot - start < end - pivot)
+                {
+                    Sort(A, start, pivot - 1, depth);
+                    start = pivot + 1;
+                }
+                else
+                {
+                    Sort(A, pivot + 1, end, depth);
+                    end = pivot - 1;
+                }
+            }
+
+            if (start < end)
+            {
+                SMALL_SORTER::Sort(A, (typename Container::size_type)start, (typename Container::size_type)end);
+            }
+        }
+    };
+
+    template<typename Container>
+    using IncreasingIntroSort = IntroSort<Container, increasing>;
+
+    template<typename Container>
+    using DecreasingIntroSort = IntroSort<Container, decreasing>;
+}
+}
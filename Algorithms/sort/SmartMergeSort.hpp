@@ -1,85 +1,97 @@
-#pragma once
-
-#include "MergeSort.hpp"
-#include "Sorter.hpp"
-
-namespace Algorithms
-{
-namespace Sort
-{
-    template<typename Container, typename SmallSorter, template<typename> typename Compare>
-    class SmartMergeSort
-    {
-        using MERGE_SORT = MergeSort<Container, Compare>;
-
-    public:
-        using compare = Compare<typename Container::value_type>;
-
-        static inline void Sort(
-            Container& A
-        )
-        {
-            // Convert to Container::size_type
-            Sort(A, A.cbegin(), A.cend() - 1);
-        }
-
-        static inline void Sort(
-            Container& A,
-            const typename Container::const_iterator& start,
-            const typename Container::const_iterator& end
-        )
-        {
-            // Convert to Container::size_type
-            Sort(A, start - A.cbegin(), end - A.cbegin());
-        }
-
-        static void Sort(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end
-        )
-        {
-            // Pre allocate playground space
-            // Maximum size needed for L and R is both (end - start)/2 + 1
-            Container::size_type to_reserve = ((end - start) >> 1) + 1;
-            Container L;
-            Container R;
-
-            L.resize(to_reserve);
-            R.resize(to_reserve);
-
-            Sort(A, start, end, L, R);
-        }
-
-        static void Sort(
-            Container& A,
-            const typename Container::size_type& start,
-            const typename Container::size_type& end,
-            Container& L,
-            Container& R
-        )
-        {
-            if (start >= end) { return; }
-
-            if (end - start <= 40)
-            {
-                SmallSorter::Sort(A, start, end);
-            }
-            else
-            {
-                size_t middle = start + ((end - start) >> 1);
-
-                Sort(A, start, middle, L, R);
-                Sort(A, middle + 1, end, L, R);
-                MERGE_SORT::MERGE(A, start, middle, end, L, R);
-            }
-        }
-    };
-
-    template<typename Container, typename SmallSorter>
-    using IncreasingSmartMergeSort = SmartMergeSort<Container, SmallSorter, increasing>;
-
-    template<typename Container, typename SmallSorter>
-    using DecreasingSmartMergeSort = SmartMergeSort<Container, SmallSorter, decreasing>;
-}
+#pragma once
+
+#include "MergeSort.hpp"
+#include "Sorter.hpp"
+#include "SortTuning.hpp"
+
+namespace Algorithms
+{
+namespace Sort
+{
+    // Merge sort that hands ranges of at most Threshold elements to SmallSorter.  The best cutoff depends on the
+    // element type, the comparison and the machine, Bench --tune-sorts measures it
+    template<
+        typename Container,
+        typename SmallSorter,
+        template<typename> typename Compare,
+        size_t Threshold = Tuning::SMART_MERGE_THRESHOLD
+    >
+    class SmartMergeSort
+    {
+        using MERGE_SORT = MergeSort<Container, Compare>;
+
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, start - A.cbegin(), end - A.cbegin());
+        }
+
+        static void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            // Pre allocate playground space
+            // The left run is never more than (end - start)/2 + 1
+            typename Container::size_type to_reserve = ((end - start) >> 1) + 1;
+            Container L;
+
+            L.resize(to_reserve);
+
+            Sort(A, start, end, L);
+        }
+
+        static void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end,
+            Container& L
+        )
+        {
+            if (start >= end) { return; }
+
+            if (end - start < Threshold)
+            {
+                SmallSorter::Sort(A, start, end);
+            }
+            else
+            {
+                size_t middle = start + ((end - start) >> 1);
+
+                Sort(A, start, middle, L);
+                Sort(A, middle + 1, end, L);
+                MERGE_SORT::MERGE(A, start, middle, end, L);
+            }
+        }
+    };
+
+    template<typename Container, typename SmallSorter, size_t Threshold = Tuning::SMART_MERGE_THRESHOLD>
+    using IncreasingSmartMergeSort = SmartMergeSort<Container, SmallSorter, increasing, Threshold>;
+
+    template<typename Container, typename SmallSorter, size_t Threshold = Tuning::SMART_MERGE_THRESHOLD>
+    using DecreasingSmartMergeSort = SmartMergeSort<Container, SmallSorter, decreasing, Threshold>;
+
+    // Small sorter and cutoff both from SortTuning.hpp
+    template<typename Container>
+    using IncreasingTunedSmartMergeSort = IncreasingSmartMergeSort<Container, Tuning::SmartMergeSmallSorter<Container, increasing>>;
+
+    template<typename Container>
+    using DecreasingTunedSmartMergeSort = DecreasingSmartMergeSort<Container, Tuning::SmartMergeSmallSorter<Container, decreasing>>;
+}
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "QuickSort.hpp"
+#include "Sorter.hpp"
+#include "SortTuning.hpp"
+
+namespace Algorithms
+{
+namespace Sort
+{
+    // Randomized quicksort that stops partitioning at Threshold elements and hands the range to SmallSorter.  Only
+    // the smaller side of a partition is recursed into, so the stack stays O(log n) however the pivots fall
+    template<
+        typename Container,
+        typename SmallSorter,
+        template<typename> typename Compare,
+        size_t Threshold = Tuning::SMART_QUICK_THRESHOLD
+    >
+    class SmartQuickSort
+    {
+        using QUICK_SORT = QuickSort<Container, Compare>;
+
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, (int)(start - A.cbegin()), (int)(end - A.cbegin()));
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, (int)start, (int)end);
+        }
+
+        static void Sort(
+            Container& A,
+            int start,
+            int end
+        )
+        {
+            while (start < end && end - start >= (int)Threshold)
+            {
+                int pivot = (int)QUICK_SORT::RANDOMIZED_PARTITION(A, start, end);
+
+                if (pivot - start < end - pivot)
+                {
+                    Sort(A, start, pivot - 1);
+                    start = pivot + 1;
+                }
+                else
+                {
+                    Sort(A, pivot + 1, end);
+                    end = pivot - 1;
+                }
+            }
+
+            // Be sure to catch underflow
+            if (start < end)
+            {
+                SmallSorter::Sort(A, (typename Container::size_type)start, (typename Container::size_type)end);
+            }
+        }
+    };
+
+    template<typename Container, typename SmallSorter, size_t Threshold = Tuning::SMART_QUICK_THRESHOLD>
+    using IncreasingSmartQuickSort = SmartQuickSort<Container, SmallSorter, increasing, Threshold>;
+
+    template<typename Container, typename SmallSorter, size_t Threshold = Tuning::SMART_QUICK_THRESHOLD>
+    using DecreasingSmartQuickSort = SmartQuickSort<Container, SmallSorter, decreasing, Threshold>;
+
+    // Small sorter and cutoff both from SortTuning.hpp
+    template<typename Container>
+    using IncreasingTunedSmartQuickSort = IncreasingSmartQuickSort<Container, Tuning::SmartQuickSmallSorter<Container, increasing>>;
+
+    template<typename Container>
+    using DecreasingTunedSmartQuickSort = DecreasingSmartQuickSort<Container, Tuning::SmartQuickSmallSorter<Container, decreasing>>;
+}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Cutoffs and small sorters for the hybrid sorts.  These are the defaults, run Bench --tune-sorts on the target
+// machine and replace this file with what it writes
+
+#include "InsertionSort.hpp"
+#include "BinaryInsertionSort.hpp"
+#include "SortingNetwork.hpp"
+
+#include <cstddef>
+
+namespace Algorithms
+{
+namespace Sort
+{
+namespace Tuning
+{
+    // SmartMergeSort hands ranges of at most this many elements to the small sorter
+    const size_t SMART_MERGE_THRESHOLD = 40;
+
+    template<typename Container, template<typename> typename Compare>
+    using SmartMergeSmallSorter = InsertionSort<Container, Compare>;
+
+    // SmartQuickSort and IntroSort stop partitioning at this many elements
+    const size_t SMART_QUICK_THRESHOLD = 16;
+
+    template<typename Container, template<typename> typename Compare>
+    using SmartQuickSmallSorter = InsertionSort<Container, Compare>;
+}
+}
+}
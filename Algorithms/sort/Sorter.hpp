@@ -1,15 +1,25 @@
-#pragma once
-
-#include <algorithm>
-
-namespace Algorithms
-{
-namespace Sort
-{
-    template<typename T>
-    using increasing = std::greater<T>;
-
-    template<typename T>
-    using decreasing = std::less<T>;
-}
+#pragma once
+
+#include "OperationCounts.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace Algorithms
+{
+namespace Sort
+{
+    template<typename T>
+    using increasing = std::greater<T>;
+
+    template<typename T>
+    using decreasing = std::less<T>;
+
+    // Same orderings, counting every comparison into Operations()
+    template<typename T>
+    using counting_increasing = Datastructures::Heaps::CountingCompare<T, increasing>;
+
+    template<typename T>
+    using counting_decreasing = Datastructures::Heaps::CountingCompare<T, decreasing>;
+}
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Sorter.hpp"
+#include "../simd/Dispatch.hpp"
+
+namespace Algorithms
+{
+namespace Sort
+{
+    // Batcher's odd-even merge sort as a sorting network.  Which pairs get compared only depends on the length, never
+    // on the keys, and every compare-exchange is written so it compiles to conditional moves, so there are no
+    // mispredicted branches at all.  O(n log^2 n) comparisons, meant for the short runs a hybrid sort hands off
+    template<typename Container, template<typename> typename Compare>
+    class SortingNetwork
+    {
+        static Compare<typename Container::value_type> s_compare;
+
+    public:
+        using compare = Compare<typename Container::value_type>;
+
+        static inline void Sort(
+            Container& A
+        )
+        {
+            Sort(A, A.cbegin(), A.cend() - 1);
+        }
+
+        static inline void Sort(
+            Container& A,
+            const typename Container::const_iterator& start,
+            const typename Container::const_iterator& end
+        )
+        {
+            // Convert to Container::size_type
+            Sort(A, start - A.cbegin(), end - A.cbegin());
+        }
+
+        static void Sort(
+            Container& A,
+            const typename Container::size_type& start,
+            const typename Container::size_type& end
+        )
+        {
+            using size_type = typename Container::size_type;
+
+            if (start >= end) { return; }
+
+            const size_type n = end - start + 1;
+
+            // Short int runs fit in a register or two, where the same network is a handful of vector min/max
+            if constexpr (Simd::Dispatchable<Container, Compare>)
+            {
+                const Simd::KernelTable& kernels = Simd::Kernels();
+                if (kernels.network && n <= kernels.network_max)
+                {
+                    kernels.network(A.data() + start, n, Simd::Descending<Compare>);
+                    return;
+                }
+            }
+
+            // Sorted runs of length p are merged pairwise, each merge comparing at distance k = p, p/2, ..., 1
+            for (size_type p = 1; p < n; p <<= 1)
+            {
+                for (size_type k = p; k; k >>= 1)
+                {
+                    for (size_type j = k % p; j + k < n; j += (k << 1))
+                    {
+                        for (size_type i = 0; i < k && i + j + k < n; ++i)
+                        {
+                            // Only within one of the two runs being merged
+                            if ((i + j) / (p << 1) == (i + j + k) / (p << 1))
+                            {
+                                CompareExchange(A, start + i + j, start + i + j + k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+
+        static inline void CompareExchange(
+            Container& A,
+            const typename Container::size_type& low,
+            const typename Container::size_type& high
+        )
+        {
+            typename Container::value_type a = A[low];
+            typename Container::value_type b = A[high];
+
+            bool swap = s_compare(a, b);
+            A[low] = swap ? b : a;
+            A[high] = swap ? a : b;
+        }
+    };
+
+    template<typename Container, template<typename> typename Compare>
+    Compare<typename Container::value_type> SortingNetwork<Container, Compare>::s_compare;
+
+    template<typename Container>
+    using IncreasingSortingNetwork = SortingNetwork<Container, increasing>;
+
+    template<typename Container>
+    using DecreasingSortingNetwork = SortingNetwork<Container, decreasing>;
+}
+}
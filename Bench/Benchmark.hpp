@@ -0,0 +1,545 @@
+#pragma once
+
+#include "Generators.hpp"
+#include "Histogram.hpp"
+#include "PerfCounters.hpp"
+#include "Timestamp.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Keeps the compiler from proving value unused and throwing away the work that made it
+    *
+    ***************************************************************************************************************/
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        // No inline asm on x64 MSVC, a volatile read through the address does the same job
+        static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+        _ReadWriteBarrier();
+#endif
+    }
+
+    /***************************************************************************************************************
+    * Forces every pending write to memory before the clock is read again
+    *
+    ***************************************************************************************************************/
+    inline void ClobberMemory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    /***************************************************************************************************************
+    * Handed to a benchmark once per repetition.  Setup happens outside of Measure, and only what's inside is timed,
+    * and counted when the run was given hardware counters.  When the run asked for latencies, single operations
+    * inside Measure can be timed into a histogram per operation type as well.
+    ***************************************************************************************************************/
+    class State
+    {
+    public:
+        State(const std::vector<int>& input, PerfCounters* counters = nullptr, Latencies* latencies = nullptr)
+            : m_input(input),
+            m_counters(counters),
+            m_latencies(latencies),
+            m_elapsed(0.0)
+        {
+        }
+
+        const std::vector<int>& Input() const
+        {
+            return m_input;
+        }
+
+        size_t Size() const
+        {
+            return m_input.size();
+        }
+
+        template<typename Work>
+        void Measure(Work&& work)
+        {
+            if (m_counters)
+            {
+                m_counters->Start();
+            }
+
+            ClobberMemory();
+            Clock::time_point start = Clock::now();
+
+            work();
+
+            ClobberMemory();
+            Clock::time_point end = Clock::now();
+
+            // The counters wrap the clock reads, so the clock never pays for the ioctls
+            if (m_counters)
+            {
+                m_counts += m_counters->Stop();
+            }
+
+            m_elapsed += std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        // Histogram for one operation type, null unless the run records latencies.  Look it up outside the loop
+        Histogram* Latency(const std::string& operation)
+        {
+            return m_latencies ? &(*m_latencies)[operation] : nullptr;
+        }
+
+        /***********************************************************************************************************
+        * Runs one operation, recording how many ticks it took when histogram isn't null.  The clock reads land
+        * inside Measure, so a run with latencies on has slower totals than one without.
+        ***********************************************************************************************************/
+        template<typename Work>
+        void Time(Histogram* histogram, Work&& work)
+        {
+            if (!histogram)
+            {
+                work();
+                return;
+            }
+
+            uint64_t start = ReadTimestamp();
+            work();
+            histogram->Record(ReadTimestamp() - start);
+        }
+
+        // Nanoseconds spent inside Measure
+        double Elapsed() const
+        {
+            return m_elapsed;
+        }
+
+        // Hardware events seen inside Measure
+        const Counts& Counters() const
+        {
+            return m_counts;
+        }
+
+    private:
+        const std::vector<int>& m_input;
+        PerfCounters* m_counters;
+        Latencies* m_latencies;
+        double m_elapsed;
+        Counts m_counts;
+    };
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    struct Benchmark
+    {
+        // e.g. "sort" or "heap"
+        std::string suite;
+
+        // What's being measured, e.g. "QuickSort"
+        std::string name;
+
+        // How it's being driven, e.g. "Sort" or "Hold"
+        std::string workload;
+
+        // Larger inputs are skipped, keeps the quadratic sorts from running all day
+        size_t max_size;
+
+        // One repetition
+        std::function<void(State&)> run;
+    };
+
+    /***************************************************************************************************************
+    * Every benchmark, filled in by static registration before main runs
+    *
+    ***************************************************************************************************************/
+    inline std::vector<Benchmark>& Registry()
+    {
+        static std::vector<Benchmark> s_registry;
+        return s_registry;
+    }
+
+    inline void Register(
+        const std::string& suite,
+        const std::string& name,
+        const std::string& workload,
+        size_t max_size,
+        std::function<void(State&)> run
+    )
+    {
+        Registry().push_back(Benchmark{ suite, name, workload, max_size, std::move(run) });
+    }
+
+    /***************************************************************************************************************
+    * Replays a recorded trace instead of working from generated input.  Not every structure can take every trace,
+    * accepts says whether this one can.
+    ***************************************************************************************************************/
+    struct TraceBenchmark
+    {
+        std::string suite;
+        std::string name;
+        std::function<bool(const MappedTrace&)> accepts;
+        std::function<void(State&, const MappedTrace&)> run;
+    };
+
+    inline std::vector<TraceBenchmark>& TraceRegistry()
+    {
+        static std::vector<TraceBenchmark> s_registry;
+        return s_registry;
+    }
+
+    inline void RegisterTrace(
+        const std::string& suite,
+        const std::string& name,
+        std::function<bool(const MappedTrace&)> accepts,
+        std::function<void(State&, const MappedTrace&)> run
+    )
+    {
+        TraceRegistry().push_back(TraceBenchmark{ suite, name, std::move(accepts), std::move(run) });
+    }
+
+    /***************************************************************************************************************
+    * Summary of the repetitions of one benchmark on one input, all in nanoseconds
+    *
+    ***************************************************************************************************************/
+    struct Stats
+    {
+        double min;
+        double median;
+        double p99;
+        double mean;
+        size_t repetitions;
+    };
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    inline Stats Summarize(std::vector<double> samples)
+    {
+        Stats stats = { 0.0, 0.0, 0.0, 0.0, samples.size() };
+        if (samples.empty())
+        {
+            return stats;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        // Nearest rank, so every statistic is a time that was actually seen
+        auto percentile = [&samples](double p)
+        {
+            size_t rank = (size_t)std::ceil(p * (double)samples.size());
+            return samples[std::min(samples.size(), std::max<size_t>(rank, 1)) - 1];
+        };
+
+        double total = 0.0;
+        for (double sample : samples)
+        {
+            total += sample;
+        }
+
+        stats.min = samples.front();
+        stats.median = percentile(0.5);
+        stats.p99 = percentile(0.99);
+        stats.mean = total / (double)samples.size();
+
+        return stats;
+    }
+
+    /***************************************************************************************************************
+    * One operation type's latencies over every timed repetition, in nanoseconds
+    *
+    ***************************************************************************************************************/
+    struct LatencyStats
+    {
+        std::string operation;
+        uint64_t count;
+        double mean;
+        double p50;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    inline std::vector<LatencyStats> Summarize(const Latencies& latencies)
+    {
+        const double scale = NanosecondsPerTick();
+
+        std::vector<LatencyStats> stats;
+        for (const std::pair<const std::string, Histogram>& next : latencies)
+        {
+            // e.g. a trace with no AugmentKey in it
+            const Histogram& histogram = next.second;
+            if (!histogram.Count())
+            {
+                continue;
+            }
+
+            stats.push_back(LatencyStats{
+                next.first,
+                histogram.Count(),
+                histogram.Mean() * scale,
+                (double)histogram.Percentile(0.5) * scale,
+                (double)histogram.Percentile(0.99) * scale,
+                (double)histogram.Percentile(0.999) * scale,
+                (double)histogram.Max() * scale
+            });
+        }
+
+        return stats;
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    struct Result
+    {
+        std::string suite;
+        std::string name;
+        std::string workload;
+
+        // Distribution name for generated input, "trace:" and the trace's name for a replay
+        std::string input;
+
+        size_t size;
+        Stats stats;
+
+        // Mean per timed repetition, nothing available unless the run asked for counters
+        Counts counters;
+
+        // Per operation type, empty unless the run asked for latencies
+        std::vector<LatencyStats> latencies;
+    };
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    struct Config
+    {
+        // Untimed runs before the timed ones, to settle caches, branch predictors and the allocator
+        size_t warmup = 2;
+        size_t repetitions = 10;
+
+        std::vector<size_t> sizes = { 1 << 10, 1 << 14, 1 << 17 };
+        std::vector<Distribution> distributions = AllDistributions();
+
+        // Only benchmarks whose suite, name or workload contain this run
+        std::string filter;
+
+        unsigned int seed = 12345;
+
+        // Count hardware events around Measure as well, where the platform allows it
+        bool counters = false;
+
+        // Time every single operation the benchmarks mark into a histogram per operation type
+        bool latency = false;
+    };
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    inline bool Matches(const Benchmark& benchmark, const std::string& filter)
+    {
+        if (filter.empty())
+        {
+            return true;
+        }
+
+        std::string full = benchmark.suite + '/' + benchmark.name + '/' + benchmark.workload;
+        return full.find(filter) != std::string::npos;
+    }
+
+    /***************************************************************************************************************
+    * Warmup and timed repetitions of one benchmark on one input.  Counters are averaged per timed repetition, and
+    * the latencies of every timed repetition are merged into one histogram per operation type.
+    ***************************************************************************************************************/
+    struct Repetitions
+    {
+        std::vector<double> samples;
+        Counts counts;
+        Latencies latencies;
+    };
+
+    template<typename Run>
+    inline Repetitions Repeat(const Config& config, const std::vector<int>& input, PerfCounters* counters, Run&& run)
+    {
+        Repetitions repetitions;
+        repetitions.samples.reserve(config.repetitions);
+
+        for (size_t rep = 0; rep < config.warmup + config.repetitions; ++rep)
+        {
+            Latencies latencies;
+            State state(input, counters, config.latency ? &latencies : nullptr);
+            run(state);
+
+            if (rep >= config.warmup)
+            {
+                repetitions.samples.push_back(state.Elapsed());
+                repetitions.counts += state.Counters();
+                repetitions.latencies.Merge(latencies);
+            }
+        }
+
+        for (double& value : repetitions.counts.value)
+        {
+            value /= (double)std::max<size_t>(config.repetitions, 1);
+        }
+
+        return repetitions;
+    }
+
+    // Called with the full name of a benchmark that threw instead of finishing, it gets no result and the run goes on
+    using FailureReport = std::function<void(const std::string&, const std::exception&)>;
+
+    /***************************************************************************************************************
+    * Runs every registered benchmark that matches the filter on every distribution and size, calling report as each
+    * result comes in
+    ***************************************************************************************************************/
+    inline std::vector<Result> Run(
+        const Config& config,
+        const std::function<void(const Result&)>& report,
+        const FailureReport& failed
+    )
+    {
+        std::vector<Result> results;
+
+        std::unique_ptr<PerfCounters> counters;
+        if (config.counters)
+        {
+            counters.reset(new PerfCounters());
+        }
+
+        for (Distribution distribution : config.distributions)
+        {
+            for (size_t size : config.sizes)
+            {
+                // Every benchmark sees the same input for a distribution and size
+                std::vector<int> input = Generate(distribution, size, config.seed);
+
+                for (const Benchmark& benchmark : Registry())
+                {
+                    if (size > benchmark.max_size || !Matches(benchmark, config.filter))
+                    {
+                        continue;
+                    }
+
+                    Repetitions repetitions;
+                    try
+                    {
+                        repetitions = Repeat(config, input, counters.get(), benchmark.run);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        failed(benchmark.suite + '/' + benchmark.name + '/' + benchmark.workload + '/' +
+                            ToString(distribution) + '/' + std::to_string(size), e);
+                        continue;
+                    }
+
+                    results.push_back(Result{
+                        benchmark.suite,
+                        benchmark.name,
+                        benchmark.workload,
+                        ToString(distribution),
+                        size,
+                        Summarize(repetitions.samples),
+                        repetitions.counts,
+                        Summarize(repetitions.latencies)
+                    });
+
+                    report(results.back());
+                }
+            }
+        }
+
+        return results;
+    }
+
+    /***************************************************************************************************************
+    * Same as Run, but every trace benchmark that matches the filter and accepts a trace replays it.  Traces are
+    * named by the caller, usually after their file.
+    ***************************************************************************************************************/
+    inline std::vector<Result> RunTraces(
+        const Config& config,
+        const std::vector<std::pair<std::string, const MappedTrace*>>& traces,
+        const std::function<void(const Result&)>& report,
+        const FailureReport& failed
+    )
+    {
+        std::vector<Result> results;
+
+        std::unique_ptr<PerfCounters> counters;
+        if (config.counters)
+        {
+            counters.reset(new PerfCounters());
+        }
+
+        // Replays never look at the generated input
+        const std::vector<int> no_input;
+
+        for (const std::pair<std::string, const MappedTrace*>& trace : traces)
+        {
+            for (const TraceBenchmark& benchmark : TraceRegistry())
+            {
+                std::string full = benchmark.suite + '/' + benchmark.name + '/' + trace.first;
+                if ((!config.filter.empty() && full.find(config.filter) == std::string::npos) || !benchmark.accepts(*trace.second))
+                {
+                    continue;
+                }
+
+                const MappedTrace& mapped = *trace.second;
+                Repetitions repetitions;
+                try
+                {
+                    repetitions = Repeat(config, no_input, counters.get(), [&benchmark, &mapped](State& state)
+                    {
+                        benchmark.run(state, mapped);
+                    });
+                }
+                catch (const std::exception& e)
+                {
+                    failed(full, e);
+                    continue;
+                }
+
+                results.push_back(Result{
+                    benchmark.suite,
+                    benchmark.name,
+                    "Replay",
+                    "trace:" + trace.first,
+                    trace.second->Count(),
+                    Summarize(repetitions.samples),
+                    repetitions.counts,
+                    Summarize(repetitions.latencies)
+                });
+
+                report(results.back());
+            }
+        }
+
+        return results;
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Benchmark.hpp"
+#include "Generators.hpp"
+#include "Reporters.hpp"
+
+#include "BinaryInsertionSort.hpp"
+#include "InsertionSort.hpp"
+#include "SmartMergeSort.hpp"
+#include "SmartQuickSort.hpp"
+#include "SortingNetwork.hpp"
+
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * What the calibration settled on for one hybrid sort.  Cost is the median time per element averaged over every
+    * input, so a small and a large input weigh the same.
+    ***************************************************************************************************************/
+    struct TuningChoice
+    {
+        std::string sorter;
+        size_t threshold = 0;
+        double cost = std::numeric_limits<double>::max();
+    };
+
+    struct TuningResult
+    {
+        TuningChoice merge;
+        TuningChoice quick;
+    };
+
+    // Cutoffs tried for every small sorter
+    using TuningThresholds = std::index_sequence<4, 8, 12, 16, 24, 32, 40, 48, 64, 96, 128>;
+
+    using TuningContainer = std::vector<int>;
+
+    /***************************************************************************************************************
+    * Median of reps timed sorts of a fresh copy of every input, after warmup untimed ones
+    *
+    ***************************************************************************************************************/
+    template<typename Sorter>
+    double TimeSorter(const std::vector<TuningContainer>& inputs, size_t warmup, size_t reps)
+    {
+        double cost = 0.0;
+        for (const TuningContainer& input : inputs)
+        {
+            std::vector<double> samples;
+            for (size_t i = 0; i < warmup + reps; ++i)
+            {
+                TuningContainer data(input);
+
+                Clock::time_point start = Clock::now();
+                Sorter::Sort(data);
+                ClobberMemory();
+                Clock::time_point end = Clock::now();
+
+                DoNotOptimize(data.data());
+
+                if (i >= warmup)
+                {
+                    samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+                }
+            }
+
+            cost += Summarize(samples).median / (double)input.size();
+        }
+
+        return cost / (double)std::max<size_t>(inputs.size(), 1);
+    }
+
+    /***************************************************************************************************************
+    * Every threshold for one small sorter inside one hybrid, anything cheaper than best replaces it
+    *
+    ***************************************************************************************************************/
+    template<
+        template<typename, typename, template<typename> typename, size_t> typename Hybrid,
+        template<typename, template<typename> typename> typename SmallSorter,
+        size_t... Thresholds
+    >
+    void TuneHybrid(
+        const std::string& hybrid,
+        const std::string& sorter,
+        std::index_sequence<Thresholds...>,
+        const std::vector<TuningContainer>& inputs,
+        size_t warmup,
+        size_t reps,
+        TuningChoice& best,
+        std::ostream& log
+    )
+    {
+        auto consider = [&](size_t threshold, double cost)
+        {
+            log << hybrid << " + " << sorter << " at " << threshold << ": " << cost << " ns/element\n";
+
+            if (cost < best.cost)
+            {
+                best.sorter = sorter;
+                best.threshold = threshold;
+                best.cost = cost;
+            }
+        };
+
+        using Small = SmallSorter<TuningContainer, Algorithms::Sort::increasing>;
+
+        (consider(Thresholds, TimeSorter<Hybrid<TuningContainer, Small, Algorithms::Sort::increasing, Thresholds>>(inputs, warmup, reps)), ...);
+    }
+
+    /***************************************************************************************************************
+    * Times SmartMergeSort and SmartQuickSort with each small sorter over each cutoff on int keys, on every input
+    * shape at a couple of sizes, and keeps the cheapest pair for each.  Takes a minute or so.
+    ***************************************************************************************************************/
+    inline TuningResult TuneSorts(const Config& config, std::ostream& log)
+    {
+        using namespace Algorithms::Sort;
+
+        const size_t sizes[] = { 1 << 12, 1 << 16 };
+
+        std::vector<TuningContainer> inputs;
+        for (size_t size : sizes)
+        {
+            for (Distribution distribution : AllDistributions())
+            {
+                inputs.push_back(Generate(distribution, size, config.seed));
+            }
+        }
+
+        const size_t warmup = config.warmup;
+        const size_t reps = std::max<size_t>(config.repetitions, 1);
+
+        TuningResult result;
+
+        TuneHybrid<SmartMergeSort, InsertionSort>       ("SmartMergeSort", "InsertionSort",         TuningThresholds(), inputs, warmup, reps, result.merge, log);
+        TuneHybrid<SmartMergeSort, BinaryInsertionSort> ("SmartMergeSort", "BinaryInsertionSort",   TuningThresholds(), inputs, warmup, reps, result.merge, log);
+        TuneHybrid<SmartMergeSort, SortingNetwork>      ("SmartMergeSort", "SortingNetwork",        TuningThresholds(), inputs, warmup, reps, result.merge, log);
+
+        TuneHybrid<SmartQuickSort, InsertionSort>       ("SmartQuickSort", "InsertionSort",         TuningThresholds(), inputs, warmup, reps, result.quick, log);
+        TuneHybrid<SmartQuickSort, BinaryInsertionSort> ("SmartQuickSort", "BinaryInsertionSort",   TuningThresholds(), inputs, warmup, reps, result.quick, log);
+        TuneHybrid<SmartQuickSort, SortingNetwork>      ("SmartQuickSort", "SortingNetwork",        TuningThresholds(), inputs, warmup, reps, result.quick, log);
+
+        return result;
+    }
+
+    /***************************************************************************************************************
+    * Same layout as Algorithms/sort/SortTuning.hpp, so the output can replace it as is
+    *
+    ***************************************************************************************************************/
+    inline void WriteTuningHeader(std::ostream& out, const Context& context, const TuningResult& result)
+    {
+        out << "#pragma once\n"
+            << "\n"
+            << "// Cutoffs and small sorters for the hybrid sorts.  Written by Bench --tune-sorts on " << context.date << ",\n"
+            << "// " << context.compiler << ", " << context.build << " build, int keys\n"
+            << "\n"
+            << "#include \"InsertionSort.hpp\"\n"
+            << "#include \"BinaryInsertionSort.hpp\"\n"
+            << "#include \"SortingNetwork.hpp\"\n"
+            << "\n"
+            << "#include <cstddef>\n"
+            << "\n"
+            << "namespace Algorithms\n"
+            << "{\n"
+            << "namespace Sort\n"
+            << "{\n"
+            << "namespace Tuning\n"
+            << "{\n"
+            << "    // SmartMergeSort hands ranges of at most this many elements to the small sorter\n"
+            << "    const size_t SMART_MERGE_THRESHOLD = " << result.merge.threshold << ";\n"
+            << "\n"
+            << "    template<typename Container, template<typename> typename Compare>\n"
+            << "    using SmartMergeSmallSorter = " << result.merge.sorter << "<Container, Compare>;\n"
+            << "\n"
+            << "    // SmartQuickSort and IntroSort stop partitioning at this many elements\n"
+            << "    const size_t SMART_QUICK_THRESHOLD = " << result.quick.threshold << ";\n"
+            << "\n"
+            << "    template<typename Container, template<typename> typename Compare>\n"
+            << "    using SmartQuickSmallSorter = " << result.quick.sorter << "<Container, Compare>;\n"
+            << "}\n"
+            << "}\n"
+            << "}\n";
+    }
+}
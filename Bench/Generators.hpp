@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Shapes of input.  Every generator hands back n values in [0, n), so CountingSort and the integer heaps can take
+    * any of them
+    ***************************************************************************************************************/
+    enum class Distribution
+    {
+        Random,
+        Sorted,
+        Reversed,
+        Sawtooth,
+        FewUnique,
+        OrganPipe
+    };
+
+    inline std::vector<Distribution> AllDistributions()
+    {
+        return {
+            Distribution::Random,
+            Distribution::Sorted,
+            Distribution::Reversed,
+            Distribution::Sawtooth,
+            Distribution::FewUnique,
+            Distribution::OrganPipe
+        };
+    }
+
+    inline const char* ToString(Distribution distribution)
+    {
+        switch (distribution)
+        {
+        case Distribution::Random:      return "random";
+        case Distribution::Sorted:      return "sorted";
+        case Distribution::Reversed:    return "reversed";
+        case Distribution::Sawtooth:    return "sawtooth";
+        case Distribution::FewUnique:   return "few_unique";
+        case Distribution::OrganPipe:   return "organ_pipe";
+        }
+
+        return "unknown";
+    }
+
+    // false if name isn't one of the names ToString hands out
+    inline bool FromString(const std::string& name, Distribution& distribution)
+    {
+        for (Distribution next : AllDistributions())
+        {
+            if (name == ToString(next))
+            {
+                distribution = next;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    inline std::vector<int> Generate(Distribution distribution, size_t n, unsigned int seed)
+    {
+        std::vector<int> values(n);
+        if (!n)
+        {
+            return values;
+        }
+
+        std::mt19937 rng(seed);
+
+        switch (distribution)
+        {
+        case Distribution::Random:
+        {
+            std::uniform_int_distribution<int> uniform(0, (int)n - 1);
+            for (int& value : values)
+            {
+                value = uniform(rng);
+            }
+            break;
+        }
+        case Distribution::Sorted:
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = (int)i;
+            }
+            break;
+        case Distribution::Reversed:
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = (int)(n - 1 - i);
+            }
+            break;
+        case Distribution::Sawtooth:
+        {
+            // Sorted runs, about sqrt(n) of them
+            size_t run = std::max<size_t>(1, (size_t)std::sqrt((double)n));
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = (int)((i % run) * (n / run));
+            }
+            break;
+        }
+        case Distribution::FewUnique:
+        {
+            // 16 distinct values, spread over the range
+            std::uniform_int_distribution<int> pick(0, 15);
+            for (int& value : values)
+            {
+                value = (int)((size_t)pick(rng) * (n / 16));
+            }
+            break;
+        }
+        case Distribution::OrganPipe:
+            // Up to the middle, then back down
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = (int)(i < (n >> 1) ? (i << 1) : ((n - 1 - i) << 1));
+            }
+            break;
+        }
+
+        return values;
+    }
+}
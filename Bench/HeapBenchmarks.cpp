@@ -0,0 +1,186 @@
+#include "Benchmark.hpp"
+
+#include "BinaryHeap.hpp"
+#include "BinomialHeap.hpp"
+#include "BucketQueue.hpp"
+#include "CalendarQueue.hpp"
+#include "FibonacciHeap.hpp"
+#include "MultiQueue.hpp"
+#include "PairingHeap.hpp"
+#include "RadixHeap.hpp"
+#include "RankPairingHeap.hpp"
+#include "TimerWheel.hpp"
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+using namespace Datastructures::Heaps;
+
+namespace
+{
+    // Every heap is a min heap here, the integer heaps can't be anything else
+    using StlPriorityQueue = std::priority_queue<int, std::vector<int>, std::greater<int>>;
+
+    template<typename Heap>
+    inline void Push(Heap& heap, int key)
+    {
+        heap.Insert(key);
+    }
+
+    inline void Push(StlPriorityQueue& heap, int key)
+    {
+        heap.push(key);
+    }
+
+    // Node heaps hand back a node the caller owns from then on, value heaps hand back the key itself
+    template<typename Heap>
+    inline int Pop(Heap& heap)
+    {
+        auto top = heap.ExtractTop();
+
+        if constexpr (std::is_pointer<decltype(top)>::value)
+        {
+            int key = top->Key();
+            delete top;
+            return key;
+        }
+        else
+        {
+            return top;
+        }
+    }
+
+    inline int Pop(StlPriorityQueue& heap)
+    {
+        int key = heap.top();
+        heap.pop();
+        return key;
+    }
+
+    template<typename Heap>
+    inline bool IsEmpty(Heap& heap)
+    {
+        return heap.Empty();
+    }
+
+    inline bool IsEmpty(StlPriorityQueue& heap)
+    {
+        return heap.empty();
+    }
+
+    /***************************************************************************************************************
+    * Three workloads per heap, one per operation class so each gets its own time and counters.  Insert pushes the
+    * whole input and ExtractTop drains it again, the other half untimed in both.  Hold is the classic priority
+    * queue benchmark: prefill with the input, untimed, then pop the top and push it back a little later, once per
+    * input element.  Hold only ever pushes keys at or after the last top, so the monotone heaps take it too.  Every
+    * Insert and ExtractTop is timed on its own as well when the run records latencies
+    ***************************************************************************************************************/
+    template<typename Heap>
+    void RegisterHeap(const std::string& name, std::function<std::unique_ptr<Heap>(size_t)> make)
+    {
+        const size_t unlimited = std::numeric_limits<size_t>::max();
+
+        Bench::Register("heap", name, "Insert", unlimited, [make](Bench::State& state)
+        {
+            std::unique_ptr<Heap> heap = make(state.Size());
+            Bench::Histogram* insert = state.Latency("Insert");
+
+            state.Measure([&]()
+            {
+                for (int key : state.Input())
+                {
+                    state.Time(insert, [&]() { Push(*heap, key); });
+                }
+            });
+        });
+
+        Bench::Register("heap", name, "ExtractTop", unlimited, [make](Bench::State& state)
+        {
+            std::unique_ptr<Heap> heap = make(state.Size());
+
+            for (int key : state.Input())
+            {
+                Push(*heap, key);
+            }
+
+            Bench::Histogram* extract = state.Latency("ExtractTop");
+
+            state.Measure([&]()
+            {
+                long long total = 0;
+                while (!IsEmpty(*heap))
+                {
+                    state.Time(extract, [&]() { total += Pop(*heap); });
+                }
+
+                Bench::DoNotOptimize(total);
+            });
+        });
+
+        Bench::Register("heap", name, "Hold", unlimited, [make](Bench::State& state)
+        {
+            std::unique_ptr<Heap> heap = make(state.Size());
+
+            for (int key : state.Input())
+            {
+                Push(*heap, key);
+            }
+
+            Bench::Histogram* insert = state.Latency("Insert");
+            Bench::Histogram* extract = state.Latency("ExtractTop");
+
+            state.Measure([&]()
+            {
+                for (int key : state.Input())
+                {
+                    int top = 0;
+                    state.Time(extract, [&]() { top = Pop(*heap); });
+                    state.Time(insert, [&]() { Push(*heap, top + 1 + (key & 63)); });
+                }
+            });
+        });
+    }
+
+    template<typename Heap>
+    std::unique_ptr<Heap> Make(size_t)
+    {
+        return std::unique_ptr<Heap>(new Heap());
+    }
+
+    bool RegisterHeaps()
+    {
+        RegisterHeap<MinBinaryHeap<int>>            ("BinaryHeap",              Make<MinBinaryHeap<int>>);
+        RegisterHeap<MinUncheckedBinaryHeap<int>>   ("UncheckedBinaryHeap",     Make<MinUncheckedBinaryHeap<int>>);
+        RegisterHeap<MinFibonacciHeap<int>>         ("FibonacciHeap",           Make<MinFibonacciHeap<int>>);
+        RegisterHeap<MinBinomialHeap<int>>          ("BinomialHeap",            Make<MinBinomialHeap<int>>);
+        RegisterHeap<MinPairingHeap<int>>           ("PairingHeap",             Make<MinPairingHeap<int>>);
+        RegisterHeap<MinMultipassPairingHeap<int>>  ("MultipassPairingHeap",    Make<MinMultipassPairingHeap<int>>);
+        RegisterHeap<MinLazyPairingHeap<int>>       ("LazyPairingHeap",         Make<MinLazyPairingHeap<int>>);
+        RegisterHeap<MinRankPairingHeapT1<int>>     ("RankPairingHeapT1",       Make<MinRankPairingHeapT1<int>>);
+        RegisterHeap<MinRankPairingHeapT2<int>>     ("RankPairingHeapT2",       Make<MinRankPairingHeapT2<int>>);
+        RegisterHeap<RadixHeap<int>>                ("RadixHeap",               Make<RadixHeap<int>>);
+        RegisterHeap<TimerWheel<int>>               ("TimerWheel",              Make<TimerWheel<int>>);
+        RegisterHeap<CalendarQueue<int>>            ("CalendarQueue",           Make<CalendarQueue<int>>);
+        RegisterHeap<StlPriorityQueue>              ("std::priority_queue",     Make<StlPriorityQueue>);
+
+        // The prefill spans the whole input, Hold never pushes more than 64 past the top
+        RegisterHeap<BucketQueue<int>>("BucketQueue", [](size_t size)
+        {
+            return std::unique_ptr<BucketQueue<int>>(new BucketQueue<int>(size + 64));
+        });
+
+        // Single threaded here, this is the cost of the relaxation alone
+        RegisterHeap<MinMultiQueue<int>>("MultiQueue", [](size_t)
+        {
+            return std::unique_ptr<MinMultiQueue<int>>(new MinMultiQueue<int>(1));
+        });
+
+        return true;
+    }
+
+    const bool s_registered = RegisterHeaps();
+}
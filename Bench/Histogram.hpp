@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * High dynamic range histogram of non negative integers, usually timestamp ticks.  Values are kept to a fixed
+    * number of significant decimal digits across the whole range: every power of two gets the same number of
+    * linear sub buckets, so a value of a few hundred and a value of a few hundred million are both resolved to
+    * about one part in 10^digits.  Recording is a couple of shifts and an increment, with no allocation, so it can
+    * sit around every single operation of a benchmark.
+    *
+    * Min, max, count and the sum are kept exactly.  Percentiles are the top of the bucket the rank falls in,
+    * never more than the exact max.  Two histograms with the same layout merge by adding their buckets, which is
+    * how repetitions and threads that each recorded their own are combined.
+    ***************************************************************************************************************/
+    class Histogram
+    {
+    public:
+        // Up to 2^40 ticks by default, several minutes of TSC on anything current
+        explicit Histogram(uint64_t highest = 1ull << 40, unsigned int digits = 3) :
+            m_highest(highest),
+            m_digits(digits),
+            m_count(0),
+            m_total(0.0),
+            m_min(UINT64_MAX),
+            m_max(0)
+        {
+            if (digits < 1 || digits > 5 || highest < 2)
+            {
+                throw std::invalid_argument("Histogram needs 1 to 5 significant digits and a highest value above 1");
+            }
+
+            // Twice 10^digits sub buckets per power of two, rounded up to a power of two itself
+            uint64_t sub_buckets = 2;
+            for (unsigned int i = 0; i < digits; ++i)
+            {
+                sub_buckets *= 10;
+            }
+
+            m_sub_bucket_bits = 1;
+            while ((1ull << m_sub_bucket_bits) < sub_buckets)
+            {
+                ++m_sub_bucket_bits;
+            }
+
+            m_sub_bucket_mask = (1ull << m_sub_bucket_bits) - 1;
+            m_counts.assign(Index(highest) + 1, 0);
+        }
+
+        void Record(uint64_t value, uint64_t count = 1)
+        {
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+            m_count += count;
+            m_total += (double)value * (double)count;
+
+            // Past the end is folded into the last bucket, the exact max still says how far past
+            m_counts[Index(std::min(value, m_highest))] += count;
+        }
+
+        /***********************************************************************************************************
+        * Adds everything rhs recorded, throws unless both were built with the same highest value and digits
+        *
+        ***********************************************************************************************************/
+        void Merge(const Histogram& rhs)
+        {
+            if (m_highest != rhs.m_highest || m_digits != rhs.m_digits)
+            {
+                throw std::invalid_argument("Only histograms with the same range and precision merge");
+            }
+
+            for (size_t i = 0; i < m_counts.size(); ++i)
+            {
+                m_counts[i] += rhs.m_counts[i];
+            }
+
+            m_min = std::min(m_min, rhs.m_min);
+            m_max = std::max(m_max, rhs.m_max);
+            m_count += rhs.m_count;
+            m_total += rhs.m_total;
+        }
+
+        void Reset()
+        {
+            std::fill(m_counts.begin(), m_counts.end(), 0);
+            m_count = 0;
+            m_total = 0.0;
+            m_min = UINT64_MAX;
+            m_max = 0;
+        }
+
+        /***********************************************************************************************************
+        * Smallest recorded value at or above a fraction p of all the values, by nearest rank like Summarize
+        *
+        ***********************************************************************************************************/
+        uint64_t Percentile(double p) const
+        {
+            if (!m_count)
+            {
+                return 0;
+            }
+
+            uint64_t rank = (uint64_t)std::ceil(p * (double)m_count);
+            rank = std::min(m_count, std::max<uint64_t>(rank, 1));
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < m_counts.size(); ++i)
+            {
+                seen += m_counts[i];
+                if (seen >= rank)
+                {
+                    return std::max(m_min, std::min(m_max, HighestEquivalent(i)));
+                }
+            }
+
+            return m_max;
+        }
+
+        uint64_t Count() const
+        {
+            return m_count;
+        }
+
+        uint64_t Min() const
+        {
+            return m_count ? m_min : 0;
+        }
+
+        uint64_t Max() const
+        {
+            return m_max;
+        }
+
+        double Mean() const
+        {
+            return m_count ? m_total / (double)m_count : 0.0;
+        }
+
+    private:
+        static inline unsigned int LeadingZeros(uint64_t bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, bits);
+            return 63 - (unsigned int)index;
+#else
+            return (unsigned int)__builtin_clzll(bits);
+#endif
+        }
+
+        /***********************************************************************************************************
+        * Bucket 0 holds every value below the sub bucket count one apart.  Each bucket after covers the next power
+        * of two with half as many sub buckets, twice as wide, since its lower half is already covered.
+        ***********************************************************************************************************/
+        inline size_t Index(uint64_t value) const
+        {
+            // Never zero, so the leading zeros are always defined
+            unsigned int bucket = (64 - LeadingZeros(value | m_sub_bucket_mask)) - m_sub_bucket_bits;
+            uint64_t sub_bucket = value >> bucket;
+
+            return ((size_t)bucket << (m_sub_bucket_bits - 1)) + (size_t)sub_bucket;
+        }
+
+        inline uint64_t HighestEquivalent(size_t index) const
+        {
+            size_t half = (size_t)1 << (m_sub_bucket_bits - 1);
+            unsigned int bucket = index < (half << 1) ? 0 : (unsigned int)(index / half) - 1;
+            uint64_t sub_bucket = (uint64_t)(index - ((size_t)bucket << (m_sub_bucket_bits - 1)));
+
+            return ((sub_bucket + 1) << bucket) - 1;
+        }
+
+        std::vector<uint64_t> m_counts;
+
+        uint64_t m_highest;
+        unsigned int m_digits;
+        unsigned int m_sub_bucket_bits;
+        uint64_t m_sub_bucket_mask;
+
+        uint64_t m_count;
+        double m_total;
+        uint64_t m_min;
+        uint64_t m_max;
+    };
+
+    /***************************************************************************************************************
+    * One histogram per operation type, e.g. "Insert" and "ExtractTop", made on first use.  Look the histogram up
+    * once and record into it directly, the lookup is a map search.
+    ***************************************************************************************************************/
+    class Latencies
+    {
+    public:
+        Histogram& operator[](const std::string& operation)
+        {
+            std::map<std::string, Histogram>::iterator it = m_histograms.find(operation);
+            if (it == m_histograms.end())
+            {
+                it = m_histograms.emplace(operation, Histogram()).first;
+            }
+
+            return it->second;
+        }
+
+        void Merge(const Latencies& rhs)
+        {
+            for (const std::pair<const std::string, Histogram>& next : rhs.m_histograms)
+            {
+                (*this)[next.first].Merge(next.second);
+            }
+        }
+
+        bool Empty() const
+        {
+            return m_histograms.empty();
+        }
+
+        std::map<std::string, Histogram>::const_iterator begin() const
+        {
+            return m_histograms.begin();
+        }
+
+        std::map<std::string, Histogram>::const_iterator end() const
+        {
+            return m_histograms.end();
+        }
+
+    private:
+        std::map<std::string, Histogram> m_histograms;
+    };
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Hardware events counted around Measure
+    *
+    ***************************************************************************************************************/
+    enum class Event
+    {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1DMisses,
+        LLCMisses,
+        DTLBMisses,
+        Count
+    };
+
+    inline const char* ToString(Event event)
+    {
+        switch (event)
+        {
+        case Event::Cycles:         return "cycles";
+        case Event::Instructions:   return "instructions";
+        case Event::BranchMisses:   return "branch_misses";
+        case Event::L1DMisses:      return "l1d_misses";
+        case Event::LLCMisses:      return "llc_misses";
+        case Event::DTLBMisses:     return "dtlb_misses";
+        case Event::Count:          break;
+        }
+
+        return "unknown";
+    }
+
+    const size_t EVENT_COUNT = (size_t)Event::Count;
+
+    /***************************************************************************************************************
+    * One count per event.  An event the CPU or kernel won't give us is just left unavailable, it doesn't take the
+    * others down with it
+    ***************************************************************************************************************/
+    struct Counts
+    {
+        double value[EVENT_COUNT] = {};
+        bool available[EVENT_COUNT] = {};
+
+        Counts& operator+=(const Counts& rhs)
+        {
+            for (size_t i = 0; i < EVENT_COUNT; ++i)
+            {
+                value[i] += rhs.value[i];
+                available[i] = available[i] || rhs.available[i];
+            }
+            return *this;
+        }
+
+        bool Any() const
+        {
+            for (bool next : available)
+            {
+                if (next)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /***************************************************************************************************************
+    * perf_event_open counters for the calling thread, user space only.  Every event is opened on its own rather than
+    * as one group, a group larger than the PMU never gets scheduled at all, while single events get multiplexed and
+    * scaled back up from time enabled / time running.  Anywhere other than Linux, or when perf_event_paranoid says
+    * no, nothing opens and Available() is false, so callers never have to check the platform themselves
+    ***************************************************************************************************************/
+    class PerfCounters
+    {
+    public:
+        PerfCounters()
+        {
+            for (int& fd : m_fds)
+            {
+                fd = -1;
+            }
+
+#ifdef __linux__
+            for (size_t i = 0; i < EVENT_COUNT; ++i)
+            {
+                m_fds[i] = Open((Event)i);
+            }
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#ifdef __linux__
+            for (int fd : m_fds)
+            {
+                if (fd != -1)
+                {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool Available() const
+        {
+            for (int fd : m_fds)
+            {
+                if (fd != -1)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /***********************************************************************************************************
+        * Zeroes and starts every open counter
+        *
+        ***********************************************************************************************************/
+        void Start()
+        {
+#ifdef __linux__
+            for (int fd : m_fds)
+            {
+                if (fd != -1)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        /***********************************************************************************************************
+        * Stops every open counter and reads what it saw since Start
+        *
+        ***********************************************************************************************************/
+        Counts Stop()
+        {
+            Counts counts;
+
+#ifdef __linux__
+            for (int fd : m_fds)
+            {
+                if (fd != -1)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+
+            for (size_t i = 0; i < EVENT_COUNT; ++i)
+            {
+                if (m_fds[i] == -1)
+                {
+                    continue;
+                }
+
+                // value, time enabled, time running
+                uint64_t data[3] = {};
+                if (read(m_fds[i], data, sizeof(data)) != (ssize_t)sizeof(data) || !data[2])
+                {
+                    continue;
+                }
+
+                counts.value[i] = (double)data[0] * ((double)data[1] / (double)data[2]);
+                counts.available[i] = true;
+            }
+#endif
+
+            return counts;
+        }
+
+    private:
+#ifdef __linux__
+        static int Open(Event event)
+        {
+            perf_event_attr attr = {};
+            attr.size = sizeof(attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+            switch (event)
+            {
+            case Event::Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Event::Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case Event::BranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case Event::L1DMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+                break;
+            case Event::LLCMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | read_miss;
+                break;
+            case Event::DTLBMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_DTLB | read_miss;
+                break;
+            case Event::Count:
+                return -1;
+            }
+
+            // This thread, any CPU, no group
+            return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+
+        int m_fds[EVENT_COUNT];
+    };
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "Benchmark.hpp"
+#include "Dispatch.hpp"
+
+#include <ctime>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Enough about the build and the machine to tell whether two result files can be compared at all
+    *
+    ***************************************************************************************************************/
+    struct Context
+    {
+        std::string compiler;
+        std::string build;
+        std::string date;
+        unsigned int threads;
+
+        // Kernels the sorts and searches dispatched to, see --isa
+        std::string isa;
+    };
+
+    inline Context CurrentContext()
+    {
+        Context context;
+
+#if defined(__clang__)
+        context.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        context.compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+        context.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+        context.compiler = "unknown";
+#endif
+
+#ifdef DEBUG
+        context.build = "debug";
+#else
+        context.build = "release";
+#endif
+
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        context.date = date;
+
+        context.threads = std::thread::hardware_concurrency();
+        context.isa = Algorithms::Simd::IsaName(Algorithms::Simd::ActiveIsa());
+
+        return context;
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    inline std::string Escape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    /***************************************************************************************************************
+    * One object holding the context and an array of results, times in nanoseconds
+    *
+    ***************************************************************************************************************/
+    inline void WriteJson(std::ostream& out, const Context& context, const std::vector<Result>& results)
+    {
+        out << std::setprecision(17);
+
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"compiler\": \"" << Escape(context.compiler) << "\",\n"
+            << "    \"build\": \"" << context.build << "\",\n"
+            << "    \"date\": \"" << context.date << "\",\n"
+            << "    \"threads\": " << context.threads << ",\n"
+            << "    \"isa\": \"" << context.isa << "\"\n"
+            << "  },\n"
+            << "  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+
+            out << (i ? ",\n" : "\n")
+                << "    {"
+                << "\"suite\": \"" << Escape(result.suite) << "\", "
+                << "\"name\": \"" << Escape(result.name) << "\", "
+                << "\"workload\": \"" << Escape(result.workload) << "\", "
+                << "\"input\": \"" << Escape(result.input) << "\", "
+                << "\"size\": " << result.size << ", "
+                << "\"repetitions\": " << result.stats.repetitions << ", "
+                << "\"min_ns\": " << result.stats.min << ", "
+                << "\"median_ns\": " << result.stats.median << ", "
+                << "\"p99_ns\": " << result.stats.p99 << ", "
+                << "\"mean_ns\": " << result.stats.mean;
+
+            // Only the events that were actually counted, per repetition
+            if (result.counters.Any())
+            {
+                out << ", \"counters\": {";
+
+                bool first = true;
+                for (size_t event = 0; event < EVENT_COUNT; ++event)
+                {
+                    if (!result.counters.available[event])
+                    {
+                        continue;
+                    }
+
+                    out << (first ? "" : ", ") << '"' << ToString((Event)event) << "\": " << result.counters.value[event];
+                    first = false;
+                }
+
+                out << "}";
+            }
+
+            // Only when the run recorded them, one object per operation type
+            if (!result.latencies.empty())
+            {
+                out << ", \"latencies\": {";
+
+                for (size_t j = 0; j < result.latencies.size(); ++j)
+                {
+                    const LatencyStats& latency = result.latencies[j];
+
+                    out << (j ? ", " : "") << '"' << Escape(latency.operation) << "\": {"
+                        << "\"count\": " << latency.count << ", "
+                        << "\"mean_ns\": " << latency.mean << ", "
+                        << "\"p50_ns\": " << latency.p50 << ", "
+                        << "\"p99_ns\": " << latency.p99 << ", "
+                        << "\"p999_ns\": " << latency.p999 << ", "
+                        << "\"max_ns\": " << latency.max << "}";
+                }
+
+                out << "}";
+            }
+
+            out << "}";
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    /***************************************************************************************************************
+    * One header row, then one row per result, times in nanoseconds.  Counter columns are always there and left
+    * empty when an event wasn't counted.  Latencies vary in number per result, so they're only in the JSON
+    ***************************************************************************************************************/
+    inline void WriteCsv(std::ostream& out, const std::vector<Result>& results)
+    {
+        out << std::setprecision(17);
+
+        out << "suite,name,workload,input,size,repetitions,min_ns,median_ns,p99_ns,mean_ns";
+        for (size_t event = 0; event < EVENT_COUNT; ++event)
+        {
+            out << ',' << ToString((Event)event);
+        }
+        out << '\n';
+
+        for (const Result& result : results)
+        {
+            // Names and trace names are free text, so they're quoted
+            out << result.suite << ','
+                << '"' << result.name << '"' << ','
+                << result.workload << ','
+                << '"' << result.input << '"' << ','
+                << result.size << ','
+                << result.stats.repetitions << ','
+                << result.stats.min << ','
+                << result.stats.median << ','
+                << result.stats.p99 << ','
+                << result.stats.mean;
+
+            for (size_t event = 0; event < EVENT_COUNT; ++event)
+            {
+                out << ',';
+                if (result.counters.available[event])
+                {
+                    out << result.counters.value[event];
+                }
+            }
+
+            out << '\n';
+        }
+    }
+
+    /***************************************************************************************************************
+    * One line per result as it finishes, median time per element is the number to eyeball
+    *
+    ***************************************************************************************************************/
+    inline void WriteConsole(std::ostream& out, const Result& result)
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2)
+            << std::left << std::setw(6) << result.suite
+            << std::setw(40) << result.name
+            << std::setw(12) << result.workload
+            << std::setw(12) << result.input
+            << std::right << std::setw(9) << result.size
+            << std::setw(14) << result.stats.median / 1e6 << " ms"
+            << std::setw(10) << result.stats.median / (double)std::max<size_t>(result.size, 1) << " ns/elem"
+            << "  (min " << result.stats.min / 1e6 << ", p99 " << result.stats.p99 / 1e6 << ")\n";
+
+        // Per element, the rates that say whether something is branch or miss bound
+        const Counts& counters = result.counters;
+        if (counters.Any())
+        {
+            double elements = (double)std::max<size_t>(result.size, 1);
+
+            ss << std::setw(70) << "";
+            if (counters.available[(size_t)Event::Cycles] && counters.available[(size_t)Event::Instructions])
+            {
+                ss << "IPC " << counters.value[(size_t)Event::Instructions] / counters.value[(size_t)Event::Cycles] << "  ";
+            }
+
+            for (Event event : { Event::BranchMisses, Event::L1DMisses, Event::LLCMisses, Event::DTLBMisses })
+            {
+                if (counters.available[(size_t)event])
+                {
+                    ss << ToString(event) << '/' << "elem " << counters.value[(size_t)event] / elements << "  ";
+                }
+            }
+
+            ss << '\n';
+        }
+
+        for (const LatencyStats& latency : result.latencies)
+        {
+            ss << std::setw(70) << "" << std::left << std::setw(12) << latency.operation << std::right
+                << "n " << latency.count
+                << "  mean " << latency.mean
+                << "  p50 " << latency.p50
+                << "  p99 " << latency.p99
+                << "  p99.9 " << latency.p999
+                << "  max " << latency.max << " ns\n";
+        }
+
+        out << ss.str();
+    }
+}
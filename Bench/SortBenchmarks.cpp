@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+
+#include "BinaryHeap.hpp"
+#include "FibonacciHeap.hpp"
+#include "BinomialHeap.hpp"
+#include "PairingHeap.hpp"
+
+#include "BinaryInsertionSort.hpp"
+#include "BubbleSort.hpp"
+#include "CountingSort.hpp"
+#include "HeapSort.hpp"
+#include "InsertionSort.hpp"
+#include "IntroSort.hpp"
+#include "MergeSort.hpp"
+#include "QuickSort.hpp"
+#include "SmartMergeSort.hpp"
+#include "SmartQuickSort.hpp"
+#include "SortingNetwork.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace Datastructures::Heaps;
+using namespace Algorithms::Sort;
+
+namespace
+{
+    using Container = std::vector<int>;
+
+    // The quadratic sorts stop here
+    const size_t QUADRATIC_LIMIT = 1 << 12;
+
+    // Keys CountingSort can take, the generators never go past the input size
+    const Container::size_type COUNTING_RANGE = 1 << 17;
+
+    /***************************************************************************************************************
+    * Sorts a fresh copy of the input every repetition, the copy isn't timed
+    *
+    ***************************************************************************************************************/
+    template<typename Sorter>
+    void RegisterSort(const std::string& name, size_t max_size = std::numeric_limits<size_t>::max())
+    {
+        Bench::Register("sort", name, "Sort", max_size, [](Bench::State& state)
+        {
+            Container data(state.Input().begin(), state.Input().end());
+
+            state.Measure([&data]()
+            {
+                Sorter::Sort(data);
+                Bench::DoNotOptimize(data.data());
+            });
+        });
+    }
+
+    // Baselines, so the numbers above have something to be compared to
+    struct StlSort
+    {
+        static void Sort(Container& A)
+        {
+            std::sort(A.begin(), A.end());
+        }
+    };
+
+    struct StlStableSort
+    {
+        static void Sort(Container& A)
+        {
+            std::stable_sort(A.begin(), A.end());
+        }
+    };
+
+    bool RegisterSorts()
+    {
+        RegisterSort<IncreasingBubbleSort<Container>>                                   ("BubbleSort", QUADRATIC_LIMIT);
+        RegisterSort<IncreasingInsertionSort<Container>>                                ("InsertionSort", QUADRATIC_LIMIT);
+        RegisterSort<IncreasingBinaryInsertionSort<Container>>                          ("BinaryInsertionSort", QUADRATIC_LIMIT);
+        RegisterSort<IncreasingSortingNetwork<Container>>                               ("SortingNetwork");
+        RegisterSort<IncreasingCountingSort<Container, COUNTING_RANGE>>                 ("CountingSort", COUNTING_RANGE);
+        RegisterSort<IncreasingQuickSort<Container>>                                    ("QuickSort");
+        RegisterSort<IncreasingIntroSort<Container>>                                    ("IntroSort");
+        RegisterSort<IncreasingMergeSort<Container>>                                    ("MergeSort");
+        RegisterSort<IncreasingHeapSort<Container, BinaryHeap>>                         ("HeapSort (BinaryHeap)");
+        RegisterSort<IncreasingHeapSort<Container, FibonacciHeap>>                      ("HeapSort (FibonacciHeap)");
+        RegisterSort<IncreasingHeapSort<Container, BinomialHeap>>                       ("HeapSort (BinomialHeap)");
+        RegisterSort<IncreasingHeapSort<Container, PairingHeap>>                        ("HeapSort (PairingHeap)");
+        RegisterSort<IncreasingSmartMergeSort<Container, IncreasingInsertionSort<Container>>>("SmartMergeSort (Insertion)");
+        RegisterSort<IncreasingSmartMergeSort<Container, IncreasingQuickSort<Container>>>("SmartMergeSort (Quick)");
+        RegisterSort<IncreasingTunedSmartMergeSort<Container>>                          ("SmartMergeSort (Tuned)");
+        RegisterSort<IncreasingSmartQuickSort<Container, IncreasingInsertionSort<Container>>>("SmartQuickSort (Insertion)");
+        RegisterSort<IncreasingTunedSmartQuickSort<Container>>                          ("SmartQuickSort (Tuned)");
+        RegisterSort<StlSort>                                                           ("std::sort");
+        RegisterSort<StlStableSort>                                                     ("std::stable_sort");
+
+        return true;
+    }
+
+    const bool s_registered = RegisterSorts();
+}
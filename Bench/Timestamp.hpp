@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Cheapest clock read the platform has, for timing single operations.  On x86 it's the time stamp counter, a
+    * couple dozen cycles with no call into the kernel or the vDSO, everywhere else it's CLOCK_MONOTONIC in
+    * nanoseconds.  Ticks only mean something relative to each other, NanosecondsPerTick turns them into time.
+    *
+    * rdtsc isn't serializing, so the read can drift a few instructions either side of the operation being timed.
+    * That's well inside the resolution the latency histograms keep.
+    ***************************************************************************************************************/
+    inline uint64_t ReadTimestamp()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+    }
+
+    /***************************************************************************************************************
+    * Measured once, the first time it's asked for, by running both clocks side by side for a few milliseconds.
+    * Assumes an invariant TSC, which everything x86 from the last fifteen years has.
+    ***************************************************************************************************************/
+    inline double NanosecondsPerTick()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        static const double s_ratio = []()
+        {
+            using Clock = std::chrono::steady_clock;
+
+            Clock::time_point start = Clock::now();
+            uint64_t first = ReadTimestamp();
+
+            Clock::time_point end;
+            do
+            {
+                end = Clock::now();
+            } while (end - start < std::chrono::milliseconds(10));
+
+            uint64_t last = ReadTimestamp();
+
+            return std::chrono::duration<double, std::nano>(end - start).count() / (double)(last - first);
+        }();
+
+        return s_ratio;
+#else
+        return 1.0;
+#endif
+    }
+}
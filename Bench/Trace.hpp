@@ -0,0 +1,409 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Binary heap operation trace.  A fixed header followed by count fixed size records, in native byte order, laid
+    * out so the file can be mapped and walked in place with no parsing at all.
+    *
+    * Every record names the element it acts on by a dense id in [0, ids), handed out by the Insert that created it,
+    * so a replay can find its node by indexing a plain array.  Keys are min heap priorities: Insert carries the
+    * priority, AugmentKey carries how much it drops by.
+    ***************************************************************************************************************/
+    enum class TraceOp : uint8_t
+    {
+        Insert,
+        ExtractTop,
+        Remove,
+        AugmentKey
+    };
+
+    struct TraceRecord
+    {
+        TraceOp op;
+        uint8_t reserved[3];
+        uint32_t id;
+        int32_t key;
+    };
+
+    static_assert(sizeof(TraceRecord) == 12, "TraceRecord is part of the file format");
+
+    // Every key stays at or after the last top and never goes negative, so the monotone integer heaps can run it
+    const uint32_t TRACE_MONOTONE = 1u << 0;
+
+    struct TraceHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t count;
+        uint32_t ids;
+        uint32_t reserved;
+
+        // Largest distance seen between the last top and a live key, the window a BucketQueue would need
+        uint64_t spread;
+    };
+
+    static_assert(sizeof(TraceHeader) == 40, "TraceHeader is part of the file format");
+
+    const char TRACE_MAGIC[8] = { 'H', 'E', 'A', 'P', 'T', 'R', 'C', '\0' };
+    const uint32_t TRACE_VERSION = 1;
+
+    /***************************************************************************************************************
+    * Builds a trace while simulating it on an ordered set, so every operation it takes is valid at the point it's
+    * made: no ExtractTop on an empty heap, and no Remove or AugmentKey of an element that's gone.  The simulation
+    * breaks ties between equal keys by id.  The flags and spread in the header come out of the same simulation.
+    ***************************************************************************************************************/
+    class TraceWriter
+    {
+    public:
+        TraceWriter() :
+            m_monotone(true),
+            m_spread(0),
+            m_last_top(0)
+        {
+        }
+
+        // Returns the id of the new element
+        uint32_t Insert(long long key)
+        {
+            CheckKey(key);
+
+            uint32_t id = (uint32_t)m_keys.size();
+            m_keys.push_back(key);
+            m_live.push_back(true);
+            m_queue.insert({ key, id });
+
+            Record(TraceOp::Insert, id, (int32_t)key);
+            return id;
+        }
+
+        // false when there's nothing to extract, otherwise id is the element that came out
+        bool ExtractTop(uint32_t& id)
+        {
+            if (m_queue.empty())
+            {
+                return false;
+            }
+
+            std::pair<long long, uint32_t> top = *m_queue.begin();
+            m_queue.erase(m_queue.begin());
+            m_live[top.second] = false;
+            m_last_top = top.first;
+            id = top.second;
+
+            Record(TraceOp::ExtractTop, top.second, 0);
+            return true;
+        }
+
+        bool ExtractTop()
+        {
+            uint32_t id;
+            return ExtractTop(id);
+        }
+
+        // false when id isn't in the queue
+        bool Remove(uint32_t id)
+        {
+            if (!Live(id))
+            {
+                return false;
+            }
+
+            m_queue.erase({ m_keys[id], id });
+            m_live[id] = false;
+
+            Record(TraceOp::Remove, id, 0);
+            return true;
+        }
+
+        // false when id isn't in the queue, or delta wouldn't lower its key
+        bool AugmentKey(uint32_t id, long long delta)
+        {
+            if (!Live(id) || delta <= 0 || delta > std::numeric_limits<int32_t>::max())
+            {
+                return false;
+            }
+
+            long long key = m_keys[id] - delta;
+            CheckKey(key);
+
+            m_queue.erase({ m_keys[id], id });
+            m_keys[id] = key;
+            m_queue.insert({ key, id });
+
+            Record(TraceOp::AugmentKey, id, (int32_t)delta);
+            return true;
+        }
+
+        bool Live(uint32_t id) const
+        {
+            return id < m_live.size() && m_live[id];
+        }
+
+        bool Empty() const
+        {
+            return m_queue.empty();
+        }
+
+        size_t Size() const
+        {
+            return m_queue.size();
+        }
+
+        // Smallest key in the queue, the simulation's notion of "now"
+        long long Top() const
+        {
+            return m_queue.empty() ? m_last_top : m_queue.begin()->first;
+        }
+
+        long long Key(uint32_t id) const
+        {
+            return m_keys[id];
+        }
+
+        size_t Count() const
+        {
+            return m_records.size();
+        }
+
+        /***********************************************************************************************************
+        *
+        *
+        ***********************************************************************************************************/
+        void Save(const std::string& path) const
+        {
+            TraceHeader header = {};
+            std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+            header.version = TRACE_VERSION;
+            header.flags = m_monotone ? TRACE_MONOTONE : 0;
+            header.count = m_records.size();
+            header.ids = (uint32_t)m_keys.size();
+            header.spread = m_spread;
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(m_records.data()), m_records.size() * sizeof(TraceRecord));
+
+            if (!out)
+            {
+                throw std::runtime_error("Couldn't write " + path);
+            }
+        }
+
+    private:
+        void CheckKey(long long key)
+        {
+            // Keys have to survive being packed into the high half of a 64 bit key next to the id
+            if (key < std::numeric_limits<int32_t>::min() || key > std::numeric_limits<int32_t>::max())
+            {
+                throw std::out_of_range("Trace key " + std::to_string(key) + " doesn't fit in 32 bits");
+            }
+
+            if (key < 0 || key < m_last_top)
+            {
+                m_monotone = false;
+            }
+            else if ((uint64_t)(key - m_last_top) > m_spread)
+            {
+                m_spread = (uint64_t)(key - m_last_top);
+            }
+        }
+
+        void Record(TraceOp op, uint32_t id, int32_t key)
+        {
+            TraceRecord record = {};
+            record.op = op;
+            record.id = id;
+            record.key = key;
+            m_records.push_back(record);
+        }
+
+        std::vector<TraceRecord> m_records;
+        std::vector<long long> m_keys;
+        std::vector<bool> m_live;
+        std::set<std::pair<long long, uint32_t>> m_queue;
+
+        bool m_monotone;
+        uint64_t m_spread;
+        long long m_last_top;
+    };
+
+    /***************************************************************************************************************
+    * A trace file mapped read only.  The records are used straight out of the mapping, so opening a trace costs
+    * the same whether it holds a thousand operations or a hundred million.
+    ***************************************************************************************************************/
+    class MappedTrace
+    {
+    public:
+        explicit MappedTrace(const std::string& path) :
+            m_data(nullptr),
+            m_size(0)
+        {
+            Map(path);
+
+            if (m_size < sizeof(TraceHeader))
+            {
+                Unmap();
+                throw std::runtime_error(path + " is too small to be a trace");
+            }
+
+            const TraceHeader& header = Header();
+            if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) || header.version != TRACE_VERSION)
+            {
+                Unmap();
+                throw std::runtime_error(path + " isn't a version " + std::to_string(TRACE_VERSION) + " trace");
+            }
+
+            if (header.count > (m_size - sizeof(TraceHeader)) / sizeof(TraceRecord))
+            {
+                Unmap();
+                throw std::runtime_error(path + " is truncated");
+            }
+        }
+
+        ~MappedTrace()
+        {
+            Unmap();
+        }
+
+        MappedTrace(const MappedTrace&) = delete;
+        MappedTrace& operator=(const MappedTrace&) = delete;
+
+        const TraceHeader& Header() const
+        {
+            return *reinterpret_cast<const TraceHeader*>(m_data);
+        }
+
+        const TraceRecord* begin() const
+        {
+            return reinterpret_cast<const TraceRecord*>(m_data + sizeof(TraceHeader));
+        }
+
+        const TraceRecord* end() const
+        {
+            return begin() + Header().count;
+        }
+
+        size_t Count() const
+        {
+            return (size_t)Header().count;
+        }
+
+        bool Monotone() const
+        {
+            return (Header().flags & TRACE_MONOTONE) != 0;
+        }
+
+    private:
+#ifdef _WIN32
+        void Map(const std::string& path)
+        {
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                throw std::runtime_error("Couldn't open " + path);
+            }
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+            {
+                CloseHandle(file);
+                throw std::runtime_error(path + " is too small to be a trace");
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping)
+            {
+                throw std::runtime_error("Couldn't map " + path);
+            }
+
+            // The view keeps the mapping alive on its own
+            m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+            if (!m_data)
+            {
+                throw std::runtime_error("Couldn't map " + path);
+            }
+
+            m_size = (size_t)size.QuadPart;
+        }
+
+        void Unmap()
+        {
+            if (m_data)
+            {
+                UnmapViewOfFile(m_data);
+                m_data = nullptr;
+            }
+        }
+#else
+        void Map(const std::string& path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                throw std::runtime_error("Couldn't open " + path);
+            }
+
+            struct stat info;
+            if (fstat(fd, &info) || !info.st_size)
+            {
+                close(fd);
+                throw std::runtime_error(path + " is too small to be a trace");
+            }
+
+            void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data == MAP_FAILED)
+            {
+                throw std::runtime_error("Couldn't map " + path);
+            }
+
+            // Replays walk front to back
+            madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+            m_data = static_cast<const char*>(data);
+            m_size = (size_t)info.st_size;
+        }
+
+        void Unmap()
+        {
+            if (m_data)
+            {
+                munmap(const_cast<char*>(m_data), m_size);
+                m_data = nullptr;
+            }
+        }
+#endif
+
+        const char* m_data;
+        size_t m_size;
+    };
+}
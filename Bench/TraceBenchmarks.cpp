@@ -0,0 +1,230 @@
+#include "Benchmark.hpp"
+
+#include "BucketQueue.hpp"
+#include "CalendarQueue.hpp"
+#include "FibonacciHeap.hpp"
+#include "PairingHeap.hpp"
+#include "RadixHeap.hpp"
+#include "RankPairingHeap.hpp"
+#include "TimerWheel.hpp"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace Datastructures::Heaps;
+
+namespace
+{
+    // Largest BucketQueue window worth allocating buckets for
+    const uint64_t MAX_BUCKET_SPREAD = 1ull << 24;
+
+    template<typename Heap, typename = void>
+    struct HasValue : std::false_type
+    {
+    };
+
+    template<typename Heap>
+    struct HasValue<Heap, std::void_t<typename Heap::VALUE_TYPE>> : std::true_type
+    {
+    };
+
+    /***************************************************************************************************************
+    * Key value heaps carry the trace id as their value.  The comparison heaps only have a key, so the id rides in
+    * its low 32 bits under the priority, which also breaks ties between equal priorities the same way the trace
+    * writer's simulation does.
+    ***************************************************************************************************************/
+    const long long ID_SHIFT = 1ll << 32;
+
+    template<typename Heap>
+    inline typename Heap::NODE_TYPE Insert(Heap& heap, int32_t key, uint32_t id)
+    {
+        if constexpr (HasValue<Heap>::value)
+        {
+            return heap.Insert(key, id);
+        }
+        else
+        {
+            return heap.Insert(key * ID_SHIFT + id);
+        }
+    }
+
+    template<typename Heap>
+    inline uint32_t Id(typename Heap::NODE_TYPE node)
+    {
+        if constexpr (HasValue<Heap>::value)
+        {
+            return (uint32_t)node->Value();
+        }
+        else
+        {
+            // Low half, whatever the sign of the priority above it
+            return (uint32_t)(node->Key() & 0xffffffffll);
+        }
+    }
+
+    template<typename Heap>
+    inline void Lower(Heap& heap, typename Heap::NODE_TYPE node, int32_t delta)
+    {
+        if constexpr (HasValue<Heap>::value)
+        {
+            heap.AugmentKey(node, node->Key() - delta);
+        }
+        else
+        {
+            heap.AugmentKey(node, node->Key() - delta * ID_SHIFT);
+        }
+    }
+
+    /***************************************************************************************************************
+    * Drives heap through every record, the whole of the replay is timed.  Nodes are found by id in a flat array.
+    * Ties can make a heap hand out a different element than the trace writer's simulation did.  The one the writer
+    * took has the same priority and is still in the heap, so it takes over the id of the one that came out.  That
+    * keeps the heap holding exactly what the simulation did, so every key stays inside the monotone window and spread
+    * the header promises.  When the run records latencies every operation is timed into the histogram for its op.
+    ***************************************************************************************************************/
+    template<typename Heap>
+    void Replay(Bench::State& state, const Bench::MappedTrace& trace, Heap& heap, bool delete_removed)
+    {
+        using NODE_TYPE = typename Heap::NODE_TYPE;
+
+        // Sized and zeroed up front so the replay itself never allocates for it.  stands_for is the trace id each
+        // node answers to, indexed by the id it was inserted with
+        std::vector<NODE_TYPE> nodes(trace.Header().ids, nullptr);
+        std::vector<uint32_t> stands_for(trace.Header().ids, 0);
+
+        Bench::Histogram* insert = state.Latency("Insert");
+        Bench::Histogram* extract = state.Latency("ExtractTop");
+        Bench::Histogram* remove = state.Latency("Remove");
+        Bench::Histogram* augment = state.Latency("AugmentKey");
+
+        state.Measure([&]()
+        {
+            for (const Bench::TraceRecord& record : trace)
+            {
+                switch (record.op)
+                {
+                case Bench::TraceOp::Insert:
+                    state.Time(insert, [&]() { nodes[record.id] = Insert(heap, record.key, record.id); });
+                    stands_for[record.id] = record.id;
+                    break;
+
+                case Bench::TraceOp::ExtractTop:
+                {
+                    NODE_TYPE top = nullptr;
+                    state.Time(extract, [&]() { top = heap.ExtractTop(); });
+
+                    uint32_t taken = stands_for[Id<Heap>(top)];
+                    if (taken != record.id)
+                    {
+                        NODE_TYPE twin = nodes[record.id];
+                        nodes[taken] = twin;
+                        stands_for[Id<Heap>(twin)] = taken;
+                    }
+
+                    nodes[record.id] = nullptr;
+                    delete top;
+                    break;
+                }
+
+                case Bench::TraceOp::Remove:
+                {
+                    NODE_TYPE node = nodes[record.id];
+                    if (node)
+                    {
+                        state.Time(remove, [&]() { heap.Remove(node); });
+                        nodes[record.id] = nullptr;
+
+                        if (delete_removed)
+                        {
+                            delete node;
+                        }
+                    }
+                    break;
+                }
+
+                case Bench::TraceOp::AugmentKey:
+                {
+                    NODE_TYPE node = nodes[record.id];
+                    if (node)
+                    {
+                        state.Time(augment, [&]() { Lower(heap, node, record.key); });
+                    }
+                    break;
+                }
+                }
+            }
+        });
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    template<typename Heap>
+    void RegisterReplay(
+        const std::string& name,
+        std::function<bool(const Bench::MappedTrace&)> accepts,
+        std::function<std::unique_ptr<Heap>(const Bench::MappedTrace&)> make,
+        bool delete_removed = true
+    )
+    {
+        Bench::RegisterTrace("heap", name, accepts, [make, delete_removed](Bench::State& state, const Bench::MappedTrace& trace)
+        {
+            std::unique_ptr<Heap> heap = make(trace);
+            Replay(state, trace, *heap, delete_removed);
+        });
+    }
+
+    template<typename Heap>
+    std::unique_ptr<Heap> Make(const Bench::MappedTrace&)
+    {
+        return std::unique_ptr<Heap>(new Heap());
+    }
+
+    bool Any(const Bench::MappedTrace&)
+    {
+        return true;
+    }
+
+    bool Monotone(const Bench::MappedTrace& trace)
+    {
+        return trace.Monotone();
+    }
+
+    // BinaryHeap and MultiQueue hand out positions that move, not nodes, so a trace can't name their elements.
+    // BinomialHeap has neither Remove nor AugmentKey.
+    bool RegisterReplays()
+    {
+        using Key = long long;
+
+        RegisterReplay<MinFibonacciHeap<Key>>           ("FibonacciHeap",           Any, Make<MinFibonacciHeap<Key>>);
+        RegisterReplay<MinPairingHeap<Key>>             ("PairingHeap",             Any, Make<MinPairingHeap<Key>>);
+        RegisterReplay<MinMultipassPairingHeap<Key>>    ("MultipassPairingHeap",    Any, Make<MinMultipassPairingHeap<Key>>);
+        RegisterReplay<MinLazyPairingHeap<Key>>         ("LazyPairingHeap",         Any, Make<MinLazyPairingHeap<Key>>);
+        RegisterReplay<MinRankPairingHeapT1<Key>>       ("RankPairingHeapT1",       Any, Make<MinRankPairingHeapT1<Key>>);
+        RegisterReplay<MinRankPairingHeapT2<Key>>       ("RankPairingHeapT2",       Any, Make<MinRankPairingHeapT2<Key>>);
+        RegisterReplay<CalendarQueue<Key, uint32_t>>    ("CalendarQueue",           Any, Make<CalendarQueue<Key, uint32_t>>);
+        RegisterReplay<RadixHeap<Key, uint32_t>>        ("RadixHeap",               Monotone, Make<RadixHeap<Key, uint32_t>>);
+        RegisterReplay<TimerWheel<Key, uint32_t>>       ("TimerWheel",              Monotone, Make<TimerWheel<Key, uint32_t>>);
+
+        // Lazy removal leaves freeing the node to the heap
+        RegisterReplay<MinFibonacciHeap<Key>>("LazyFibonacciHeap", Any, [](const Bench::MappedTrace&)
+        {
+            return std::unique_ptr<MinFibonacciHeap<Key>>(new MinFibonacciHeap<Key>(true));
+        }, false);
+
+        RegisterReplay<BucketQueue<Key, uint32_t>>("BucketQueue", [](const Bench::MappedTrace& trace)
+        {
+            return trace.Monotone() && trace.Header().spread <= MAX_BUCKET_SPREAD;
+        }, [](const Bench::MappedTrace& trace)
+        {
+            return std::unique_ptr<BucketQueue<Key, uint32_t>>(new BucketQueue<Key, uint32_t>((size_t)trace.Header().spread));
+        });
+
+        return true;
+    }
+
+    const bool s_registered = RegisterReplays();
+}
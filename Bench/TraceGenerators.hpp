@@ -0,0 +1,259 @@
+#pragma once
+
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Bench
+{
+    /***************************************************************************************************************
+    * Reads the text format Test/main.cpp writes to HeapDriver.in, one operation per line:
+    *
+    *     Insert:key,value      key names the element, value is its priority
+    *     ExtractTop:
+    *     Remove:key
+    *     AugmentKey:key,value  value is how much the priority improves by
+    *
+    * Keys are mapped to fresh trace ids at every Insert, and operations the simulation says can't happen, e.g.
+    * removing an element that was already extracted, are dropped.
+    ***************************************************************************************************************/
+    inline TraceWriter ConvertText(std::istream& in)
+    {
+        TraceWriter writer;
+        std::unordered_map<long long, uint32_t> ids;
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos)
+            {
+                continue;
+            }
+
+            std::string action = line.substr(0, colon);
+            const char* args = line.c_str() + colon + 1;
+
+            char* next = nullptr;
+            long long key = std::strtoll(args, &next, 10);
+            long long value = (*next == ',') ? std::strtoll(next + 1, nullptr, 10) : 0;
+
+            if (action == "Insert")
+            {
+                ids[key] = writer.Insert(value);
+            }
+            else if (action == "ExtractTop")
+            {
+                writer.ExtractTop();
+            }
+            else if (action == "Remove")
+            {
+                auto it = ids.find(key);
+                if (it != ids.end())
+                {
+                    writer.Remove(it->second);
+                }
+            }
+            else if (action == "AugmentKey")
+            {
+                auto it = ids.find(key);
+                if (it != ids.end())
+                {
+                    writer.AugmentKey(it->second, value);
+                }
+            }
+        }
+
+        return writer;
+    }
+
+    /***************************************************************************************************************
+    * Ids of the elements still queued, with O(1) add, remove and uniform pick, for the generators that cancel
+    *
+    ***************************************************************************************************************/
+    class LiveIds
+    {
+    public:
+        void Add(uint32_t id)
+        {
+            if (id >= m_position.size())
+            {
+                m_position.resize((size_t)id + 1);
+            }
+
+            m_position[id] = (uint32_t)m_ids.size();
+            m_ids.push_back(id);
+        }
+
+        void Remove(uint32_t id)
+        {
+            uint32_t position = m_position[id];
+            m_ids[position] = m_ids.back();
+            m_position[m_ids[position]] = position;
+            m_ids.pop_back();
+        }
+
+        template<typename Rng>
+        uint32_t Pick(Rng& rng) const
+        {
+            return m_ids[std::uniform_int_distribution<size_t>(0, m_ids.size() - 1)(rng)];
+        }
+
+        bool Empty() const
+        {
+            return m_ids.empty();
+        }
+
+    private:
+        std::vector<uint32_t> m_ids;
+        std::vector<uint32_t> m_position;
+    };
+
+    /***************************************************************************************************************
+    * Dijkstra on a random directed graph with the given out degree and edge weights in [1, 100].  Every vertex is
+    * inserted the first time it's reached and has its key lowered on every shorter path found after that, which is
+    * the decrease key heavy pattern Fibonacci and pairing heaps are sold on.  Keys never drop below the last top.
+    ***************************************************************************************************************/
+    inline TraceWriter GenerateDijkstra(uint32_t vertices, uint32_t degree, unsigned int seed)
+    {
+        TraceWriter writer;
+        if (!vertices)
+        {
+            return writer;
+        }
+
+        std::uniform_int_distribution<uint32_t> pick(0, vertices - 1);
+        std::uniform_int_distribution<int> weight(1, 100);
+
+        const uint32_t UNSEEN = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> id_of(vertices, UNSEEN);
+        std::vector<uint32_t> vertex_of;
+        std::vector<bool> done(vertices, false);
+
+        id_of[0] = writer.Insert(0);
+        vertex_of.push_back(0);
+
+        uint32_t id;
+        while (writer.ExtractTop(id))
+        {
+            uint32_t u = vertex_of[id];
+            long long distance = writer.Key(id);
+            done[u] = true;
+
+            // Edges come from a per vertex seed, so the graph never has to be held in memory
+            std::mt19937 edges(seed ^ (u * 2654435761u));
+            for (uint32_t e = 0; e < degree; ++e)
+            {
+                uint32_t v = pick(edges);
+                long long candidate = distance + weight(edges);
+
+                if (done[v])
+                {
+                    continue;
+                }
+
+                if (id_of[v] == UNSEEN)
+                {
+                    id_of[v] = writer.Insert(candidate);
+                    vertex_of.push_back(v);
+                }
+                else if (candidate < writer.Key(id_of[v]))
+                {
+                    writer.AugmentKey(id_of[v], writer.Key(id_of[v]) - candidate);
+                }
+            }
+        }
+
+        return writer;
+    }
+
+    /***************************************************************************************************************
+    * Discrete event simulation, the hold model with cancellations.  Around pending events stay queued.  Each step
+    * takes the next one and schedules one to follow it an exponential delay later, and one step in ten also
+    * schedules an extra event and cancels a random pending one.
+    ***************************************************************************************************************/
+    inline TraceWriter GenerateEvents(size_t operations, size_t pending, unsigned int seed)
+    {
+        TraceWriter writer;
+        LiveIds live;
+
+        std::mt19937 rng(seed);
+        std::exponential_distribution<double> delay(1.0 / 100.0);
+        std::uniform_int_distribution<int> percent(0, 99);
+
+        auto schedule = [&](long long now)
+        {
+            live.Add(writer.Insert(now + 1 + (long long)delay(rng)));
+        };
+
+        for (size_t i = 0; i < pending; ++i)
+        {
+            schedule(0);
+        }
+
+        uint32_t id;
+        while (writer.Count() < operations && writer.ExtractTop(id))
+        {
+            live.Remove(id);
+
+            long long now = writer.Key(id);
+            schedule(now);
+
+            if (percent(rng) < 10)
+            {
+                schedule(now);
+
+                uint32_t cancelled = live.Pick(rng);
+                writer.Remove(cancelled);
+                live.Remove(cancelled);
+            }
+        }
+
+        return writer;
+    }
+
+    /***************************************************************************************************************
+    * Timer churn, the way network stacks use timers: one timer armed per tick with a timeout well past how long it
+    * usually lives, most of them cancelled before they go off once more than timers are armed, and whatever is due
+    * fired at the end of every tick.
+    ***************************************************************************************************************/
+    inline TraceWriter GenerateTimers(size_t operations, size_t timers, unsigned int seed)
+    {
+        TraceWriter writer;
+        LiveIds live;
+
+        timers = std::max<size_t>(timers, 1);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<long long> timeout((long long)timers, 4 * (long long)timers);
+
+        long long now = 0;
+        while (writer.Count() < operations)
+        {
+            live.Add(writer.Insert(now + timeout(rng)));
+
+            if (writer.Size() > timers)
+            {
+                uint32_t cancelled = live.Pick(rng);
+                writer.Remove(cancelled);
+                live.Remove(cancelled);
+            }
+
+            uint32_t id;
+            while (!writer.Empty() && writer.Top() <= now && writer.ExtractTop(id))
+            {
+                live.Remove(id);
+            }
+
+            ++now;
+        }
+
+        return writer;
+    }
+}
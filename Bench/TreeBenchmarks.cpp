@@ -0,0 +1,172 @@
+#include "Benchmark.hpp"
+
+#include "AVLTree.hpp"
+#include "BTree.hpp"
+#include "BinarySearchTree.hpp"
+#include "ConcurrentAVLTree.hpp"
+#include "FrozenTree.hpp"
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+
+using namespace Datastructures::Trees;
+
+namespace
+{
+    using StlMultiset = std::multiset<int>;
+
+    template<typename Tree>
+    inline void Add(Tree& tree, int key)
+    {
+        tree.Insert(key);
+    }
+
+    inline void Add(StlMultiset& tree, int key)
+    {
+        tree.insert(key);
+    }
+
+    template<typename Tree>
+    inline bool Has(const Tree& tree, int key)
+    {
+        return tree.Contains(key);
+    }
+
+    inline bool Has(const StlMultiset& tree, int key)
+    {
+        return tree.find(key) != tree.end();
+    }
+
+    template<typename Tree>
+    inline void Erase(Tree& tree, int key)
+    {
+        tree.Remove(key);
+    }
+
+    // One copy at a time, the way the counted trees drop one
+    inline void Erase(StlMultiset& tree, int key)
+    {
+        StlMultiset::iterator it = tree.find(key);
+        if (it != tree.end())
+        {
+            tree.erase(it);
+        }
+    }
+
+    /***************************************************************************************************************
+    * Three workloads per tree.  Insert adds the whole input, Find prefills with it untimed and looks every key back
+    * up, and Remove prefills the same way and takes every key out again.  Every operation is timed on its own too
+    * when the run records latencies, which is where a rebalance or a node split shows up.
+    ***************************************************************************************************************/
+    template<typename Tree>
+    void RegisterTree(const std::string& name, size_t max_size)
+    {
+        Bench::Register("tree", name, "Insert", max_size, [](Bench::State& state)
+        {
+            std::unique_ptr<Tree> tree(new Tree());
+            Bench::Histogram* insert = state.Latency("Insert");
+
+            state.Measure([&]()
+            {
+                for (int key : state.Input())
+                {
+                    state.Time(insert, [&]() { Add(*tree, key); });
+                }
+            });
+        });
+
+        Bench::Register("tree", name, "Find", max_size, [](Bench::State& state)
+        {
+            std::unique_ptr<Tree> tree(new Tree());
+            for (int key : state.Input())
+            {
+                Add(*tree, key);
+            }
+
+            Bench::Histogram* find = state.Latency("Find");
+
+            state.Measure([&]()
+            {
+                size_t found = 0;
+                for (int key : state.Input())
+                {
+                    state.Time(find, [&]() { found += Has(*tree, key); });
+                }
+
+                Bench::DoNotOptimize(found);
+            });
+        });
+
+        Bench::Register("tree", name, "Remove", max_size, [](Bench::State& state)
+        {
+            std::unique_ptr<Tree> tree(new Tree());
+            for (int key : state.Input())
+            {
+                Add(*tree, key);
+            }
+
+            Bench::Histogram* remove = state.Latency("Remove");
+
+            state.Measure([&]()
+            {
+                for (int key : state.Input())
+                {
+                    state.Time(remove, [&]() { Erase(*tree, key); });
+                }
+            });
+        });
+    }
+
+    /***************************************************************************************************************
+    * A FrozenTree can only be searched, so it only gets Find, packed from an AVLTree of the input untimed
+    *
+    ***************************************************************************************************************/
+    void RegisterFrozenTree()
+    {
+        const size_t unlimited = std::numeric_limits<size_t>::max();
+
+        Bench::Register("tree", "FrozenTree", "Find", unlimited, [](Bench::State& state)
+        {
+            AVLTree<int> source;
+            for (int key : state.Input())
+            {
+                source.Insert(key);
+            }
+
+            FrozenTree<int> frozen(source);
+            Bench::Histogram* find = state.Latency("Find");
+
+            state.Measure([&]()
+            {
+                size_t found = 0;
+                for (int key : state.Input())
+                {
+                    state.Time(find, [&]() { found += frozen.Contains(key); });
+                }
+
+                Bench::DoNotOptimize(found);
+            });
+        });
+    }
+
+    bool RegisterTrees()
+    {
+        const size_t unlimited = std::numeric_limits<size_t>::max();
+
+        // Sorted input turns an unbalanced tree into a list
+        RegisterTree<BinarySearchTree<int>>     ("BinarySearchTree",    1 << 14);
+        RegisterTree<AVLTree<int>>              ("AVLTree",             unlimited);
+        RegisterTree<ConcurrentAVLTree<int>>    ("ConcurrentAVLTree",   unlimited);
+        RegisterTree<BTree<int>>                ("BTree",               unlimited);
+        RegisterTree<StlMultiset>               ("std::multiset",       unlimited);
+
+        RegisterFrozenTree();
+
+        return true;
+    }
+
+    const bool s_registered = RegisterTrees();
+}
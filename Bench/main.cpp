@@ -0,0 +1,322 @@
+#include "Benchmark.hpp"
+#include "Calibration.hpp"
+#include "Reporters.hpp"
+#include "TraceGenerators.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout
+            << "Usage: Bench [options]\n"
+            << "  --reps N               timed repetitions per benchmark (default 10)\n"
+            << "  --warmup N             untimed repetitions before those (default 2)\n"
+            << "  --sizes a,b,...        input sizes (default 1024,16384,131072)\n"
+            << "  --distributions x,...  random, sorted, reversed, sawtooth, few_unique, organ_pipe (default all)\n"
+            << "  --filter text          only run benchmarks whose suite/name/workload contain text\n"
+            << "  --seed N               seed for the generators\n"
+            << "  --json path            write every result to path as JSON\n"
+            << "  --csv path             write every result to path as CSV\n"
+            << "  --counters             count cycles, instructions, branch and cache misses too (Linux)\n"
+            << "  --latency              time every operation too, and report p50/p99/p99.9/max per operation type\n"
+            << "  --trace path           replay a heap trace instead of running on generated input, repeatable\n"
+            << "  --isa name             scalar, avx2 or avx512 kernels for the sorts and searches (default the best available)\n"
+            << "  --list                 print the registered benchmarks and exit\n"
+            << "\n"
+            << "Usage: Bench --convert HeapDriver.in out.trace\n"
+            << "       Bench --generate dijkstra|events|timers operations out.trace [--seed N]\n"
+            << "       Bench --tune-sorts SortTuning.hpp\n";
+    }
+
+    // Trace name for the reports, the file name without its directory or extension
+    std::string TraceName(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+        size_t dot = name.rfind('.');
+        return (dot == std::string::npos || !dot) ? name : name.substr(0, dot);
+    }
+
+    /***************************************************************************************************************
+    * Sizes the generators so a trace comes out at about operations records
+    *
+    ***************************************************************************************************************/
+    Bench::TraceWriter GenerateTrace(const std::string& kind, size_t operations, unsigned int seed)
+    {
+        if (kind == "dijkstra")
+        {
+            // Every vertex is inserted and extracted once, and about a quarter of the other edges lower a key
+            const uint32_t degree = 8;
+            return Bench::GenerateDijkstra((uint32_t)std::max<size_t>(operations / 4, 1), degree, seed);
+        }
+
+        if (kind == "events")
+        {
+            return Bench::GenerateEvents(operations, std::max<size_t>(operations / 100, 1), seed);
+        }
+
+        if (kind == "timers")
+        {
+            return Bench::GenerateTimers(operations, std::max<size_t>(operations / 100, 1), seed);
+        }
+
+        throw std::invalid_argument("Unknown trace kind " + kind);
+    }
+
+    std::vector<std::string> SplitList(const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Bench::Config config;
+    std::string json_path;
+    std::string csv_path;
+    std::vector<std::string> trace_paths;
+
+    try
+    {
+        // Trace tools, these do their job and exit
+        if (argc == 4 && std::string(argv[1]) == "--convert")
+        {
+            std::ifstream in(argv[2]);
+            if (!in)
+            {
+                std::cerr << "Couldn't open " << argv[2] << '\n';
+                return 1;
+            }
+
+            Bench::TraceWriter writer = Bench::ConvertText(in);
+            writer.Save(argv[3]);
+            std::cout << "Wrote " << writer.Count() << " operations to " << argv[3] << '\n';
+            return 0;
+        }
+
+        if ((argc == 5 || argc == 7) && std::string(argv[1]) == "--generate")
+        {
+            unsigned int seed = config.seed;
+            if (argc == 7 && std::string(argv[5]) == "--seed")
+            {
+                seed = (unsigned int)std::strtoul(argv[6], nullptr, 10);
+            }
+
+            Bench::TraceWriter writer = GenerateTrace(argv[2], std::strtoull(argv[3], nullptr, 10), seed);
+            writer.Save(argv[4]);
+            std::cout << "Wrote " << writer.Count() << " operations to " << argv[4] << '\n';
+            return 0;
+        }
+
+        // Calibrates the hybrid sorts on this machine and writes a replacement for Algorithms/sort/SortTuning.hpp
+        if (argc == 3 && std::string(argv[1]) == "--tune-sorts")
+        {
+            std::ofstream out(argv[2]);
+            if (!out)
+            {
+                std::cerr << "Couldn't open " << argv[2] << '\n';
+                return 1;
+            }
+
+            Bench::TuningResult result = Bench::TuneSorts(config, std::cout);
+            Bench::WriteTuningHeader(out, Bench::CurrentContext(), result);
+
+            std::cout << "SmartMergeSort: " << result.merge.sorter << " up to " << result.merge.threshold << '\n'
+                      << "SmartQuickSort: " << result.quick.sorter << " up to " << result.quick.threshold << '\n'
+                      << "Wrote " << argv[2] << '\n';
+            return 0;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        if (arg == "--list")
+        {
+            for (const Bench::Benchmark& benchmark : Bench::Registry())
+            {
+                std::cout << benchmark.suite << '/' << benchmark.name << '/' << benchmark.workload << '\n';
+            }
+            return 0;
+        }
+
+        if (arg == "--counters")
+        {
+            config.counters = true;
+            continue;
+        }
+
+        if (arg == "--latency")
+        {
+            config.latency = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n\n";
+            PrintUsage();
+            return 1;
+        }
+
+        std::string value = argv[++i];
+
+        if (arg == "--reps")
+        {
+            config.repetitions = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--warmup")
+        {
+            config.warmup = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--sizes")
+        {
+            config.sizes.clear();
+            for (const std::string& size : SplitList(value))
+            {
+                config.sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+        }
+        else if (arg == "--distributions")
+        {
+            config.distributions.clear();
+            for (const std::string& name : SplitList(value))
+            {
+                Bench::Distribution distribution;
+                if (!Bench::FromString(name, distribution))
+                {
+                    std::cerr << "Unknown distribution " << name << '\n';
+                    return 1;
+                }
+                config.distributions.push_back(distribution);
+            }
+        }
+        else if (arg == "--filter")
+        {
+            config.filter = value;
+        }
+        else if (arg == "--seed")
+        {
+            config.seed = (unsigned int)std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--trace")
+        {
+            trace_paths.push_back(value);
+        }
+        else if (arg == "--isa")
+        {
+            Algorithms::Simd::Isa isa = Algorithms::Simd::ForceIsa(Algorithms::Simd::ParseIsa(value.c_str()));
+            if (value != Algorithms::Simd::IsaName(isa))
+            {
+                std::cerr << "Can't run " << value << " here, using " << Algorithms::Simd::IsaName(isa) << '\n';
+            }
+        }
+        else if (arg == "--json")
+        {
+            json_path = value;
+        }
+        else if (arg == "--csv")
+        {
+            csv_path = value;
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << "\n\n";
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (config.counters && !Bench::PerfCounters().Available())
+    {
+        std::cerr << "No hardware counters available (not Linux, or perf_event_paranoid too high), timing only\n";
+    }
+
+    auto report = [](const Bench::Result& result)
+    {
+        Bench::WriteConsole(std::cout, result);
+    };
+
+    // Whatever else finished still gets written out, but the exit code says something didn't
+    bool any_failed = false;
+    auto failed = [&any_failed](const std::string& benchmark, const std::exception& e)
+    {
+        std::cerr << benchmark << " failed: " << e.what() << '\n';
+        any_failed = true;
+    };
+
+    std::vector<Bench::Result> results;
+
+    if (trace_paths.empty())
+    {
+        results = Bench::Run(config, report, failed);
+    }
+    else
+    {
+        std::vector<std::unique_ptr<Bench::MappedTrace>> mapped;
+        std::vector<std::pair<std::string, const Bench::MappedTrace*>> traces;
+
+        try
+        {
+            for (const std::string& path : trace_paths)
+            {
+                mapped.emplace_back(new Bench::MappedTrace(path));
+                traces.emplace_back(TraceName(path), mapped.back().get());
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+
+        results = Bench::RunTraces(config, traces, report, failed);
+    }
+
+    if (!json_path.empty())
+    {
+        std::ofstream out(json_path);
+        Bench::WriteJson(out, Bench::CurrentContext(), results);
+    }
+
+    if (!csv_path.empty())
+    {
+        std::ofstream out(csv_path);
+        Bench::WriteCsv(out, results);
+    }
+
+    return any_failed ? 1 : 0;
+}
@@ -1,3 +1,3 @@
-#include "heaps/FibonacciHeap.hpp"
-#include "heaps/PairingHeap.hpp"
+#include "heaps/FibonacciHeap.hpp"
+#include "heaps/PairingHeap.hpp"
 #include "heaps/BinaryHeap.hpp"
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Datastructures {
+
+    /***************************************************************************************************************
+    * Snapshot of the memory one structure holds, in bytes.  Live counts everything the structure is responsible
+    * for right now: its nodes, pools and buffers, spare capacity included.  Used is the part of that actually
+    * holding elements, the rest is slack and memory that can't be given back yet, e.g. a pool block whose nodes
+    * have mostly been extracted.
+    ***************************************************************************************************************/
+    struct MemoryUsage
+    {
+        size_t live_bytes = 0;
+        size_t used_bytes = 0;
+
+        // Largest live_bytes has been over the structure's lifetime
+        size_t peak_bytes = 0;
+
+        // Calls the structure made to the allocator itself.  Nodes handed back to the caller are the caller's to free
+        size_t allocations = 0;
+        size_t frees = 0;
+
+        size_t elements = 0;
+
+        // Share of the live bytes not holding an element
+        double Fragmentation() const
+        {
+            return live_bytes ? 1.0 - (double)used_bytes / (double)live_bytes : 0.0;
+        }
+
+        double BytesPerElement() const
+        {
+            return elements ? (double)live_bytes / (double)elements : 0.0;
+        }
+    };
+
+    /***************************************************************************************************************
+    * Called with the signed change in live bytes every time any structure's live bytes change, on the thread that
+    * changed them.  Null by default, set it to see every structure in the process at once, e.g. to add
+    * them all up.
+    ***************************************************************************************************************/
+    using AllocationHook = void (*)(const void* structure, long long bytes);
+
+    inline AllocationHook& GlobalAllocationHook()
+    {
+        static AllocationHook s_hook = nullptr;
+        return s_hook;
+    }
+
+    /***************************************************************************************************************
+    * The bookkeeping behind MemoryStats().  Every structure keeps one and tells it about the memory it takes on and
+    * gives up, the structure only has to work out how much of its live memory is in use when asked.  A handful of
+    * adds per allocation, next to the allocation itself they're noise.
+    *
+    * Allocated and Freed are calls the structure makes to the allocator.  Adopted and Disowned are nodes changing
+    * hands without one, e.g. the node ExtractTop returns, which the caller deletes.  Memory inside the structure
+    * object itself, e.g. a fixed array member, isn't counted at all.
+    ***************************************************************************************************************/
+    class MemoryTracker
+    {
+    public:
+        MemoryTracker() :
+            m_live(0),
+            m_peak(0),
+            m_allocations(0),
+            m_frees(0)
+        {
+        }
+
+        // calls is how many allocations bytes was spread over, e.g. a whole subtree deleted in one go
+        inline void Allocated(size_t bytes, size_t calls = 1)
+        {
+            m_allocations += calls;
+            Adopted(bytes);
+        }
+
+        inline void Freed(size_t bytes, size_t calls = 1)
+        {
+            m_frees += calls;
+            Disowned(bytes);
+        }
+
+        inline void Adopted(size_t bytes)
+        {
+            m_live += bytes;
+
+            if (m_live > m_peak)
+            {
+                m_peak = m_live;
+            }
+
+            if (GlobalAllocationHook())
+            {
+                GlobalAllocationHook()(this, (long long)bytes);
+            }
+        }
+
+        inline void Disowned(size_t bytes)
+        {
+            m_live -= bytes;
+
+            if (GlobalAllocationHook())
+            {
+                GlobalAllocationHook()(this, -(long long)bytes);
+            }
+        }
+
+        // A buffer moved from old_bytes to new_bytes, e.g. a vector growing
+        inline void Reallocated(size_t old_bytes, size_t new_bytes)
+        {
+            if (new_bytes != old_bytes)
+            {
+                Allocated(new_bytes);
+                if (old_bytes)
+                {
+                    Freed(old_bytes);
+                }
+            }
+        }
+
+        /***********************************************************************************************************
+        * Takes over the live bytes tracker holds when one structure is merged into another, all but keep bytes of
+        * buffers that stay behind with it.  The allocation counts stay where they happened.
+        ***********************************************************************************************************/
+        void Steal(MemoryTracker& tracker, size_t keep = 0)
+        {
+            if (this == &tracker)
+            {
+                return;
+            }
+
+            m_live += tracker.m_live - keep;
+            tracker.m_live = keep;
+
+            if (m_live > m_peak)
+            {
+                m_peak = m_live;
+            }
+        }
+
+        size_t Live() const
+        {
+            return m_live;
+        }
+
+        MemoryUsage Usage(size_t used_bytes, size_t elements) const
+        {
+            MemoryUsage stats;
+            stats.live_bytes = m_live;
+            stats.used_bytes = used_bytes;
+            stats.peak_bytes = m_peak;
+            stats.allocations = m_allocations;
+            stats.frees = m_frees;
+            stats.elements = elements;
+            return stats;
+        }
+
+    private:
+        size_t m_live;
+        size_t m_peak;
+        size_t m_allocations;
+        size_t m_frees;
+    };
+}
@@ -1,335 +1,463 @@
-#pragma once
-
-#include "Heap.hpp"
-#include <vector>
-
-namespace Datastructures {
-namespace Heaps {
-
-    /***************************************************************************************************************
-    *
-    *
-    ***************************************************************************************************************/
-    static inline size_t PARENT(size_t i)
-    {
-        // Offset for 0 index
-        return (i - 1) >> 1;
-    }
-
-    /***************************************************************************************************************
-    *
-    *
-    ***************************************************************************************************************/
-    static inline size_t LEFT(size_t i)
-    {
-        // Offset for 0 index
-        return (i << 1) + 1;
-    }
-
-    /***************************************************************************************************************
-    *
-    *
-    ***************************************************************************************************************/
-    static inline size_t RIGHT(size_t i)
-    {
-        return LEFT(i) + 1;
-    }
-
-    template <
-        typename T,
-        template<typename> class Compare
-    >
-    class BinaryHeap {
-    public:
-
-        // Helpful using clause for external users
-        using NODE_TYPE = T;
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinaryHeap()
-        {
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinaryHeap(const std::vector<T>& data) :
-            m_storage(data),
-            m_bypass_aug_key_exception(false)
-        {
-            ConstructorBodyInit();
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinaryHeap(std::vector<T>&& data) :
-            m_storage(data),
-            m_bypass_aug_key_exception(false)
-        {
-            ConstructorBodyInit();
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        bool Empty() const 
-        { 
-            return !m_storage.size();
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        unsigned int Count() const
-        {
-            return m_storage.size();
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        const T& Top()
-        {
-            return m_storage[0];
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        T ExtractTop()
-        {
-            if (!m_storage.size())
-            {
-                throw Exceptions::UnderflowException();
-            }
-
-            // Get the top item
-            T top = m_storage[0];
-
-            // Bring the last item to the front
-            m_storage[0] = m_storage.back();
-
-            // Remove the end element
-            m_storage.pop_back();
-
-            // BinaryHeapify
-            BubbleDown(0);
-
-            return top;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void DeltaKey(size_t i, const T& val)
-        {
-            AugmentKey(i, m_storage[i] + val);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void AugmentKey(size_t i, const T& val)
-        {
-            // Beyond our BinaryHeapsize
-            if (i >= m_storage.size())
-            {
-                throw Exceptions::InvalidIndexException(i);
-            } 
-
-            // No thanks
-            if (!m_bypass_aug_key_exception && !m_heap_property(val, m_storage[i]))
-            {
-                throw Exceptions::InvalidKeyException<T>(val);
-            }
-
-            // reset bypass
-            m_bypass_aug_key_exception = false;
-
-            // Change the value
-            m_storage[i] = val;
-
-            // Bubble up
-            BubbleUp(i);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        size_t Insert(const T& val)
-        {
-            m_storage.push_back(val);
-            m_bypass_aug_key_exception = true;
-            AugmentKey(m_storage.size()-1, val);
-
-            // Give back the index
-            return m_storage.size() - 1;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void Remove(size_t i)
-        {
-            if (i >= m_storage.size())
-            {
-                throw Exceptions::InvalidIndexException(i);
-            }
-
-            // Trap when user calls remove on index 0
-            if (i == 0)
-            {
-                ExtractTop();
-                return;
-            }
-            
-            // Replace element to be removed with back, and pop back
-            m_storage[i] = m_storage.back();
-            m_storage.pop_back();
-
-            // We removed the back, just ignore
-            if (i == m_storage.size()) { return; }
-            // We don't have to do anything for empty BinaryHeaps or BinaryHeaps of size 1
-            if (m_storage.size() < 2) { return; }
-
-            // now, bubble it up or bubble it down
-            if (m_heap_property(m_storage[i], m_storage[PARENT(i)]))
-            {
-                BubbleUp(i);
-            }
-            else
-            {
-                BubbleDown(i);
-            }
-        }
-
-    protected:
-    private:
-        
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void ConstructorBodyInit()
-        {
-            // size_t is unsigned, so cant check below 0.  Start 1 above the bound, so that way --i places us at
-            // n/2 -> 0, and the while (i>0) check will fail on i == 0, but we would have already BinaryHeapified 0
-            size_t i = (m_storage.size() / 2);
-            do
-            {
-                --i;
-                BubbleDown(i);
-            } while (i > 0);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        size_t GetTarget(size_t i)
-        {
-            size_t target   = i;
-            size_t left     = LEFT(i);
-            size_t right    = RIGHT(i);
-
-            size_t heap_size = m_storage.size();
-
-            if (left < heap_size && m_heap_property(m_storage[target], m_storage[left]))
-            {
-                target = left;
-            }
-            if (right < heap_size && m_heap_property(m_storage[target], m_storage[right]))
-            {
-                target = right;
-            }
-
-            return target;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void BubbleUp(size_t i)
-        {
-            while ((i != 0) && m_heap_property(m_storage[i], m_storage[PARENT(i)]))
-            {
-                std::swap(m_storage[i], m_storage[PARENT(i)]);
-                i = PARENT(i);
-            }
-        }
-
-        /***************************************************************************************************************
-        * // Prefer iterative solution over recursion
-        *
-        ***************************************************************************************************************/
-        void BubbleDown(size_t i)
-        {
-            // Recursive solution
-            /*size_t target = GetTarget(i);
-
-            if (target != i)
-            {
-                std::swap(m_storage[i], m_storage[target]);
-                BubbleDown(target);
-            }*/
-
-
-            // Iterate until this condition is met
-            bool done = false;
-
-            do
-            {
-                // Get the target among self and two children
-                size_t target = GetTarget(i);
-
-                // If self is the target, we are in the right place
-                if (target == i) 
-                { 
-                    done = true; 
-                }
-                // Swap with the target, and re assign i to target to re-run on the new i
-                else
-                {
-                    std::swap(m_storage[i], m_storage[target]);
-                    i = target;
-                }
-
-            } while (!done);
-        }
-
-        // underlying storage of the BinaryHeap
-        std::vector<T> m_storage;
-
-        // Used to remove items from the list.  Because the class is templated, it doesn't make sense to change the key value of the item
-        // being removed, so just flip a flag and let the remove code handle it.  Also, this allows for the key value to remain untouched,
-        // which is good if the values in this BinaryHeap are pointers
-        bool m_bypass_aug_key_exception;
-
-        // Comparison operator used
-        // When using this like m_BinaryHeap_property(A, B), on return of true, it's read like "The ordering of A and B currently satisfies BinaryHeap property".
-        // On return of false, it's read as "A must be swapped with B to maintain BinaryHeap property"
-        Compare<T> m_heap_property;
-    };
-
-    template<typename T>
-    using MaxBinaryHeap = BinaryHeap<T, max_heap>;
-
-    template<typename T>
-    using MinBinaryHeap = BinaryHeap<T, min_heap>;
-}
+#pragma once
+
+#include "Heap.hpp"
+#include <optional>
+#include <vector>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    static inline size_t PARENT(size_t i)
+    {
+        // Offset for 0 index
+        return (i - 1) >> 1;
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    static inline size_t LEFT(size_t i)
+    {
+        // Offset for 0 index
+        return (i << 1) + 1;
+    }
+
+    /***************************************************************************************************************
+    *
+    *
+    ***************************************************************************************************************/
+    static inline size_t RIGHT(size_t i)
+    {
+        return LEFT(i) + 1;
+    }
+
+    /***************************************************************************************************************
+    * With Checks set to Unchecked, bad indices, bad keys and empty heaps are only caught by HEAP_ASSERT in Debug.
+    * TryExtractTop never throws either way.
+    ***************************************************************************************************************/
+    template <
+        typename T,
+        template<typename> class Compare,
+        HeapChecks Checks = HeapChecks::Checked
+    >
+    class BinaryHeap {
+    public:
+
+        // Helpful using clause for external users
+        using NODE_TYPE = T;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinaryHeap()
+        {
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        ~BinaryHeap()
+        {
+            if (m_storage.capacity())
+            {
+                m_memory.Freed(m_storage.capacity() * sizeof(T));
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinaryHeap(const std::vector<T>& data) :
+            m_storage(data)
+        {
+            ConstructorBodyInit();
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinaryHeap(std::vector<T>&& data) :
+            m_storage(std::move(data))
+        {
+            ConstructorBodyInit();
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        BinaryHeap(Iterator begin, Iterator end) :
+            m_storage(begin, end)
+        {
+            ConstructorBodyInit();
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const 
+        { 
+            return !m_storage.size();
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_storage.size();
+        }
+
+        /***************************************************************************************************************
+        * The storage never shrinks, everything past Count() is slack
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage(m_storage.size() * sizeof(T), m_storage.size());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        const T& Top()
+        {
+            CheckNotEmpty();
+
+            return m_storage[0];
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        T ExtractTop()
+        {
+            CheckNotEmpty();
+
+            return ExtractTopImpl();
+        }
+
+        /***************************************************************************************************************
+        * Returns std::nullopt instead of throwing when the heap is empty
+        *
+        ***************************************************************************************************************/
+        std::optional<T> TryExtractTop()
+        {
+            if (m_storage.empty())
+            {
+                return std::nullopt;
+            }
+
+            return ExtractTopImpl();
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void DeltaKey(size_t i, const T& val)
+        {
+            CheckIndex(i);
+
+            AugmentKey(i, m_storage[i] + val);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(size_t i, const T& val)
+        {
+            CheckIndex(i);
+
+            // No thanks
+            if constexpr (Checks == HeapChecks::Checked)
+            {
+                if (!m_heap_property(val, m_storage[i]))
+                {
+                    throw Exceptions::InvalidKeyException<T>(val);
+                }
+            }
+            else
+            {
+                HEAP_ASSERT(m_heap_property(val, m_storage[i]));
+            }
+
+            // Change the value
+            m_storage[i] = val;
+
+            // Bubble up
+            BubbleUp(i);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        size_t Insert(const T& val)
+        {
+            size_t capacity = m_storage.capacity();
+            if (m_storage.size() == capacity)
+            {
+                CountAllocation<T>();
+            }
+
+            // A new item has nothing to be checked against, it only ever moves up
+            m_storage.push_back(val);
+            m_memory.Reallocated(capacity * sizeof(T), m_storage.capacity() * sizeof(T));
+            BubbleUp(m_storage.size() - 1);
+
+            // Give back the index
+            return m_storage.size() - 1;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(size_t i)
+        {
+            CheckIndex(i);
+
+            // Trap when user calls remove on index 0
+            if (i == 0)
+            {
+                ExtractTopImpl();
+                return;
+            }
+            
+            // Replace element to be removed with back, and pop back
+            m_storage[i] = m_storage.back();
+            m_storage.pop_back();
+
+            // We removed the back, just ignore
+            if (i == m_storage.size()) { return; }
+            // We don't have to do anything for empty BinaryHeaps or BinaryHeaps of size 1
+            if (m_storage.size() < 2) { return; }
+
+            // now, bubble it up or bubble it down
+            if (m_heap_property(m_storage[i], m_storage[PARENT(i)]))
+            {
+                BubbleUp(i);
+            }
+            else
+            {
+                BubbleDown(i);
+            }
+        }
+
+    protected:
+    private:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        inline void CheckIndex(size_t i) const
+        {
+            if constexpr (Checks == HeapChecks::Checked)
+            {
+                // Beyond our BinaryHeapsize
+                if (i >= m_storage.size())
+                {
+                    throw Exceptions::InvalidIndexException(i);
+                }
+            }
+            else
+            {
+                HEAP_ASSERT(i < m_storage.size());
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        inline void CheckNotEmpty() const
+        {
+            if constexpr (Checks == HeapChecks::Checked)
+            {
+                if (m_storage.empty())
+                {
+                    throw Exceptions::UnderflowException();
+                }
+            }
+            else
+            {
+                HEAP_ASSERT(!m_storage.empty());
+            }
+        }
+
+        /***************************************************************************************************************
+        * Caller guarantees the heap isn't empty
+        *
+        ***************************************************************************************************************/
+        T ExtractTopImpl()
+        {
+            // Get the top item
+            T top = std::move(m_storage[0]);
+
+            // Bring the last item to the front
+            if (m_storage.size() > 1)
+            {
+                m_storage[0] = std::move(m_storage.back());
+            }
+
+            // Remove the end element
+            m_storage.pop_back();
+
+            // BinaryHeapify
+            if (!m_storage.empty())
+            {
+                BubbleDown(0);
+            }
+
+            return top;
+        }
+        
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void ConstructorBodyInit()
+        {
+            if (m_storage.capacity())
+            {
+                m_memory.Allocated(m_storage.capacity() * sizeof(T));
+            }
+
+            // Nothing to do, and the loop below would wrap around
+            if (m_storage.size() < 2)
+            {
+                return;
+            }
+
+            // size_t is unsigned, so cant check below 0.  Start 1 above the bound, so that way --i places us at
+            // n/2 -> 0, and the while (i>0) check will fail on i == 0, but we would have already BinaryHeapified 0
+            size_t i = (m_storage.size() / 2);
+            do
+            {
+                --i;
+                BubbleDown(i);
+            } while (i > 0);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        size_t GetTarget(size_t i)
+        {
+            size_t target   = i;
+            size_t left     = LEFT(i);
+            size_t right    = RIGHT(i);
+
+            size_t heap_size = m_storage.size();
+
+            if (left < heap_size && m_heap_property(m_storage[left], m_storage[target]))
+            {
+                target = left;
+            }
+            if (right < heap_size && m_heap_property(m_storage[right], m_storage[target]))
+            {
+                target = right;
+            }
+
+            return target;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void BubbleUp(size_t i)
+        {
+            // Unqualified, so a Counted T counts these as swaps
+            using std::swap;
+
+            while ((i != 0) && m_heap_property(m_storage[i], m_storage[PARENT(i)]))
+            {
+                swap(m_storage[i], m_storage[PARENT(i)]);
+                i = PARENT(i);
+            }
+        }
+
+        /***************************************************************************************************************
+        * // Prefer iterative solution over recursion
+        *
+        ***************************************************************************************************************/
+        void BubbleDown(size_t i)
+        {
+            // Recursive solution
+            /*size_t target = GetTarget(i);
+
+            if (target != i)
+            {
+                std::swap(m_storage[i], m_storage[target]);
+                BubbleDown(target);
+            }*/
+
+
+            using std::swap;
+
+            // Iterate until this condition is met
+            bool done = false;
+
+            do
+            {
+                // Get the target among self and two children
+                size_t target = GetTarget(i);
+
+                // If self is the target, we are in the right place
+                if (target == i) 
+                { 
+                    done = true; 
+                }
+                // Swap with the target, and re assign i to target to re-run on the new i
+                else
+                {
+                    swap(m_storage[i], m_storage[target]);
+                    i = target;
+                }
+
+            } while (!done);
+        }
+
+        // underlying storage of the BinaryHeap
+        std::vector<T> m_storage;
+
+        MemoryTracker m_memory;
+
+        // Comparison operator used
+        // When using this like m_BinaryHeap_property(A, B), on return of true, it's read like "The ordering of A and B currently satisfies BinaryHeap property".
+        // On return of false, it's read as "A must be swapped with B to maintain BinaryHeap property"
+        Compare<T> m_heap_property;
+    };
+
+    template<typename T>
+    using MaxBinaryHeap = BinaryHeap<T, max_heap>;
+
+    template<typename T>
+    using MinBinaryHeap = BinaryHeap<T, min_heap>;
+
+    template<typename T>
+    using MaxUncheckedBinaryHeap = BinaryHeap<T, max_heap, HeapChecks::Unchecked>;
+
+    template<typename T>
+    using MinUncheckedBinaryHeap = BinaryHeap<T, min_heap, HeapChecks::Unchecked>;
+}
 }
\ No newline at end of file
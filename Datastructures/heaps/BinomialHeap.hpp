@@ -1,485 +1,649 @@
-#pragma once
-
-#include "Heap.hpp"
-#include <math.h>
-
-namespace Datastructures {
-namespace Heaps {
-
-    template <
-        typename T,
-        template<typename> class Compare
-    >
-    class BinomialHeap {
-    public:
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        typedef struct Node
-        {
-        public:
-            /***********************************************************************************************************
-            *
-            *
-            ***********************************************************************************************************/
-            Node(const T& keyVal) :
-                left(this),
-                right(this),
-                parent(nullptr),
-                child(nullptr),
-                degree(0),
-                mark(false),
-                key(keyVal),
-                being_removed(false)
-            {
-            }
-
-            /***********************************************************************************************************
-            *
-            *
-            ***********************************************************************************************************/
-            static void Clear(Node* node)
-            {
-                if (!node) { return; }
-
-                node->left = node;
-                node->right = node;
-                node->parent = nullptr;
-                node->child = nullptr;
-                node->degree = 0;
-                node->mark = false;
-                node->being_removed = false;
-            }
-
-            /***********************************************************************************************************
-            *
-            *
-            ***********************************************************************************************************/
-            inline T Key()
-            {
-                return key;
-            }
-
-        private:
-            // Make a friend class so we can access privates directly
-            friend BinomialHeap;
-
-            Node* left;
-            Node* right;
-            Node* parent;
-            Node* child;
-            int degree;
-            bool mark;
-            bool being_removed;
-            T key;
-            //std::string debug_name = "";
-
-        } Node;
-
-        // Helpful using clause for external users
-        using NODE_TYPE = Node*;
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinomialHeap()
-            : m_count(0)
-            , m_doubled_size(50)
-            , m_degree_array(nullptr)
-            , m_dn(0)
-            , m_top(nullptr)
-        {
-            ResizeDegreeArray(m_doubled_size);
-        }
-
-        ~BinomialHeap()
-        {
-            // Delete all nodes
-            Clear(m_top);
-
-            // Delete the degree array
-            if (m_degree_array)
-            {
-                delete[] m_degree_array;
-            }
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinomialHeap(BinomialHeap&) = delete;
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        BinomialHeap(BinomialHeap&&) = delete;
-
-        /***************************************************************************************************************
-            *
-            *
-            ***************************************************************************************************************/
-        bool BinomialHeap::Empty() const
-        {
-            return !m_count;
-        }
-
-        /***************************************************************************************************************
-            *
-            *
-            ***************************************************************************************************************/
-        bool BinomialHeap::Count() const
-        {
-            return m_count;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE Insert(const T& value)
-        {
-            // Create the new node
-            NODE_TYPE new_node = new Node(value);
-
-            return Insert(new_node);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE Insert(NODE_TYPE node)
-        {
-            if (!node)
-            {
-                return node;
-            }
-
-            // Insert into our root list
-            InsertImpl(node);
-
-            // Return back to caller
-            return node;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void Merge(BinomialHeap& heap)
-        {
-            // Merge the two heaps
-            m_top = MergeImpl(m_top, heap.m_top);
-
-            // Update the count
-            m_count += heap.m_count;
-
-            // Invalidate the heap that was given to us
-            heap.m_top = nullptr;
-            heap.m_count = 0;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE Top()
-        {
-            // Just return to the user
-            return m_top;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE ExtractTop()
-        {
-            return ExtractTopImpl();
-        }
-
-    private:
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void ResizeDegreeArray(unsigned int count)
-        {
-            // Delete m_degree_array if necessary
-            if (m_degree_array)
-            {
-                delete[] m_degree_array;
-            }
-
-            // Recalculate m_dn
-            m_dn = ((int)log2(count)) + 1;
-
-            // Allocate a new array
-            m_degree_array = new NODE_TYPE[m_dn];
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void InsertImpl(NODE_TYPE new_node)
-        {
-            // Combine our lists
-            m_top = MergeImpl(m_top, new_node);
-
-            // Update our count
-            ++m_count;
-
-            // Figure out if we need to resize the dn array
-            if (m_count > m_doubled_size)
-            {
-                // Double it
-                m_doubled_size *= 2;
-
-                ResizeDegreeArray(m_doubled_size);
-            }
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void RemoveFromCircularList(NODE_TYPE node)
-        {
-            // Node is only thing in circular list
-            if (node->right == node)
-            {
-                return;
-            }
-
-            // Swap left and right pointers
-            node->left->right = node->right;
-            node->right->left = node->left;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE MergeImpl(NODE_TYPE main, NODE_TYPE secondary)
-        {
-            // There is no main, secondary becomes main
-            if (!main)
-            {
-                return secondary;
-            }
-
-            // There is no secondary, main stays untouched
-            if (!secondary)
-            {
-                return main;
-            }
-
-            // Ensure that the node returned is always the max/min
-            if (m_heap_property(secondary->key, main->key))
-            {
-                std::swap(main, secondary);
-            }
-
-            // Store temporary pointers
-            NODE_TYPE main_right = main->right;
-            NODE_TYPE secondary_left = secondary->left;
-
-            // Link the two lists
-            main->right = secondary;
-            secondary->left = main;
-
-            // Fill in the gaps
-            main_right->left = secondary_left;
-            secondary_left->right = main_right;
-
-            return main;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        NODE_TYPE ExtractTopImpl()
-        {
-            NODE_TYPE top = m_top;
-
-            // We have no max pointer
-            if (!top)
-            {
-                return top;
-            }
-
-            // Orphan all children of max
-            OrphanAll(top->child);
-
-            // Merge all children into top level list
-            MergeImpl(top, top->child);
-
-            // Remove max from circular list
-            RemoveFromCircularList(top);
-
-            // If top is the only thing in the list, top is now null
-            if (top == top->right)
-            {
-                m_top = nullptr;
-            }
-            // Just move top to the right, and handle updating it in the consolidate function
-            else
-            {
-                m_top = top->right;
-                Consolidate();
-            }
-
-            --m_count;
-
-            // Invalidate top that is returned
-            Node::Clear(top);
-
-            return top;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void OrphanAll(NODE_TYPE node)
-        {
-            NODE_TYPE iter = node;
-            do
-            {
-                iter->parent = nullptr;
-                iter = iter->right;
-            } while(iter != node);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void Consolidate()
-        {
-            // clear the m_degree_array array
-            memset(m_degree_array, 0, sizeof(NODE_TYPE) * m_dn);
-
-            NODE_TYPE parent = m_top;
-            bool quit = false;
-
-            while (!quit)
-            {
-                int d = parent->degree;
-                while (m_degree_array[d] != nullptr)
-                {
-                    NODE_TYPE child = m_degree_array[d];
-
-                    // this is our exit condition.  All things have been consolidated
-                    if (child == parent)
-                    {
-                        quit = true;
-                        break;
-                    }
-
-                    if (m_heap_property(child->key, parent->key))
-                    {
-                        std::swap(parent, child);
-                    }
-
-                    MakeChild(child, parent);
-                    m_degree_array[d++] = nullptr;
-                }
-                if (!quit)
-                {
-                    m_degree_array[parent->degree] = parent;
-                    parent = parent->right;
-                }
-            }
-
-            // Update the max node
-            m_top = parent;
-            UpdateMax();
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void MakeChild(NODE_TYPE child, NODE_TYPE parent)
-        {
-            RemoveFromCircularList(child);
-            child->left = child;
-            child->right = child;
-            child->parent = parent;
-            parent->child = MergeImpl(parent->child, child);
-            child->mark = false;
-            ++parent->degree;
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void UpdateMax()
-        {
-            NODE_TYPE start = m_top;
-            NODE_TYPE iter = m_top;
-            do
-            {
-                if (m_heap_property(next->key, m_top->key))
-                {
-                    m_top = next;
-                }
-
-                iter = iter->right;
-            } while (iter != start);
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void Clear(NODE_TYPE node)
-        {
-            if (!node)
-            {
-                return;
-            }
-
-            NODE_TYPE iter = node;
-            do
-            {
-                NODE_TYPE tmp = iter;
-                iter = iter->right;
-
-                Clear(tmp->child);
-                delete tmp;
-
-            } while (iter != node);
-        }
-
-        // How many things are in this heap
-        unsigned int m_count;
-
-        // Used to dynamically re-size m_degree_array array for consolidate
-        unsigned int m_doubled_size;
-        NODE_TYPE* m_degree_array;
-        unsigned int m_dn;
-
-        // Top of the heap
-        NODE_TYPE m_top;
-
-        // Comparison function to determine max/min heap
-        Compare<T> m_heap_property;
-    };
-
-    template <typename T>
-    using MaxBinomialHeap = BinomialHeap<T, max_heap>;
-
-    template <typename T>
-    using MinBinomialHeap = BinomialHeap<T, min_heap>;
-}
+#pragma once
+
+#include "Heap.hpp"
+#include "NodePool.hpp"
+#include <string.h>
+#include <limits.h>
+#include <iterator>
+
+namespace Datastructures {
+namespace Heaps {
+
+    template <
+        typename T,
+        template<typename> class Compare
+    >
+    class BinomialHeap {
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const T& keyVal) :
+                left(this),
+                right(this),
+                parent(nullptr),
+                child(nullptr),
+                degree(0),
+                mark(false),
+                being_removed(false),
+                pooled(false),
+                key(keyVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->left = node;
+                node->right = node;
+                node->parent = nullptr;
+                node->child = nullptr;
+                node->degree = 0;
+                node->mark = false;
+                node->being_removed = false;
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            inline T Key()
+            {
+                return key;
+            }
+
+            /***********************************************************************************************************
+            * Built by InsertBulk, the heap owns the memory so the caller must never delete it
+            *
+            ***********************************************************************************************************/
+            inline bool Pooled() const
+            {
+                return pooled;
+            }
+
+        private:
+            // Make a friend class so we can access privates directly
+            friend BinomialHeap;
+
+            Node* left;
+            Node* right;
+            Node* parent;
+            Node* child;
+            int degree;
+            bool mark;
+            bool being_removed;
+            bool pooled;
+            T key;
+            //std::string debug_name = "";
+
+        } Node;
+
+        // Helpful using clause for external users
+        using NODE_TYPE = Node*;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinomialHeap()
+            : m_count(0)
+            , m_top(nullptr)
+        {
+            // Consolidate expects every slot to be empty on entry
+            memset(m_degree_array, 0, sizeof(m_degree_array));
+        }
+
+        /***************************************************************************************************************
+        * Builds the heap from [begin, end) with InsertBulk
+        *
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        BinomialHeap(Iterator begin, Iterator end)
+            : BinomialHeap()
+        {
+            InsertBulk(begin, end);
+        }
+
+        ~BinomialHeap()
+        {
+            // Delete all nodes
+            Clear(m_top);
+
+            // The pool goes with us
+            m_memory.Freed(m_pool.Bytes(), m_pool.Blocks());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinomialHeap(BinomialHeap&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinomialHeap& operator=(const BinomialHeap&) = delete;
+
+        /***************************************************************************************************************
+        * Steals the root list of heap, heap is left empty
+        *
+        ***************************************************************************************************************/
+        BinomialHeap(BinomialHeap&& heap)
+            : BinomialHeap()
+        {
+            Merge(heap);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BinomialHeap& operator=(BinomialHeap&& heap)
+        {
+            if (this != &heap)
+            {
+                // Drop whatever we had.  Pooled nodes stay allocated until we're destroyed, the caller may still hold
+                // some of them
+                Clear(m_top);
+                m_top = nullptr;
+                m_count = 0;
+
+                Merge(heap);
+            }
+
+            return *this;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * Pooled nodes that were extracted are live but not used, the pool only lets go of them all at once
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const T& value)
+        {
+            // Create the new node
+            CountAllocation<T>();
+            NODE_TYPE new_node = new Node(value);
+            m_memory.Allocated(sizeof(Node));
+
+            InsertImpl(new_node);
+            return new_node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            // The heap owns it again, a pooled node never stopped being part of the pool
+            if (!node->pooled)
+            {
+                m_memory.Adopted(sizeof(Node));
+            }
+
+            // Insert into our root list
+            InsertImpl(node);
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        * Builds a node for every value in [begin, end) in a single allocation and links them straight into binomial
+        * trees, one for each set bit of the count.  Returns the first node, the rest follow it in the same order as
+        * the range.
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        NODE_TYPE InsertBulk(Iterator begin, Iterator end)
+        {
+            size_t count = (size_t)std::distance(begin, end);
+
+            NODE_TYPE nodes = m_pool.Allocate(begin, count);
+            if (!nodes)
+            {
+                return nodes;
+            }
+
+            // One block for the lot
+            CountAllocation<T>();
+            m_memory.Allocated(NodePool<Node>::BlockBytes(count));
+
+            // Count up to count in binary.  Every carry links two trees of the same degree, so it takes exactly
+            // count - popcount(count) comparisons, and the degree array is free scratch space between consolidates
+            for (size_t i = 0; i < count; ++i)
+            {
+                NODE_TYPE tree = nodes + i;
+                tree->pooled = true;
+
+                while (m_degree_array[tree->degree])
+                {
+                    NODE_TYPE other = m_degree_array[tree->degree];
+                    m_degree_array[tree->degree] = nullptr;
+
+                    tree = LinkTrees(other, tree);
+                }
+
+                m_degree_array[tree->degree] = tree;
+            }
+
+            // Whatever is left is one tree per set bit, gather them up and leave the array empty for Consolidate
+            NODE_TYPE roots = nullptr;
+            for (NODE_TYPE& slot : m_degree_array)
+            {
+                if (slot)
+                {
+                    roots = MergeImpl(roots, slot);
+                    slot = nullptr;
+                }
+            }
+
+            m_top = MergeImpl(m_top, roots);
+            m_count += (unsigned int)count;
+
+            return nodes;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Merge(BinomialHeap& heap)
+        {
+            // Merging with ourselves would just orphan everything
+            if (this == &heap)
+            {
+                return;
+            }
+
+            // Merge the two heaps, this is just a splice of the two root lists.  Trees are only ever linked with others
+            // of the same degree in Consolidate, so they stay binomial
+            m_top = MergeImpl(m_top, heap.m_top);
+
+            // Update the count
+            m_count += heap.m_count;
+
+            // Their pooled nodes are ours now
+            m_pool.Steal(heap.m_pool);
+            m_memory.Steal(heap.m_memory);
+
+            // Invalidate the heap that was given to us
+            heap.m_top = nullptr;
+            heap.m_count = 0;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            // Just return to the user
+            return m_top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            NODE_TYPE top = ExtractTopImpl();
+
+            // The caller's from here on, unless it's pooled, the pool still holds its memory
+            if (top && !top->pooled)
+            {
+                m_memory.Disowned(sizeof(Node));
+            }
+
+            return top;
+        }
+
+    private:
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void InsertImpl(NODE_TYPE new_node)
+        {
+            // Combine our lists
+            m_top = MergeImpl(m_top, new_node);
+
+            // Update our count
+            ++m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void RemoveFromCircularList(NODE_TYPE node)
+        {
+            // Node is only thing in circular list
+            if (node->right == node)
+            {
+                return;
+            }
+
+            // Swap left and right pointers
+            node->left->right = node->right;
+            node->right->left = node->left;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE MergeImpl(NODE_TYPE main, NODE_TYPE secondary)
+        {
+            // There is no main, secondary becomes main
+            if (!main)
+            {
+                return secondary;
+            }
+
+            // There is no secondary, main stays untouched
+            if (!secondary)
+            {
+                return main;
+            }
+
+            // Ensure that the node returned is always the max/min
+            if (m_heap_property(secondary->key, main->key))
+            {
+                std::swap(main, secondary);
+            }
+
+            // Store temporary pointers
+            NODE_TYPE main_right = main->right;
+            NODE_TYPE secondary_left = secondary->left;
+
+            // Link the two lists
+            main->right = secondary;
+            secondary->left = main;
+
+            // Fill in the gaps
+            main_right->left = secondary_left;
+            secondary_left->right = main_right;
+
+            return main;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTopImpl()
+        {
+            NODE_TYPE top = m_top;
+
+            // We have no max pointer
+            if (!top)
+            {
+                return top;
+            }
+
+            // Orphan all children of max
+            OrphanAll(top->child);
+
+            // Merge all children into top level list
+            MergeImpl(top, top->child);
+
+            // Remove max from circular list
+            RemoveFromCircularList(top);
+
+            // If top is the only thing in the list, top is now null
+            if (top == top->right)
+            {
+                m_top = nullptr;
+            }
+            // Just move top to the right, and handle updating it in the consolidate function
+            else
+            {
+                m_top = top->right;
+                Consolidate();
+            }
+
+            --m_count;
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void OrphanAll(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return;
+            }
+
+            NODE_TYPE iter = node;
+            do
+            {
+                iter->parent = nullptr;
+                iter = iter->right;
+            } while(iter != node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Consolidate()
+        {
+            NODE_TYPE parent = m_top;
+            bool quit = false;
+
+            while (!quit)
+            {
+                int d = parent->degree;
+                while (m_degree_array[d] != nullptr)
+                {
+                    NODE_TYPE child = m_degree_array[d];
+
+                    // this is our exit condition.  All things have been consolidated
+                    if (child == parent)
+                    {
+                        quit = true;
+                        break;
+                    }
+
+                    if (m_heap_property(child->key, parent->key))
+                    {
+                        std::swap(parent, child);
+                    }
+
+                    MakeChild(child, parent);
+                    m_degree_array[d++] = nullptr;
+                }
+                if (!quit)
+                {
+                    m_degree_array[parent->degree] = parent;
+                    parent = parent->right;
+                }
+            }
+
+            // Update the max node
+            m_top = parent;
+            UpdateMax();
+
+            // The only slots still filled belong to the remaining roots, so clear them on the way out instead of
+            // wiping the whole array on the way in
+            NODE_TYPE iter = m_top;
+            do
+            {
+                m_degree_array[iter->degree] = nullptr;
+                iter = iter->right;
+            } while (iter != m_top);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void MakeChild(NODE_TYPE child, NODE_TYPE parent)
+        {
+            RemoveFromCircularList(child);
+            child->left = child;
+            child->right = child;
+            child->parent = parent;
+            parent->child = MergeImpl(parent->child, child);
+            child->mark = false;
+            ++parent->degree;
+        }
+
+        /***************************************************************************************************************
+        * Links two lone roots of the same degree and returns the winner.  Unlike MakeChild the loser goes straight into
+        * the child list, without the comparison MergeImpl would spend keeping the child pointer on the best child
+        ***************************************************************************************************************/
+        NODE_TYPE LinkTrees(NODE_TYPE first, NODE_TYPE second)
+        {
+            if (m_heap_property(second->key, first->key))
+            {
+                std::swap(first, second);
+            }
+
+            second->parent = first;
+
+            NODE_TYPE child = first->child;
+            if (child)
+            {
+                second->left = child;
+                second->right = child->right;
+                child->right->left = second;
+                child->right = second;
+            }
+            else
+            {
+                first->child = second;
+            }
+
+            ++first->degree;
+
+            return first;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void UpdateMax()
+        {
+            NODE_TYPE start = m_top;
+            NODE_TYPE iter = m_top;
+            do
+            {
+                if (m_heap_property(iter->key, m_top->key))
+                {
+                    m_top = iter;
+                }
+
+                iter = iter->right;
+            } while (iter != start);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Clear(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return;
+            }
+
+            NODE_TYPE iter = node;
+            do
+            {
+                NODE_TYPE tmp = iter;
+                iter = iter->right;
+
+                Clear(tmp->child);
+                if (!tmp->pooled)
+                {
+                    delete tmp;
+                    m_memory.Freed(sizeof(Node));
+                }
+
+            } while (iter != node);
+        }
+
+        // How many things are in this heap
+        unsigned int m_count;
+
+        // Scratch space for consolidate, indexed by degree.  A binomial tree of degree k holds 2^k nodes, so the
+        // degree can never reach the bit width of m_count
+        NODE_TYPE m_degree_array[sizeof(unsigned int) * CHAR_BIT];
+
+        // Top of the heap
+        NODE_TYPE m_top;
+
+        // Backing memory for every node built by InsertBulk
+        NodePool<Node> m_pool;
+
+        MemoryTracker m_memory;
+
+        // Comparison function to determine max/min heap
+        Compare<T> m_heap_property;
+    };
+
+    template <typename T>
+    using MaxBinomialHeap = BinomialHeap<T, max_heap>;
+
+    template <typename T>
+    using MinBinomialHeap = BinomialHeap<T, min_heap>;
+}
 }
\ No newline at end of file
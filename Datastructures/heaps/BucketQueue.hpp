@@ -0,0 +1,394 @@
+#pragma once
+
+#include "Heap.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Monotone min heap for integer keys drawn from a small range (Dial).  Every live key has to sit in
+    * [last top, last top + range], where last top starts at the key given to the constructor and then follows the
+    * keys handed out by ExtractTop.  Top only looks, so it never narrows what the queue accepts.  That means range + 1
+    * circular buckets are enough and every bucket only ever holds one distinct key.  Insert, AugmentKey and Remove are
+    * O(1), Top and ExtractTop are O(range) worst case and usually much less.
+    *
+    * Keys outside the window throw InvalidKeyException.
+    ***************************************************************************************************************/
+    template <
+        typename KeyType,
+        typename ValueType = KeyType
+    >
+    class BucketQueue
+    {
+        static_assert(std::is_integral<KeyType>::value, "BucketQueue requires an integral key");
+
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const KeyType& keyVal, const ValueType& valueVal)
+                : prev(nullptr), next(nullptr), bucket(0), key(keyVal), value(valueVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->prev      = nullptr;
+                node->next      = nullptr;
+                node->bucket    = 0;
+            }
+
+            inline KeyType Key() const
+            {
+                return key;
+            }
+
+            inline const ValueType& Value() const
+            {
+                return value;
+            }
+
+        private:
+            friend BucketQueue;
+
+            Node* prev;
+            Node* next;
+            size_t bucket;
+            KeyType key;
+            ValueType value;
+
+        } Node;
+
+        // Helpful using clauses for external users
+        using NODE_TYPE = Node*;
+        using KEY_TYPE = KeyType;
+        using VALUE_TYPE = ValueType;
+
+        /***************************************************************************************************************
+        * range is the largest distance allowed between the last top and any key in the queue, start is the lowest key
+        * allowed until something is extracted
+        ***************************************************************************************************************/
+        explicit BucketQueue(size_t range, const KeyType& start = KeyType())
+            : m_count(0),
+            m_last(start),
+            m_cursor(0),
+            m_range(range),
+            m_buckets(range + 1, nullptr)
+        {
+            m_memory.Allocated(m_buckets.capacity() * sizeof(NODE_TYPE));
+        }
+
+        ~BucketQueue()
+        {
+            // Delete all nodes
+            for (NODE_TYPE iter : m_buckets)
+            {
+                while (iter)
+                {
+                    NODE_TYPE tmp = iter;
+                    iter = iter->next;
+                    delete tmp;
+                    m_memory.Freed(sizeof(Node));
+                }
+            }
+
+            m_memory.Freed(m_buckets.capacity() * sizeof(NODE_TYPE));
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BucketQueue(BucketQueue&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        BucketQueue(BucketQueue&&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * The bucket array is sized by the range at construction and never changes, whatever the count
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key)
+        {
+            return Insert(key, ValueType());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key, const ValueType& value)
+        {
+            Anchor(key);
+            CheckWindow(key);
+
+            // Create the new node
+            NODE_TYPE new_node = new Node(key, value);
+            m_memory.Allocated(sizeof(Node));
+
+            return InsertImpl(new_node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            Anchor(node->key);
+            CheckWindow(node->key);
+
+            m_memory.Adopted(sizeof(Node));
+
+            return InsertImpl(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            return m_buckets[NextBucket()];
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            // We have no top
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            // Only handing a key out moves the window up to it
+            size_t index = NextBucket();
+            NODE_TYPE top = m_buckets[index];
+
+            m_last = top->key;
+            m_cursor = index;
+
+            Unlink(top);
+            --m_count;
+
+            // The caller's from here on
+            m_memory.Disowned(sizeof(Node));
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const KeyType& key)
+        {
+            // Only decreases are allowed
+            if (!(key < node->key))
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<KeyType>(key);
+            }
+
+            CheckWindow(key);
+
+            Unlink(node);
+            node->key = key;
+            Push(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            Unlink(node);
+            --m_count;
+
+            m_memory.Disowned(sizeof(Node));
+
+            Node::Clear(node);
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE InsertImpl(NODE_TYPE node)
+        {
+            Push(node);
+            ++m_count;
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        * An empty queue can slide its window anywhere, but only does so when the key doesn't fit the current one
+        *
+        ***************************************************************************************************************/
+        void Anchor(const KeyType& key)
+        {
+            if (!m_count && (key < m_last || (size_t)(key - m_last) > m_range))
+            {
+                m_last = key;
+                m_cursor = 0;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void CheckWindow(const KeyType& key) const
+        {
+            if (key < m_last || (size_t)(key - m_last) > m_range)
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<KeyType>(key);
+            }
+        }
+
+        /***************************************************************************************************************
+        * First non empty bucket at or after the cursor, each step is one key.  Leaves the window where it is
+        *
+        ***************************************************************************************************************/
+        size_t NextBucket() const
+        {
+            size_t index = m_cursor;
+            while (!m_buckets[index])
+            {
+                index = (index + 1 == m_buckets.size()) ? 0 : index + 1;
+            }
+
+            return index;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Push(NODE_TYPE node)
+        {
+            // Offset from the cursor, wrapped around the circle
+            size_t index = m_cursor + (size_t)(node->key - m_last);
+            if (index >= m_buckets.size())
+            {
+                index -= m_buckets.size();
+            }
+
+            node->bucket = index;
+            node->prev = nullptr;
+            node->next = m_buckets[index];
+
+            if (node->next)
+            {
+                node->next->prev = node;
+            }
+
+            m_buckets[index] = node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Unlink(NODE_TYPE node)
+        {
+            if (node->prev)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                m_buckets[node->bucket] = node->next;
+            }
+
+            if (node->next)
+            {
+                node->next->prev = node->prev;
+            }
+        }
+
+        // How many things are in this heap
+        unsigned int m_count;
+
+        // Last key handed out by ExtractTop, and the bucket it lives in
+        KeyType m_last;
+        size_t m_cursor;
+
+        // Widest allowed spread of keys
+        size_t m_range;
+
+        // Circular buckets, one per key in the window
+        std::vector<NODE_TYPE> m_buckets;
+
+        MemoryTracker m_memory;
+    };
+}
+}
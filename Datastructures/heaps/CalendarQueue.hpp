@@ -0,0 +1,504 @@
+#pragma once
+
+#include "Heap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Calendar queue (Brown) for discrete event simulation.  Keys are hashed into "days" of a fixed width, and the
+    * days wrap around a "year" of buckets, each holding a sorted list.  ExtractTop walks forward one day at a time
+    * from the last top, so when the width matches the spacing of the keys every operation is O(1) on average.  The
+    * number of buckets doubles or halves as the count moves, and the width is re-estimated from the spacing of the
+    * smallest keys every time it does.
+    *
+    * Min heap only.  Keys may be inserted anywhere, including behind the last top.
+    ***************************************************************************************************************/
+    template <
+        typename KeyType,
+        typename ValueType = KeyType
+    >
+    class CalendarQueue
+    {
+        static_assert(std::is_arithmetic<KeyType>::value, "CalendarQueue requires an arithmetic key");
+
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const KeyType& keyVal, const ValueType& valueVal)
+                : prev(nullptr), next(nullptr), bucket(0), key(keyVal), value(valueVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->prev      = nullptr;
+                node->next      = nullptr;
+                node->bucket    = 0;
+            }
+
+            inline KeyType Key() const
+            {
+                return key;
+            }
+
+            inline const ValueType& Value() const
+            {
+                return value;
+            }
+
+        private:
+            friend CalendarQueue;
+
+            Node* prev;
+            Node* next;
+            size_t bucket;
+            KeyType key;
+            ValueType value;
+
+        } Node;
+
+        // Helpful using clauses for external users
+        using NODE_TYPE = Node*;
+        using KEY_TYPE = KeyType;
+        using VALUE_TYPE = ValueType;
+
+        /***************************************************************************************************************
+        * width is the first guess at the spacing between keys, it gets re-estimated on every resize
+        *
+        ***************************************************************************************************************/
+        explicit CalendarQueue(double width = 1.0)
+            : m_count(0),
+            m_width(width > 0.0 ? width : 1.0),
+            m_day(0),
+            m_buckets(MIN_BUCKETS, nullptr)
+        {
+            m_memory.Allocated(m_buckets.capacity() * sizeof(NODE_TYPE));
+        }
+
+        ~CalendarQueue()
+        {
+            // Delete all nodes
+            for (NODE_TYPE iter : m_buckets)
+            {
+                while (iter)
+                {
+                    NODE_TYPE tmp = iter;
+                    iter = iter->next;
+                    delete tmp;
+                    m_memory.Freed(sizeof(Node));
+                }
+            }
+
+            m_memory.Freed(m_buckets.capacity() * sizeof(NODE_TYPE));
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        CalendarQueue(CalendarQueue&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        CalendarQueue(CalendarQueue&&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * The bucket array follows the count up and down, the rest is one node per element
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key)
+        {
+            return Insert(key, ValueType());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key, const ValueType& value)
+        {
+            // Create the new node
+            NODE_TYPE new_node = new Node(key, value);
+            m_memory.Allocated(sizeof(Node));
+
+            return InsertImpl(new_node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            m_memory.Adopted(sizeof(Node));
+
+            return InsertImpl(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            const size_t size = m_buckets.size();
+
+            // Walk forward one day at a time, a bucket's head is only ours if it falls on the day we're looking at
+            for (size_t i = 0; i < size; ++i)
+            {
+                long long day = m_day + (long long)i;
+                NODE_TYPE head = m_buckets[BucketIndex(day)];
+
+                if (head && Day(head->key) == day)
+                {
+                    m_day = day;
+                    return head;
+                }
+            }
+
+            // A whole year went by with nothing in it, so the keys are sparse.  Look at every head directly
+            NODE_TYPE top = nullptr;
+            for (NODE_TYPE head : m_buckets)
+            {
+                if (head && (!top || head->key < top->key))
+                {
+                    top = head;
+                }
+            }
+
+            m_day = Day(top->key);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            NODE_TYPE top = Top();
+
+            // We have no top
+            if (!top)
+            {
+                return top;
+            }
+
+            Unlink(top);
+            --m_count;
+
+            // The caller's from here on
+            m_memory.Disowned(sizeof(Node));
+
+            Shrink();
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        * Reschedule, the new key can be earlier or later than the old one
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const KeyType& key)
+        {
+            Unlink(node);
+            node->key = key;
+            Push(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            Unlink(node);
+            --m_count;
+
+            m_memory.Disowned(sizeof(Node));
+
+            Shrink();
+
+            Node::Clear(node);
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE InsertImpl(NODE_TYPE node)
+        {
+            Push(node);
+            ++m_count;
+
+            if (m_count > (m_buckets.size() << 1))
+            {
+                Resize(m_buckets.size() << 1);
+            }
+
+            // Return back to caller
+            return node;
+        }
+
+        // Never shrink below this many buckets
+        static constexpr size_t MIN_BUCKETS = 2;
+
+        // How many of the smallest keys are sampled when estimating a new width
+        static constexpr size_t WIDTH_SAMPLES = 25;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        inline long long Day(const KeyType& key) const
+        {
+            return (long long)std::floor((double)key / m_width);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        inline size_t BucketIndex(long long day) const
+        {
+            long long size = (long long)m_buckets.size();
+            long long index = day % size;
+
+            return (size_t)(index < 0 ? index + size : index);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Push(NODE_TYPE node)
+        {
+            long long day = Day(node->key);
+
+            // Anything behind the current day pulls the walk back to it
+            if (!m_count || day < m_day)
+            {
+                m_day = day;
+            }
+
+            size_t index = BucketIndex(day);
+            node->bucket = index;
+
+            // Buckets are kept sorted, and are short as long as the width is right
+            NODE_TYPE prev = nullptr;
+            NODE_TYPE iter = m_buckets[index];
+            while (iter && !(node->key < iter->key))
+            {
+                prev = iter;
+                iter = iter->next;
+            }
+
+            node->prev = prev;
+            node->next = iter;
+
+            if (iter)
+            {
+                iter->prev = node;
+            }
+
+            if (prev)
+            {
+                prev->next = node;
+            }
+            else
+            {
+                m_buckets[index] = node;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Unlink(NODE_TYPE node)
+        {
+            if (node->prev)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                m_buckets[node->bucket] = node->next;
+            }
+
+            if (node->next)
+            {
+                node->next->prev = node->prev;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Shrink()
+        {
+            if (m_buckets.size() > MIN_BUCKETS && m_count < (m_buckets.size() >> 1))
+            {
+                Resize(m_buckets.size() >> 1);
+            }
+        }
+
+        /***************************************************************************************************************
+        * Rehash everything into size buckets, picking a new width from the smallest keys first
+        *
+        ***************************************************************************************************************/
+        void Resize(size_t size)
+        {
+            std::vector<NODE_TYPE> nodes;
+            nodes.reserve(m_count);
+
+            for (NODE_TYPE iter : m_buckets)
+            {
+                while (iter)
+                {
+                    nodes.push_back(iter);
+                    iter = iter->next;
+                }
+            }
+
+            EstimateWidth(nodes);
+
+            size_t capacity = m_buckets.capacity();
+            m_buckets.assign(size, nullptr);
+            m_memory.Reallocated(capacity * sizeof(NODE_TYPE), m_buckets.capacity() * sizeof(NODE_TYPE));
+
+            // Push resets the current day off the first node, and pulls it back for anything smaller
+            m_count = 0;
+            for (NODE_TYPE node : nodes)
+            {
+                Push(node);
+                ++m_count;
+            }
+        }
+
+        /***************************************************************************************************************
+        * Brown's estimate: three times the average gap between the smallest keys, ignoring gaps more than twice the
+        * average
+        ***************************************************************************************************************/
+        void EstimateWidth(std::vector<NODE_TYPE>& nodes)
+        {
+            if (nodes.size() < 2)
+            {
+                return;
+            }
+
+            size_t samples = std::min(nodes.size(), WIDTH_SAMPLES);
+            std::partial_sort(nodes.begin(), nodes.begin() + samples, nodes.end(),
+                [](NODE_TYPE left, NODE_TYPE right) { return left->key < right->key; });
+
+            double total = 0.0;
+            for (size_t i = 1; i < samples; ++i)
+            {
+                total += (double)nodes[i]->key - (double)nodes[i - 1]->key;
+            }
+
+            double average = total / (double)(samples - 1);
+
+            double trimmed = 0.0;
+            size_t kept = 0;
+            for (size_t i = 1; i < samples; ++i)
+            {
+                double gap = (double)nodes[i]->key - (double)nodes[i - 1]->key;
+                if (gap <= 2.0 * average)
+                {
+                    trimmed += gap;
+                    ++kept;
+                }
+            }
+
+            // All equal keys tell us nothing, keep the old width
+            if (kept && trimmed > 0.0)
+            {
+                m_width = 3.0 * trimmed / (double)kept;
+            }
+        }
+
+        // How many things are in this queue
+        unsigned int m_count;
+
+        // Width of a single day
+        double m_width;
+
+        // Day the walk is currently on, the top is never before it
+        long long m_day;
+
+        // One bucket per day of the year, each sorted
+        std::vector<NODE_TYPE> m_buckets;
+
+        MemoryTracker m_memory;
+    };
+}
+}
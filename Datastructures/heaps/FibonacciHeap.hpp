@@ -1,603 +1,973 @@
-#pragma once
-
-#include "Heap.hpp"
-#include <math.h>
-
-namespace Datastructures {
-namespace Heaps {
-
-    template <
-        typename T,
-        template<typename> class Compare
-    >
-    class FibonacciHeap {
-    public:
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        typedef struct Node
-        {
-        public:
-            /***********************************************************************************************************
-            * 
-            * 
-            ***********************************************************************************************************/
-            Node(const T& keyVal): 
-                left(this), 
-                right(this),
-                parent(nullptr),
-                child(nullptr),
-                degree(0), 
-                mark(false), 
-                key(keyVal), 
-                being_removed(false)
-            {
-            }
-
-            /***********************************************************************************************************
-            * 
-            * 
-            ***********************************************************************************************************/
-            static void Clear(Node* node)
-            {
-                if (!node) { return; }
-
-                node->left          = node;
-                node->right         = node;
-                node->parent        = nullptr;
-                node->child         = nullptr;
-                node->degree        = 0;
-                node->mark          = false;
-                node->being_removed = false;
-            }
-
-            /***********************************************************************************************************
-            * 
-            * 
-            ***********************************************************************************************************/
-            inline T Key() 
-            { 
-                return key; 
-            }
-
-        private:
-            // Make a friend class so we can access privates directly
-            friend FibonacciHeap;
-
-            Node* left;
-            Node* right;
-            Node* parent;
-            Node* child;
-            int degree;
-            bool mark;
-            bool being_removed;
-            T key;
-            //std::string debug_name = "";
-
-        } Node;
-
-        // Helpful using clause for external users
-        using NODE_TYPE = Node*;
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        FibonacciHeap()
-            : m_count(0)
-            , m_doubled_size(50)
-            , m_degree_array(nullptr)
-            , m_dn(0)
-            , m_top(nullptr)
-        {
-            ResizeDegreeArray(m_doubled_size);
-        }
-
-        ~FibonacciHeap()
-        {
-            // Delete all nodes
-            Clear(m_top);
-
-            // Delete the degree array
-            if (m_degree_array)
-            {
-                delete[] m_degree_array;
-            }
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        FibonacciHeap(FibonacciHeap&) = delete;
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        FibonacciHeap(FibonacciHeap&&) = delete;
-
-        /***************************************************************************************************************
-         *
-         *
-         ***************************************************************************************************************/
-        bool FibonacciHeap::Empty() const
-        {
-            return !m_count;
-        }
-
-        /***************************************************************************************************************
-         *
-         *
-         ***************************************************************************************************************/
-        bool FibonacciHeap::Count() const
-        {
-            return m_count;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE Insert(const T& value)
-        {
-            // Create the new node
-            NODE_TYPE new_node = new Node(value);
-
-            return Insert(new_node);
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE Insert(NODE_TYPE node)
-        {
-            if (!node)
-            {
-                return node;
-            }
-
-            // Insert into our root list
-            InsertImpl(node);
-
-            // Return back to caller
-            return node;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void Merge(FibonacciHeap& heap)
-        {
-            // Merge the two heaps
-            m_top = MergeImpl(m_top, heap.m_top);
-
-            // Update the count
-            m_count += heap.m_count;
-
-            // Invalidate the heap that was given to us
-            heap.m_top = nullptr;
-            heap.m_count = 0;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE Top()
-        {
-            // Just return to the user
-            return m_top;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE ExtractTop()
-        {
-            return ExtractTopImpl();
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void AugmentKey(NODE_TYPE node, const T& value)
-        {
-            AugmentKeyImpl(node, value);
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void Remove(NODE_TYPE node)
-        {
-            // if the node being removed is not the top, make it the top
-            if (node != m_top)
-            {
-                node->being_removed = true;
-                AugmentKeyImpl(node, node->key);;
-            }
-            
-            // Remove the node
-            ExtractTopImpl();
-        }
-
-    private:
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void ResizeDegreeArray(unsigned int count)
-        {
-            // Delete m_degree_array if necessary
-            if (m_degree_array)
-            {
-                delete[] m_degree_array;
-            }
-
-            // Recalculate m_dn
-            m_dn = ((int)log2(count)) + 1;
-
-            // Allocate a new array
-            m_degree_array = new NODE_TYPE[m_dn];
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void InsertImpl(NODE_TYPE new_node)
-        {
-            // Combine our lists
-            m_top = MergeImpl(m_top, new_node);
-
-            // Update our count
-            ++m_count;
-
-            // Figure out if we need to resize the dn array
-            if (m_count > m_doubled_size)
-            {
-                // Double it
-                m_doubled_size *= 2;
-
-                ResizeDegreeArray(m_doubled_size);
-            }
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void RemoveFromCircularList(NODE_TYPE node)
-        {
-            // Node is only thing in circular list
-            if (node->right == node)
-            {
-                return;
-            }
-
-            // Swap left and right pointers
-            node->left->right = node->right;
-            node->right->left = node->left;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE MergeImpl(NODE_TYPE main, NODE_TYPE secondary)
-        {
-            // There is no main, secondary becomes main
-            if (!main)
-            {
-                return secondary;
-            }
-
-            // There is no secondary, main stays untouched
-            if (!secondary)
-            {
-                return main;
-            }
-
-            // Ensure that the node returned is always the max/min
-            if (m_heap_property(secondary->key, main->key))
-            {
-                std::swap(main, secondary);
-            }
-
-            // Store temporary pointers
-            NODE_TYPE main_right = main->right;
-            NODE_TYPE secondary_left = secondary->left;
-
-            // Link the two lists
-            main->right = secondary;
-            secondary->left = main;
-
-            // Fill in the gaps
-            main_right->left = secondary_left;
-            secondary_left->right = main_right;
-
-            return main;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        NODE_TYPE ExtractTopImpl()
-        {
-            NODE_TYPE top = m_top;
-
-            // We have no max pointer
-            if (!top)
-            {
-                return top;
-            }
-
-            // Orphan all children of max
-            OrphanAll(top->child);
-
-            // Merge all children into top level list
-            MergeImpl(top, top->child);
-
-            // Remove max from circular list
-            RemoveFromCircularList(top);
-
-            // If top is the only thing in the list, top is now null
-            if (top == top->right)
-            {
-                m_top = nullptr;
-            }
-            // Just move top to the right, and handle updating it in the consolidate function
-            else
-            {
-                m_top = top->right;
-                Consolidate();
-            }
-
-            --m_count;
-
-            // Invalidate top that is returned
-            Node::Clear(top);
-
-            return top;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void OrphanAll(NODE_TYPE node)
-        {
-            NODE_TYPE iter = node;
-            do 
-            {
-                iter->parent = nullptr;
-                iter = iter->right;
-            } while (iter != node);
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void Consolidate()
-        {
-            // clear the m_degree_array array
-            memset(m_degree_array, 0, sizeof(NODE_TYPE) * m_dn);
-
-            NODE_TYPE parent = m_top;
-            bool quit = false;
-
-            while (!quit)
-            {
-                int d = parent->degree;
-                while (m_degree_array[d] != nullptr) 
-                {
-                    NODE_TYPE child = m_degree_array[d];
-
-                    // this is our exit condition.  All things have been consolidated
-                    if (child == parent) 
-                    {
-                        quit = true;
-                        break;
-                    }
-
-                    if (m_heap_property(child->key, parent->key)) 
-                    {
-                        std::swap(parent, child);
-                    }
-
-                    MakeChild(child, parent);
-                    m_degree_array[d++] = nullptr;
-                }
-                if (!quit) 
-                {
-                    m_degree_array[parent->degree] = parent;
-                    parent = parent->right;
-                }
-            }
-
-            // Update the max node
-            m_top = parent;
-            UpdateMax();
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void MakeChild(NODE_TYPE child, NODE_TYPE parent)
-        {
-            RemoveFromCircularList(child);
-            child->left = child;
-            child->right = child;
-            child->parent = parent;
-            parent->child = MergeImpl(parent->child, child);
-            child->mark = false;
-            ++parent->degree;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void AugmentKeyImpl(NODE_TYPE node, const T& k)
-        {
-            // If the being_removed flag is set, then this guy is being removed.
-            if (!node->being_removed && !m_heap_property(k, node->key))
-            {
-                throw Datastructures::Heaps::Exceptions::InvalidKeyException<T>(k);
-            }
-
-            // Update the nodes value
-            node->key = k;
-
-            NODE_TYPE parent = node->parent;
-
-            // The node being updated is larger than the parent, or this node is being removed
-            if (parent && (node->being_removed || m_heap_property(node->key, parent->key)))
-            {
-                // Do the cutting
-                Cut(node, parent);
-                CascadingCut(parent);
-            }
-
-            // Update the top pointer if new node is larger or being removed
-            if (node->being_removed || m_heap_property(node->key, m_top->key))
-            {
-                m_top = node;
-            }
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void Cut(NODE_TYPE child, NODE_TYPE parent)
-        {
-            RemoveFromCircularList(child);
-
-            // Update the parent child pointer node
-            if (child->right == child) 
-            {
-                parent->child = nullptr;
-            } else 
-            {
-                parent->child = child->right;
-            }
-
-            // Decrement the degree of y
-            --parent->degree;
-
-            // Merge impl requires that the circular linked list be valid, so set left/right pointers to self
-            child->left = child;
-            child->right = child;
-
-            // Add x to the root list
-            MergeImpl(m_top, child);
-
-            // Reset x's pointers
-            child->parent = nullptr;
-            child->mark = false;
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void CascadingCut(NODE_TYPE node)
-        {
-            // Get the childs parent
-            NODE_TYPE parent = node->parent;
-
-            // We have no parents, done
-            if (!parent) 
-            {
-                return;
-            }
-
-            // If the parent is not marked, mark it
-            if (!node->mark) 
-            {
-                node->mark = true;
-            } 
-            else 
-            {
-                // cut the child from the parent
-                Cut(node, parent);
-                CascadingCut(parent);
-            }
-        }
-
-        /***************************************************************************************************************
-        *
-        *
-        ***************************************************************************************************************/
-        void UpdateMax()
-        {
-            NODE_TYPE start = m_top;
-            NODE_TYPE iter = m_top;
-            do
-            {
-                if (m_heap_property(iter->key, m_top->key))
-                {
-                    m_top = iter;
-                }
-
-                iter = iter->right;
-            } while (iter != start);
-        }
-
-        /***************************************************************************************************************
-        * 
-        * 
-        ***************************************************************************************************************/
-        void Clear(NODE_TYPE node)
-        {
-            if (!node)
-            {
-                return;
-            }
-
-            NODE_TYPE iter = node;
-            do
-            {
-                NODE_TYPE tmp = iter;
-                iter = iter->right;
-
-                Clear(tmp->child);
-                delete tmp;
-
-            } while (iter != node);
-        }
-
-        // How many things are in this heap
-        unsigned int m_count;
-
-        // Used to dynamically re-size m_degree_array array for consolidate
-        unsigned int m_doubled_size;
-        NODE_TYPE* m_degree_array;
-        unsigned int m_dn;
-
-        // Top of the heap
-        NODE_TYPE m_top;
-
-        // Comparison function to determine max/min heap
-        Compare<T> m_heap_property;
-    };
-
-    template <typename T>
-    using MaxFibonacciHeap = FibonacciHeap<T, max_heap>;
-
-    template <typename T>
-    using MinFibonacciHeap = FibonacciHeap<T, min_heap>;
-}
+#pragma once
+
+#include "Heap.hpp"
+#include "NodePool.hpp"
+#include <string.h>
+#include <limits.h>
+#include <iterator>
+#include <vector>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * A root of degree k always has at least F(k+2) nodes below it, so the largest degree that can show up is the
+    * largest k with F(k+2) <= UINT_MAX.  Sizing the degree array from that means it never needs to grow.
+    ***************************************************************************************************************/
+    static constexpr unsigned int FibonacciMaxDegree()
+    {
+        unsigned long long fib_prev = 1;
+        unsigned long long fib = 2;
+        unsigned int degree = 0;
+
+        // fib is F(degree + 3) at the top of each iteration
+        while (fib <= UINT_MAX)
+        {
+            unsigned long long next = fib + fib_prev;
+            fib_prev = fib;
+            fib = next;
+            ++degree;
+        }
+
+        return degree;
+    }
+
+    template <
+        typename T,
+        template<typename> class Compare
+    >
+    class FibonacciHeap {
+    public:
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            * 
+            * 
+            ***********************************************************************************************************/
+            Node(const T& keyVal): 
+                left(this), 
+                right(this),
+                parent(nullptr),
+                child(nullptr),
+                degree(0), 
+                mark(false), 
+                being_removed(false),
+                dead(false),
+                pooled(false),
+                key(keyVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            * 
+            * 
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->left          = node;
+                node->right         = node;
+                node->parent        = nullptr;
+                node->child         = nullptr;
+                node->degree        = 0;
+                node->mark          = false;
+                node->being_removed = false;
+                node->dead          = false;
+            }
+
+            /***********************************************************************************************************
+            * 
+            * 
+            ***********************************************************************************************************/
+            inline T Key() 
+            { 
+                return key; 
+            }
+
+            /***********************************************************************************************************
+            * Built by InsertBulk, the heap owns the memory so the caller must never delete it
+            * 
+            ***********************************************************************************************************/
+            inline bool Pooled() const
+            {
+                return pooled;
+            }
+
+        private:
+            // Make a friend class so we can access privates directly
+            friend FibonacciHeap;
+
+            Node* left;
+            Node* right;
+            Node* parent;
+            Node* child;
+            int degree;
+            bool mark;
+            bool being_removed;
+            bool dead;
+            bool pooled;
+            T key;
+            //std::string debug_name = "";
+
+        } Node;
+
+        // Helpful using clause for external users
+        using NODE_TYPE = Node*;
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        FibonacciHeap()
+            : FibonacciHeap(false)
+        {
+        }
+
+        /***************************************************************************************************************
+        * When lazy_remove is set, Remove only marks the node dead and leaves it in place.  Dead nodes are unlinked and
+        * deleted by the heap the next time Consolidate sees them as roots, so the caller must not touch a node after
+        * removing it.
+        ***************************************************************************************************************/
+        explicit FibonacciHeap(bool lazy_remove)
+            : m_count(0)
+            , m_dead_count(0)
+            , m_purge_floor(0)
+            , m_top(nullptr)
+            , m_lazy_remove(lazy_remove)
+        {
+            // Consolidate expects every slot to be empty on entry
+            memset(m_degree_array, 0, sizeof(m_degree_array));
+        }
+
+        /***************************************************************************************************************
+        * Builds the heap from [begin, end) with InsertBulk
+        * 
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        FibonacciHeap(Iterator begin, Iterator end)
+            : FibonacciHeap(false)
+        {
+            InsertBulk(begin, end);
+        }
+
+        ~FibonacciHeap()
+        {
+            // Delete all nodes
+            Clear(m_top);
+
+            if (m_cut_parents.capacity())
+            {
+                m_memory.Freed(m_cut_parents.capacity() * sizeof(NODE_TYPE));
+            }
+
+            // The pool goes with us
+            m_memory.Freed(m_pool.Bytes(), m_pool.Blocks());
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        FibonacciHeap(FibonacciHeap&) = delete;
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        FibonacciHeap& operator=(const FibonacciHeap&) = delete;
+
+        /***************************************************************************************************************
+        * Steals the root list of heap, heap is left empty
+        * 
+        ***************************************************************************************************************/
+        FibonacciHeap(FibonacciHeap&& heap)
+            : FibonacciHeap(heap.m_lazy_remove)
+        {
+            Merge(heap);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        FibonacciHeap& operator=(FibonacciHeap&& heap)
+        {
+            if (this != &heap)
+            {
+                // Drop whatever we had.  Pooled nodes stay allocated until we're destroyed, the caller may still hold
+                // some of them
+                Clear(m_top);
+                m_top = nullptr;
+                m_count = 0;
+                m_dead_count = 0;
+                m_purge_floor = 0;
+
+                m_lazy_remove = heap.m_lazy_remove;
+                Merge(heap);
+            }
+
+            return *this;
+        }
+
+        /***************************************************************************************************************
+         *
+         *
+         ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+         *
+         *
+         ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * Lazily removed nodes still linked in, and pooled nodes that were extracted, are live but not used
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const T& value)
+        {
+            // Create the new node
+            CountAllocation<T>();
+            NODE_TYPE new_node = new Node(value);
+            m_memory.Allocated(sizeof(Node));
+
+            InsertImpl(new_node);
+            return new_node;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            // The heap owns it again, a pooled node never stopped being part of the pool
+            if (!node->pooled)
+            {
+                m_memory.Adopted(sizeof(Node));
+            }
+
+            // Insert into our root list
+            InsertImpl(node);
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        * Builds a node for every value in [begin, end) in a single allocation and splices them all into the root list
+        * at once.  Returns the first node, the rest follow it in the same order as the range.
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        NODE_TYPE InsertBulk(Iterator begin, Iterator end)
+        {
+            size_t count = (size_t)std::distance(begin, end);
+
+            NODE_TYPE nodes = m_pool.Allocate(begin, count);
+            if (!nodes)
+            {
+                return nodes;
+            }
+
+            // One block for the lot
+            CountAllocation<T>();
+            m_memory.Allocated(NodePool<Node>::BlockBytes(count));
+
+            // Thread them into one circular list, picking out the best as we go
+            NODE_TYPE best = nodes;
+            for (size_t i = 0; i < count; ++i)
+            {
+                NODE_TYPE node = nodes + i;
+
+                node->pooled = true;
+                node->left = nodes + (i ? i - 1 : count - 1);
+                node->right = nodes + (i + 1 == count ? 0 : i + 1);
+
+                if (m_heap_property(node->key, best->key))
+                {
+                    best = node;
+                }
+            }
+
+            m_top = MergeImpl(m_top, best);
+            m_count += (unsigned int)count;
+
+            return nodes;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void Merge(FibonacciHeap& heap)
+        {
+            // Merging with ourselves would just orphan everything
+            if (this == &heap)
+            {
+                return;
+            }
+
+            // Merge the two heaps, this is just a splice of the two root lists
+            m_top = MergeImpl(m_top, heap.m_top);
+
+            // Update the count
+            m_count += heap.m_count;
+            m_dead_count += heap.m_dead_count;
+
+            // Their pooled nodes are ours now
+            m_pool.Steal(heap.m_pool);
+            m_memory.Steal(heap.m_memory, heap.m_cut_parents.capacity() * sizeof(NODE_TYPE));
+
+            // Invalidate the heap that was given to us
+            heap.m_top = nullptr;
+            heap.m_count = 0;
+            heap.m_dead_count = 0;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            // Just return to the user
+            return m_top;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            NODE_TYPE top = ExtractTopImpl();
+            Disown(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const T& value)
+        {
+            AugmentKeyImpl(node, value);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            // The top has to stay live, so it always goes through the eager path
+            if (m_lazy_remove && node != m_top)
+            {
+                RemoveLazyImpl(node);
+                return;
+            }
+
+            // if the node being removed is not the top, make it the top
+            if (node != m_top)
+            {
+                node->being_removed = true;
+                AugmentKeyImpl(node, node->key);;
+            }
+            
+            // Remove the node
+            NODE_TYPE removed = ExtractTopImpl();
+
+            // Lazy removal owns what it removes, the top included
+            if (!m_lazy_remove)
+            {
+                Disown(removed);
+            }
+            else if (!removed->pooled)
+            {
+                delete removed;
+                m_memory.Freed(sizeof(Node));
+            }
+        }
+
+        /***************************************************************************************************************
+        * Apply a batch of key changes with a single cascading cut pass.  Iterator must dereference to something with
+        * ->first being a NODE_TYPE and ->second being the new key, e.g. std::pair<NODE_TYPE, T>.
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        void BatchAugmentKey(Iterator begin, Iterator end)
+        {
+            // Validate everything first so a bad key leaves the heap untouched
+            for (Iterator iter = begin; iter != end; ++iter)
+            {
+                if (!m_heap_property(iter->second, iter->first->key))
+                {
+                    throw Datastructures::Heaps::Exceptions::InvalidKeyException<T>(iter->second);
+                }
+            }
+
+            // Reuse the parent buffer between batches
+            m_cut_parents.clear();
+            size_t capacity = m_cut_parents.capacity();
+
+            // Pass 1: update keys and cut anything that now violates its parent, remembering who lost a child
+            for (Iterator iter = begin; iter != end; ++iter)
+            {
+                NODE_TYPE node = iter->first;
+                node->key = iter->second;
+
+                NODE_TYPE parent = node->parent;
+                if (parent && m_heap_property(node->key, parent->key))
+                {
+                    Cut(node, parent);
+                    m_cut_parents.push_back(parent);
+                }
+            }
+
+            m_memory.Reallocated(capacity * sizeof(NODE_TYPE), m_cut_parents.capacity() * sizeof(NODE_TYPE));
+
+            // Pass 2: one cascading cut per parent that lost a child.  A parent that lost two children in this batch
+            // gets marked by the first and cut by the second, same as if the updates had been applied one at a time
+            for (NODE_TYPE parent : m_cut_parents)
+            {
+                CascadingCut(parent);
+            }
+
+            // Pass 3: only roots can beat the current top
+            for (Iterator iter = begin; iter != end; ++iter)
+            {
+                NODE_TYPE node = iter->first;
+                if (!node->parent && m_heap_property(node->key, m_top->key))
+                {
+                    m_top = node;
+                }
+            }
+        }
+
+        /***************************************************************************************************************
+        * Discard every dead root.  Called automatically when dead nodes outnumber live ones so a workload that never
+        * extracts doesn't hold on to cancelled nodes forever.
+        ***************************************************************************************************************/
+        void Purge()
+        {
+            if (!m_top || !m_dead_count)
+            {
+                return;
+            }
+
+            DiscardDeadRoots();
+            UpdateMax();
+        }
+
+    private:
+        /***************************************************************************************************************
+        * node is the caller's from here on, unless it's pooled, the pool still holds its memory
+        *
+        ***************************************************************************************************************/
+        void Disown(NODE_TYPE node)
+        {
+            if (node && !node->pooled)
+            {
+                m_memory.Disowned(sizeof(Node));
+            }
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void InsertImpl(NODE_TYPE new_node)
+        {
+            // Combine our lists
+            m_top = MergeImpl(m_top, new_node);
+
+            // Update our count
+            ++m_count;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void RemoveLazyImpl(NODE_TYPE node)
+        {
+            // Just flag it, Consolidate will unlink it once it's a root
+            node->dead = true;
+
+            --m_count;
+            ++m_dead_count;
+
+            // Dead nodes below the root list survive a purge, so back off to keep this amortized
+            if (m_dead_count > m_count && m_dead_count > m_purge_floor)
+            {
+                Purge();
+                m_purge_floor = m_dead_count << 1;
+            }
+        }
+
+        /***************************************************************************************************************
+        * Unlink and delete every dead node in the root list.  Children of a dead root are spliced in right behind it, so
+        * they are visited by the same walk.
+        ***************************************************************************************************************/
+        void DiscardDeadRoots()
+        {
+            NODE_TYPE iter = m_top;
+            NODE_TYPE last = m_top->left;
+            bool done = false;
+
+            while (!done && iter)
+            {
+                done = (iter == last);
+                NODE_TYPE next = iter->right;
+
+                if (iter->dead)
+                {
+                    NODE_TYPE child = iter->child;
+                    if (child)
+                    {
+                        OrphanAll(child);
+
+                        // Splice the children in between iter and next
+                        NODE_TYPE child_last = child->left;
+                        iter->right = child;
+                        child->left = iter;
+                        child_last->right = next;
+                        next->left = child_last;
+
+                        // If iter was the end of the list, the children are the new end
+                        if (done)
+                        {
+                            last = child_last;
+                            done = false;
+                        }
+
+                        next = child;
+                    }
+
+                    // iter was the only root left
+                    if (iter->right == iter)
+                    {
+                        m_top = nullptr;
+                        next = nullptr;
+                    }
+                    else
+                    {
+                        RemoveFromCircularList(iter);
+                        if (m_top == iter)
+                        {
+                            m_top = iter->right;
+                        }
+                    }
+
+                    --m_dead_count;
+                    if (!iter->pooled)
+                    {
+                        delete iter;
+                        m_memory.Freed(sizeof(Node));
+                    }
+                }
+
+                iter = next;
+            }
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void RemoveFromCircularList(NODE_TYPE node)
+        {
+            // Node is only thing in circular list
+            if (node->right == node)
+            {
+                return;
+            }
+
+            // Swap left and right pointers
+            node->left->right = node->right;
+            node->right->left = node->left;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE MergeImpl(NODE_TYPE main, NODE_TYPE secondary)
+        {
+            // There is no main, secondary becomes main
+            if (!main)
+            {
+                return secondary;
+            }
+
+            // There is no secondary, main stays untouched
+            if (!secondary)
+            {
+                return main;
+            }
+
+            // Ensure that the node returned is always the max/min
+            if (m_heap_property(secondary->key, main->key))
+            {
+                std::swap(main, secondary);
+            }
+
+            // Store temporary pointers
+            NODE_TYPE main_right = main->right;
+            NODE_TYPE secondary_left = secondary->left;
+
+            // Link the two lists
+            main->right = secondary;
+            secondary->left = main;
+
+            // Fill in the gaps
+            main_right->left = secondary_left;
+            secondary_left->right = main_right;
+
+            return main;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTopImpl()
+        {
+            NODE_TYPE top = m_top;
+
+            // We have no max pointer
+            if (!top)
+            {
+                return top;
+            }
+
+            // Orphan all children of max
+            OrphanAll(top->child);
+
+            // Merge all children into top level list
+            MergeImpl(top, top->child);
+
+            // Remove max from circular list
+            RemoveFromCircularList(top);
+
+            // If top is the only thing in the list, top is now null
+            if (top == top->right)
+            {
+                m_top = nullptr;
+            }
+            // Just move top to the right, and handle updating it in the consolidate function
+            else
+            {
+                m_top = top->right;
+                Consolidate();
+            }
+
+            --m_count;
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void OrphanAll(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return;
+            }
+
+            NODE_TYPE iter = node;
+            do 
+            {
+                iter->parent = nullptr;
+                iter = iter->right;
+            } while (iter != node);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void Consolidate()
+        {
+            // Get rid of anything that was lazily removed before linking trees together
+            if (m_dead_count)
+            {
+                DiscardDeadRoots();
+
+                // Everything left was dead
+                if (!m_top)
+                {
+                    return;
+                }
+            }
+
+            NODE_TYPE parent = m_top;
+            bool quit = false;
+
+            while (!quit)
+            {
+                int d = parent->degree;
+                while (m_degree_array[d] != nullptr) 
+                {
+                    NODE_TYPE child = m_degree_array[d];
+
+                    // this is our exit condition.  All things have been consolidated
+                    if (child == parent) 
+                    {
+                        quit = true;
+                        break;
+                    }
+
+                    if (m_heap_property(child->key, parent->key)) 
+                    {
+                        std::swap(parent, child);
+                    }
+
+                    MakeChild(child, parent);
+                    m_degree_array[d++] = nullptr;
+                }
+                if (!quit) 
+                {
+                    m_degree_array[parent->degree] = parent;
+                    parent = parent->right;
+                }
+            }
+
+            // Update the max node
+            m_top = parent;
+            UpdateMax();
+
+            // The only slots still filled belong to the remaining roots, so clear them on the way out instead of
+            // wiping the whole array on the way in
+            NODE_TYPE iter = m_top;
+            do
+            {
+                m_degree_array[iter->degree] = nullptr;
+                iter = iter->right;
+            } while (iter != m_top);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void MakeChild(NODE_TYPE child, NODE_TYPE parent)
+        {
+            RemoveFromCircularList(child);
+            child->left = child;
+            child->right = child;
+            child->parent = parent;
+            parent->child = MergeImpl(parent->child, child);
+            child->mark = false;
+            ++parent->degree;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void AugmentKeyImpl(NODE_TYPE node, const T& k)
+        {
+            // If the being_removed flag is set, then this guy is being removed.
+            if (!node->being_removed && !m_heap_property(k, node->key))
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<T>(k);
+            }
+
+            // Update the nodes value
+            node->key = k;
+
+            NODE_TYPE parent = node->parent;
+
+            // The node being updated is larger than the parent, or this node is being removed
+            if (parent && (node->being_removed || m_heap_property(node->key, parent->key)))
+            {
+                // Do the cutting
+                Cut(node, parent);
+                CascadingCut(parent);
+            }
+
+            // Update the top pointer if new node is larger or being removed
+            if (node->being_removed || m_heap_property(node->key, m_top->key))
+            {
+                m_top = node;
+            }
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void Cut(NODE_TYPE child, NODE_TYPE parent)
+        {
+            RemoveFromCircularList(child);
+
+            // Update the parent child pointer node
+            if (child->right == child) 
+            {
+                parent->child = nullptr;
+            } else 
+            {
+                parent->child = child->right;
+            }
+
+            // Decrement the degree of y
+            --parent->degree;
+
+            // Merge impl requires that the circular linked list be valid, so set left/right pointers to self
+            child->left = child;
+            child->right = child;
+
+            // Add x to the root list
+            MergeImpl(m_top, child);
+
+            // Reset x's pointers
+            child->parent = nullptr;
+            child->mark = false;
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void CascadingCut(NODE_TYPE node)
+        {
+            // Get the childs parent
+            NODE_TYPE parent = node->parent;
+
+            // We have no parents, done
+            if (!parent) 
+            {
+                return;
+            }
+
+            // If the parent is not marked, mark it
+            if (!node->mark) 
+            {
+                node->mark = true;
+            } 
+            else 
+            {
+                // cut the child from the parent
+                Cut(node, parent);
+                CascadingCut(parent);
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void UpdateMax()
+        {
+            NODE_TYPE start = m_top;
+            NODE_TYPE iter = m_top;
+            do
+            {
+                if (m_heap_property(iter->key, m_top->key))
+                {
+                    m_top = iter;
+                }
+
+                iter = iter->right;
+            } while (iter != start);
+        }
+
+        /***************************************************************************************************************
+        * 
+        * 
+        ***************************************************************************************************************/
+        void Clear(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return;
+            }
+
+            NODE_TYPE iter = node;
+            do
+            {
+                NODE_TYPE tmp = iter;
+                iter = iter->right;
+
+                Clear(tmp->child);
+                if (!tmp->pooled)
+                {
+                    delete tmp;
+                    m_memory.Freed(sizeof(Node));
+                }
+
+            } while (iter != node);
+        }
+
+        // How many things are in this heap
+        unsigned int m_count;
+
+        // How many lazily removed nodes are still linked into the trees
+        unsigned int m_dead_count;
+
+        // Dead count that has to be exceeded before Remove purges again
+        unsigned int m_purge_floor;
+
+        // Scratch space for consolidate, indexed by degree
+        NODE_TYPE m_degree_array[FibonacciMaxDegree() + 1];
+
+        // Top of the heap
+        NODE_TYPE m_top;
+
+        // Remove only marks nodes dead when set
+        bool m_lazy_remove;
+
+        // Parents that lost a child during BatchAugmentKey, kept around so batches don't allocate
+        std::vector<NODE_TYPE> m_cut_parents;
+
+        // Backing memory for every node built by InsertBulk
+        NodePool<Node> m_pool;
+
+        MemoryTracker m_memory;
+
+        // Comparison function to determine max/min heap
+        Compare<T> m_heap_property;
+    };
+
+    template <typename T>
+    using MaxFibonacciHeap = FibonacciHeap<T, max_heap>;
+
+    template <typename T>
+    using MinFibonacciHeap = FibonacciHeap<T, min_heap>;
+}
 }
\ No newline at end of file
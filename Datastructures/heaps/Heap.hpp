@@ -1,17 +1,44 @@
-#pragma once
-
-#include "HeapExceptions.hpp"
-
-#include <algorithm>
-
-namespace Datastructures
-{
-namespace Heaps
-{
-    template<typename T>
-    using max_heap = std::greater<T>;
-
-    template<typename T>
-    using min_heap = std::less<T>;
-}
+#pragma once
+
+#include "HeapExceptions.hpp"
+#include "OperationCounts.hpp"
+#include "../MemoryTracker.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+// Stands in for the exceptions on unchecked heaps, so misuse still trips in Debug and costs nothing otherwise
+#ifdef DEBUG
+#define HEAP_ASSERT(condition) assert(condition)
+#else
+#define HEAP_ASSERT(condition) ((void)0)
+#endif
+
+namespace Datastructures
+{
+namespace Heaps
+{
+    template<typename T>
+    using max_heap = std::greater<T>;
+
+    template<typename T>
+    using min_heap = std::less<T>;
+
+    // Same orderings, counting every comparison into Operations()
+    template<typename T>
+    using counting_max_heap = CountingCompare<T, max_heap>;
+
+    template<typename T>
+    using counting_min_heap = CountingCompare<T, min_heap>;
+
+    // Whether a heap validates its arguments and throws, or trusts the caller
+    enum class HeapChecks
+    {
+        // Bad indices, bad keys and empty heaps throw from HeapExceptions.hpp
+        Checked,
+
+        // Nothing is validated outside of HEAP_ASSERT
+        Unchecked
+    };
+}
 }
\ No newline at end of file
@@ -1,108 +1,114 @@
-#pragma once
-
-#include <exception>
-#include <sstream>
-
-namespace Datastructures
-{
-namespace Heaps
-{
-namespace Exceptions
-{
-    /***************************************************************************************************************
-     *
-     *
-     ***************************************************************************************************************/
-    template<typename T>
-    class InvalidKeyException : public std::exception
-    {
-      public:
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        InvalidKeyException(const T &invalid_key) : m_key(invalid_key) {}
-
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        virtual const char *what() const throw()
-        {
-            std::stringstream ss;
-            ss << "Invalid key given: " << m_key;
-            return ss.str().c_str();
-        }
-
-      private:
-        T m_key;
-    };
-
-    /***************************************************************************************************************
-     *
-     *
-     ***************************************************************************************************************/
-    class NullNodeException : public std::exception
-    {
-      public:
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        virtual const char *what() const throw()
-        {
-            std::stringstream ss;
-            ss << "Supplied Node* was nullptr";
-            return ss.str().c_str();
-        }
-    };
-
-    /***************************************************************************************************************
-     *
-     *
-     ***************************************************************************************************************/
-    class InvalidIndexException : public std::exception
-    {
-    public:
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        InvalidIndexException(const size_t &invalid_index) : m_index(invalid_index) {}
-
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        virtual const char *what() const throw()
-        {
-            std::stringstream ss;
-            ss << "Supplied Index was invalid: " << m_index;
-            return ss.str().c_str();
-        }
-
-    private:
-        size_t m_index;
-    };
-
-    /***************************************************************************************************************
-     *
-     *
-     ***************************************************************************************************************/
-    class UnderflowException : public std::exception
-    {
-    public:
-        /***********************************************************************************************************
-         *
-         *
-         ***********************************************************************************************************/
-        virtual const char* what() const throw()
-        {
-            std::stringstream ss;
-            ss << "The heap is empty";
-            return ss.str().c_str();
-        }
-    };
-    }
-}
+#pragma once
+
+#include <exception>
+#include <sstream>
+#include <string>
+
+namespace Datastructures
+{
+namespace Heaps
+{
+namespace Exceptions
+{
+    /***************************************************************************************************************
+     *
+     *
+     ***************************************************************************************************************/
+    template<typename T>
+    class InvalidKeyException : public std::exception
+    {
+      public:
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        InvalidKeyException(const T &invalid_key) : m_key(invalid_key)
+        {
+            // Built up front, what() can't hand out a pointer into a temporary
+            std::stringstream ss;
+            ss << "Invalid key given: " << m_key;
+            m_message = ss.str();
+        }
+
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        virtual const char *what() const throw()
+        {
+            return m_message.c_str();
+        }
+
+      private:
+        T m_key;
+        std::string m_message;
+    };
+
+    /***************************************************************************************************************
+     *
+     *
+     ***************************************************************************************************************/
+    class NullNodeException : public std::exception
+    {
+      public:
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        virtual const char *what() const throw()
+        {
+            return "Supplied Node* was nullptr";
+        }
+    };
+
+    /***************************************************************************************************************
+     *
+     *
+     ***************************************************************************************************************/
+    class InvalidIndexException : public std::exception
+    {
+    public:
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        InvalidIndexException(const size_t &invalid_index) : m_index(invalid_index)
+        {
+            std::stringstream ss;
+            ss << "Supplied Index was invalid: " << m_index;
+            m_message = ss.str();
+        }
+
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        virtual const char *what() const throw()
+        {
+            return m_message.c_str();
+        }
+
+    private:
+        size_t m_index;
+        std::string m_message;
+    };
+
+    /***************************************************************************************************************
+     *
+     *
+     ***************************************************************************************************************/
+    class UnderflowException : public std::exception
+    {
+    public:
+        /***********************************************************************************************************
+         *
+         *
+         ***********************************************************************************************************/
+        virtual const char* what() const throw()
+        {
+            return "The heap is empty";
+        }
+    };
+    }
+}
 }
\ No newline at end of file
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "BinaryHeap.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Relaxed concurrent priority queue (Rihani, Sanders, Dementiev).  Elements are spread over c * p sequential
+    * BinaryHeaps, each behind its own lock.  Insert goes to a random heap, and ExtractTop peeks at the tops of two
+    * random heaps and pops from the better one.  ExtractTop is not guaranteed to return the global top, only
+    * something close to it, which is what lets it scale past a handful of threads.
+    ***************************************************************************************************************/
+    template <
+        typename T,
+        template<typename> class Compare
+    >
+    class MultiQueue
+    {
+        // Tops are published through std::atomic<T> so other threads can peek without locking
+        static_assert(std::is_trivially_copyable<T>::value, "MultiQueue requires a trivially copyable T");
+
+    public:
+
+        // Helpful using clause for external users
+        using NODE_TYPE = T;
+
+        /***************************************************************************************************************
+        * threads is the number of threads expected to hit the queue, queues_per_thread is the c in c * p
+        *
+        ***************************************************************************************************************/
+        explicit MultiQueue(unsigned int threads = std::thread::hardware_concurrency(), unsigned int queues_per_thread = 2)
+            : m_queues(std::max(1u, threads) * std::max(1u, queues_per_thread))
+        {
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        MultiQueue(MultiQueue&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        MultiQueue(MultiQueue&&) = delete;
+
+        /***************************************************************************************************************
+        * Only a snapshot, other threads may change it before the caller looks at it
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            for (const Queue& queue : m_queues)
+            {
+                if (queue.count.load(std::memory_order_relaxed))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /***************************************************************************************************************
+        * Only a snapshot, other threads may change it before the caller looks at it
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            unsigned int count = 0;
+            for (const Queue& queue : m_queues)
+            {
+                count += queue.count.load(std::memory_order_relaxed);
+            }
+
+            return count;
+        }
+
+        /***************************************************************************************************************
+        * Sum over the sub queues plus the array of queues itself, only meaningful while no other thread is using the
+        * queue.  The peak is the sum of the sub queue peaks, which can be above anything the queue ever held at once.
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            MemoryUsage total;
+            total.live_bytes = m_queues.capacity() * sizeof(Queue);
+            total.peak_bytes = total.live_bytes;
+            total.allocations = 1;
+
+            for (const Queue& queue : m_queues)
+            {
+                MemoryUsage stats = queue.heap.MemoryStats();
+                total.live_bytes += stats.live_bytes;
+                total.used_bytes += stats.used_bytes;
+                total.peak_bytes += stats.peak_bytes;
+                total.allocations += stats.allocations;
+                total.frees += stats.frees;
+                total.elements += stats.elements;
+            }
+
+            return total;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Insert(const T& value)
+        {
+            while (true)
+            {
+                Queue& queue = m_queues[Random() % m_queues.size()];
+
+                // Somebody else has it, just go somewhere else
+                if (!queue.lock.try_lock())
+                {
+                    continue;
+                }
+
+                queue.heap.Insert(value);
+                Publish(queue);
+
+                queue.lock.unlock();
+                return;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        T ExtractTop()
+        {
+            std::optional<T> top = TryExtractTop();
+
+            if (!top)
+            {
+                throw Exceptions::UnderflowException();
+            }
+
+            return *top;
+        }
+
+        /***************************************************************************************************************
+        * Returns std::nullopt only when every queue was seen empty
+        *
+        ***************************************************************************************************************/
+        std::optional<T> TryExtractTop()
+        {
+            const size_t size = m_queues.size();
+
+            while (true)
+            {
+                size_t first = Random() % size;
+                size_t second = Random() % size;
+
+                bool first_empty = !m_queues[first].count.load(std::memory_order_acquire);
+                bool second_empty = !m_queues[second].count.load(std::memory_order_acquire);
+
+                size_t target;
+                if (first_empty && second_empty)
+                {
+                    // Both samples were empty, fall back to a sweep so we can tell an empty queue from bad luck
+                    if (!FindNonEmpty(target))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else if (first_empty)
+                {
+                    target = second;
+                }
+                else if (second_empty)
+                {
+                    target = first;
+                }
+                else
+                {
+                    // Two-choice, pop from whichever top is better
+                    T first_top = m_queues[first].top.load(std::memory_order_relaxed);
+                    T second_top = m_queues[second].top.load(std::memory_order_relaxed);
+                    target = m_heap_property(second_top, first_top) ? second : first;
+                }
+
+                Queue& queue = m_queues[target];
+                if (!queue.lock.try_lock())
+                {
+                    continue;
+                }
+
+                // It may have been drained between the peek and the lock
+                if (queue.heap.Empty())
+                {
+                    queue.lock.unlock();
+                    continue;
+                }
+
+                T top = queue.heap.ExtractTop();
+                Publish(queue);
+
+                queue.lock.unlock();
+                return top;
+            }
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        * Padded out to a cache line so neighbouring locks don't false share
+        *
+        ***************************************************************************************************************/
+        struct alignas(64) Queue
+        {
+            Queue() :
+                count(0),
+                top(T())
+            {
+            }
+
+            // Every pop is already behind an emptiness check, so the heap doesn't need its own
+            std::mutex lock;
+            BinaryHeap<T, Compare, HeapChecks::Unchecked> heap;
+
+            // Copies of the heap's state that can be read without taking the lock
+            std::atomic<unsigned int> count;
+            std::atomic<T> top;
+        };
+
+        /***************************************************************************************************************
+        * Must be called with the queue locked
+        *
+        ***************************************************************************************************************/
+        static void Publish(Queue& queue)
+        {
+            if (!queue.heap.Empty())
+            {
+                queue.top.store(queue.heap.Top(), std::memory_order_relaxed);
+            }
+
+            queue.count.store(queue.heap.Count(), std::memory_order_release);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool FindNonEmpty(size_t& target) const
+        {
+            const size_t size = m_queues.size();
+            const size_t start = Random() % size;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                size_t index = (start + i) % size;
+                if (m_queues[index].count.load(std::memory_order_acquire))
+                {
+                    target = index;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /***************************************************************************************************************
+        * xorshift per thread, so picking a queue never touches shared state
+        *
+        ***************************************************************************************************************/
+        static inline size_t Random()
+        {
+            static thread_local unsigned long long state =
+                std::hash<std::thread::id>()(std::this_thread::get_id()) | 1ull;
+
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            return (size_t)state;
+        }
+
+        // The sequential heaps, never resized after construction
+        std::vector<Queue> m_queues;
+
+        // Comparison function to determine max/min heap
+        Compare<T> m_heap_property;
+    };
+
+    template<typename T>
+    using MaxMultiQueue = MultiQueue<T, max_heap>;
+
+    template<typename T>
+    using MinMultiQueue = MultiQueue<T, min_heap>;
+}
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Owns the nodes a heap builds in bulk.  Every call to Allocate gets a single block holding all of its nodes,
+    * and blocks are kept in an intrusive list with a tail pointer so one pool can take over another's blocks in
+    * O(1) when heaps are merged.  Nodes in a block are only destroyed when the pool is, so they must never be
+    * deleted one at a time.
+    ***************************************************************************************************************/
+    template <typename Node>
+    class NodePool
+    {
+        static_assert(alignof(Node) <= alignof(std::max_align_t), "NodePool can't place over aligned nodes");
+
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NodePool()
+            : m_head(nullptr),
+            m_tail(nullptr)
+        {
+        }
+
+        ~NodePool()
+        {
+            Block* iter = m_head;
+            while (iter)
+            {
+                Block* next = iter->next;
+                Destroy(iter, iter->count);
+                iter = next;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NodePool(NodePool&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NodePool& operator=(const NodePool&) = delete;
+
+        /***************************************************************************************************************
+        * Builds one node per value in [begin, begin + count), in order, and returns the first of them
+        *
+        ***************************************************************************************************************/
+        template<typename Iterator>
+        Node* Allocate(Iterator begin, size_t count)
+        {
+            if (!count)
+            {
+                return nullptr;
+            }
+
+            Block* block = static_cast<Block*>(::operator new(BlockBytes(count)));
+            block->next = nullptr;
+            block->count = count;
+
+            Node* nodes = Nodes(block);
+
+            size_t built = 0;
+            try
+            {
+                for (; built < count; ++built, ++begin)
+                {
+                    new (nodes + built) Node(*begin);
+                }
+            }
+            catch (...)
+            {
+                // Only tear down what actually got built
+                Destroy(block, built);
+                throw;
+            }
+
+            if (m_tail)
+            {
+                m_tail->next = block;
+            }
+            else
+            {
+                m_head = block;
+            }
+
+            m_tail = block;
+
+            return nodes;
+        }
+
+        /***************************************************************************************************************
+        * What one Allocate of count nodes takes from the allocator, header and alignment padding included
+        *
+        ***************************************************************************************************************/
+        static constexpr size_t BlockBytes(size_t count)
+        {
+            return NodeOffset() + count * sizeof(Node);
+        }
+
+        /***************************************************************************************************************
+        * Everything the pool holds from the allocator, and in how many blocks
+        *
+        ***************************************************************************************************************/
+        size_t Bytes() const
+        {
+            size_t bytes = 0;
+            for (Block* iter = m_head; iter; iter = iter->next)
+            {
+                bytes += BlockBytes(iter->count);
+            }
+
+            return bytes;
+        }
+
+        size_t Blocks() const
+        {
+            size_t blocks = 0;
+            for (Block* iter = m_head; iter; iter = iter->next)
+            {
+                ++blocks;
+            }
+
+            return blocks;
+        }
+
+        /***************************************************************************************************************
+        * Takes every block pool owns, pool is left empty
+        *
+        ***************************************************************************************************************/
+        void Steal(NodePool& pool)
+        {
+            if (this == &pool || !pool.m_head)
+            {
+                return;
+            }
+
+            if (m_tail)
+            {
+                m_tail->next = pool.m_head;
+            }
+            else
+            {
+                m_head = pool.m_head;
+            }
+
+            m_tail = pool.m_tail;
+
+            pool.m_head = nullptr;
+            pool.m_tail = nullptr;
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        * Header for a block, the nodes follow it in the same allocation
+        *
+        ***************************************************************************************************************/
+        struct Block
+        {
+            Block* next;
+            size_t count;
+        };
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static constexpr size_t NodeOffset()
+        {
+            // Round the header up so the first node is properly aligned
+            return (sizeof(Block) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline Node* Nodes(Block* block)
+        {
+            return reinterpret_cast<Node*>(reinterpret_cast<char*>(block) + NodeOffset());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static void Destroy(Block* block, size_t built)
+        {
+            Node* nodes = Nodes(block);
+            for (size_t i = 0; i < built; ++i)
+            {
+                nodes[i].~Node();
+            }
+
+            ::operator delete(block);
+        }
+
+        // Oldest and newest blocks
+        Block* m_head;
+        Block* m_tail;
+    };
+}
+}
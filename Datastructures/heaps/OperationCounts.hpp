@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * What the counting types below saw on this thread since the last ResetOperations
+    *
+    ***************************************************************************************************************/
+    struct OperationCounts
+    {
+        // Calls through a CountingCompare
+        size_t comparisons = 0;
+
+        // Swaps of two Counted values
+        size_t swaps = 0;
+
+        // Copies and moves of Counted values, construction and assignment alike
+        size_t moves = 0;
+
+        // Node, buffer and container allocations made for Counted values
+        size_t allocations = 0;
+    };
+
+    inline OperationCounts& Operations()
+    {
+        thread_local OperationCounts s_counts;
+        return s_counts;
+    }
+
+    inline void ResetOperations()
+    {
+        Operations() = OperationCounts();
+    }
+
+    /***************************************************************************************************************
+    * Drop in stand in for T that counts every copy, move and swap made of it.  It converts to and from T implicitly,
+    * so keys still compare, add and print like a T does, and the heaps and sorters don't have to know it's there.
+    * Counting is switched on at compile time by using Counted<T> in place of T, plain T pays nothing for any of this.
+    ***************************************************************************************************************/
+    template<typename T>
+    class Counted
+    {
+    public:
+        Counted() :
+            m_value()
+        {
+        }
+
+        Counted(const T& value) :
+            m_value(value)
+        {
+        }
+
+        Counted(const Counted& rhs) :
+            m_value(rhs.m_value)
+        {
+            ++Operations().moves;
+        }
+
+        Counted(Counted&& rhs) :
+            m_value(std::move(rhs.m_value))
+        {
+            ++Operations().moves;
+        }
+
+        Counted& operator=(const Counted& rhs)
+        {
+            ++Operations().moves;
+            m_value = rhs.m_value;
+            return *this;
+        }
+
+        Counted& operator=(Counted&& rhs)
+        {
+            ++Operations().moves;
+            m_value = std::move(rhs.m_value);
+            return *this;
+        }
+
+        operator const T&() const
+        {
+            return m_value;
+        }
+
+        const T& Value() const
+        {
+            return m_value;
+        }
+
+        /***********************************************************************************************************
+        * Found through ADL by the unqualified swap calls, so one swap counts as a swap and not as three moves
+        *
+        ***********************************************************************************************************/
+        friend void swap(Counted& lhs, Counted& rhs)
+        {
+            ++Operations().swaps;
+
+            using std::swap;
+            swap(lhs.m_value, rhs.m_value);
+        }
+
+    private:
+        T m_value;
+    };
+
+    template<typename T>
+    struct IsCounted : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsCounted<Counted<T>> : std::true_type
+    {
+    };
+
+    /***************************************************************************************************************
+    * Called wherever a structure allocates on behalf of its values, compiles to nothing unless T is a Counted
+    *
+    ***************************************************************************************************************/
+    template<typename T>
+    inline void CountAllocation()
+    {
+        if constexpr (IsCounted<T>::value)
+        {
+            ++Operations().allocations;
+        }
+    }
+
+    /***************************************************************************************************************
+    * Wraps any of the Compare templates the heaps and sorters take and counts each call.  It's a template of T alone
+    * through the aliases below, so it can be handed over anywhere max_heap or min_heap can.
+    ***************************************************************************************************************/
+    template<typename T, template<typename> class Compare>
+    struct CountingCompare : Compare<T>
+    {
+        bool operator()(const T& lhs, const T& rhs) const
+        {
+            ++Operations().comparisons;
+            return Compare<T>::operator()(lhs, rhs);
+        }
+    };
+
+    /***************************************************************************************************************
+    * Standard allocator that counts its allocations, for the containers the sorters are handed and build their
+    * scratch space from, e.g. std::vector<Counted<int>, CountingAllocator<Counted<int>>>
+    ***************************************************************************************************************/
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&)
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            ++Operations().allocations;
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t)
+        {
+            ::operator delete(p);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U>&) const
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const CountingAllocator<U>&) const
+        {
+            return false;
+        }
+    };
+}
+}
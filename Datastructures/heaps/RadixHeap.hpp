@@ -0,0 +1,487 @@
+#pragma once
+
+#include "Heap.hpp"
+
+#include <limits>
+#include <type_traits>
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Monotone min heap for integer keys (Ahuja, Mehlhorn, Orlin, Tarjan).  Bucket 0 holds nodes equal to the last
+    * extracted key, bucket i holds nodes whose highest bit that differs from it is bit i - 1.  Only the first non
+    * empty bucket is ever redistributed, and every node moves down at most once per bit, so ExtractTop is amortized
+    * O(bits) with no comparisons against other nodes.  Top only looks: when bucket 0 is empty it walks the next bucket
+    * for its smallest key and leaves the buckets as they are.
+    *
+    * Keys can never go below the last key handed out by ExtractTop.  Insert and AugmentKey throw InvalidKeyException
+    * if asked to.
+    ***************************************************************************************************************/
+    template <
+        typename KeyType,
+        typename ValueType = KeyType
+    >
+    class RadixHeap
+    {
+        static_assert(std::is_integral<KeyType>::value, "RadixHeap requires an integral key");
+
+        // Keys are bucketed by their bits, signed keys get their sign bit flipped so ordering survives
+        using Bits = typename std::make_unsigned<KeyType>::type;
+
+        static const unsigned int BITS = std::numeric_limits<Bits>::digits;
+
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const KeyType& keyVal, const ValueType& valueVal)
+                : prev(nullptr), next(nullptr), bucket(0), key(keyVal), value(valueVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->prev      = nullptr;
+                node->next      = nullptr;
+                node->bucket    = 0;
+            }
+
+            inline KeyType Key() const
+            {
+                return key;
+            }
+
+            inline const ValueType& Value() const
+            {
+                return value;
+            }
+
+        private:
+            friend RadixHeap;
+
+            Node* prev;
+            Node* next;
+            unsigned int bucket;
+            KeyType key;
+            ValueType value;
+
+        } Node;
+
+        // Helpful using clauses for external users
+        using NODE_TYPE = Node*;
+        using KEY_TYPE = KeyType;
+        using VALUE_TYPE = ValueType;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RadixHeap()
+            : m_count(0),
+            m_last(std::numeric_limits<KeyType>::min()),
+            m_occupied(0)
+        {
+            for (unsigned int i = 0; i <= BITS; ++i)
+            {
+                m_buckets[i] = nullptr;
+            }
+        }
+
+        ~RadixHeap()
+        {
+            // Delete all nodes
+            for (unsigned int i = 0; i <= BITS; ++i)
+            {
+                NODE_TYPE iter = m_buckets[i];
+                while (iter)
+                {
+                    NODE_TYPE tmp = iter;
+                    iter = iter->next;
+                    delete tmp;
+                    m_memory.Freed(sizeof(Node));
+                }
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RadixHeap(RadixHeap&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RadixHeap(RadixHeap&&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * One node per element, the buckets live inside the heap itself
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key)
+        {
+            return Insert(key, ValueType());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key, const ValueType& value)
+        {
+            CheckMonotone(key);
+
+            // Create the new node
+            NODE_TYPE new_node = new Node(key, value);
+            m_memory.Allocated(sizeof(Node));
+
+            return InsertImpl(new_node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            CheckMonotone(node->key);
+
+            m_memory.Adopted(sizeof(Node));
+
+            return InsertImpl(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            // Anything equal to the last extracted key is a top
+            if (m_buckets[0])
+            {
+                return m_buckets[0];
+            }
+
+            // Otherwise it's the smallest key in the lowest bucket, which only ExtractTop gets to pull apart
+            NODE_TYPE top = m_buckets[LowestOccupied()];
+            for (NODE_TYPE iter = top->next; iter; iter = iter->next)
+            {
+                if (iter->key < top->key)
+                {
+                    top = iter;
+                }
+            }
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            // We have no top
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            // Only handing a key out moves the reference point up to it
+            Settle();
+            NODE_TYPE top = m_buckets[0];
+
+            Unlink(top);
+            --m_count;
+
+            // The caller's from here on
+            m_memory.Disowned(sizeof(Node));
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const KeyType& key)
+        {
+            // Only decreases are allowed
+            if (!(key < node->key))
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<KeyType>(key);
+            }
+
+            CheckMonotone(key);
+
+            // Just move it to whatever bucket the new key belongs in
+            Unlink(node);
+            node->key = key;
+            Push(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            Unlink(node);
+            --m_count;
+
+            m_memory.Disowned(sizeof(Node));
+
+            Node::Clear(node);
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE InsertImpl(NODE_TYPE node)
+        {
+            Push(node);
+            ++m_count;
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline Bits ToBits(const KeyType& key)
+        {
+            // Flip the sign bit so negative keys sort below positive ones
+            if (std::is_signed<KeyType>::value)
+            {
+                return (Bits)key ^ ((Bits)1 << (BITS - 1));
+            }
+
+            return (Bits)key;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline unsigned int BitWidth(Bits bits)
+        {
+            unsigned int width = 0;
+            while (bits)
+            {
+                bits >>= 1;
+                ++width;
+            }
+
+            return width;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        inline unsigned int BucketIndex(const KeyType& key) const
+        {
+            return BitWidth(ToBits(key) ^ ToBits(m_last));
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void CheckMonotone(const KeyType& key) const
+        {
+            if (key < m_last)
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<KeyType>(key);
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Push(NODE_TYPE node)
+        {
+            unsigned int index = BucketIndex(node->key);
+
+            node->bucket = index;
+            node->prev = nullptr;
+            node->next = m_buckets[index];
+
+            if (node->next)
+            {
+                node->next->prev = node;
+            }
+
+            m_buckets[index] = node;
+
+            if (index)
+            {
+                m_occupied |= (1ull << (index - 1));
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Unlink(NODE_TYPE node)
+        {
+            unsigned int index = node->bucket;
+
+            if (node->prev)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                m_buckets[index] = node->next;
+            }
+
+            if (node->next)
+            {
+                node->next->prev = node->prev;
+            }
+
+            if (index && !m_buckets[index])
+            {
+                m_occupied &= ~(1ull << (index - 1));
+            }
+        }
+
+        /***************************************************************************************************************
+        * Lowest non empty bucket past bucket 0, there has to be one
+        *
+        ***************************************************************************************************************/
+        unsigned int LowestOccupied() const
+        {
+            unsigned int index = 1;
+            unsigned long long occupied = m_occupied;
+            while (!(occupied & 1ull))
+            {
+                occupied >>= 1;
+                ++index;
+            }
+
+            return index;
+        }
+
+        /***************************************************************************************************************
+        * Make sure bucket 0 holds the top, pulling the next non empty bucket apart if it doesn't
+        *
+        ***************************************************************************************************************/
+        void Settle()
+        {
+            if (m_buckets[0])
+            {
+                return;
+            }
+
+            unsigned int index = LowestOccupied();
+
+            // Its smallest key becomes the new reference point
+            NODE_TYPE bucket = m_buckets[index];
+            NODE_TYPE iter = bucket;
+            m_last = iter->key;
+            while (iter)
+            {
+                if (iter->key < m_last)
+                {
+                    m_last = iter->key;
+                }
+
+                iter = iter->next;
+            }
+
+            m_buckets[index] = nullptr;
+            m_occupied &= ~(1ull << (index - 1));
+
+            // Everything in the bucket now shares more high bits with m_last, so it all lands in lower buckets
+            iter = bucket;
+            while (iter)
+            {
+                NODE_TYPE next = iter->next;
+                Push(iter);
+                iter = next;
+            }
+        }
+
+        // How many things are in this heap
+        unsigned int m_count;
+
+        // Last key pulled out, nothing can go below it
+        KeyType m_last;
+
+        // Bit i set when bucket i + 1 is non empty
+        unsigned long long m_occupied;
+
+        // One bucket for each possible highest differing bit, plus bucket 0 for equal keys
+        NODE_TYPE m_buckets[BITS + 1];
+
+        MemoryTracker m_memory;
+    };
+}
+}
@@ -0,0 +1,544 @@
+#pragma once
+
+#include "Heap.hpp"
+#include <string.h>
+
+namespace Datastructures {
+namespace Heaps {
+
+    // Rank rule used when a decrease key walks back up the tree
+    enum class RankPairingType
+    {
+        // Rank goes up only when both children have the same rank
+        Type1,
+
+        // Rank goes up whenever the children's ranks are within one of each other
+        Type2
+    };
+
+    /***************************************************************************************************************
+    * Rank-pairing heap (Haeupler, Sen, Tarjan).  Every tree is a half tree stored as a binary tree: a root only has
+    * a left child, and the right spine of that child holds the root's children.  Roots live in a circular list
+    * threaded through their right pointers, and ExtractTop does a single pass of same-rank links.
+    ***************************************************************************************************************/
+    template <
+        typename T,
+        template<typename> class Compare,
+        RankPairingType Type
+    >
+    class RankPairingHeap
+    {
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const T& keyVal)
+                : left(nullptr), right(nullptr), parent(nullptr), rank(0), key(keyVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->left      = nullptr;
+                node->right     = nullptr;
+                node->parent    = nullptr;
+                node->rank      = 0;
+            }
+
+            inline T Key() const
+            {
+                return key;
+            }
+
+        private:
+            friend RankPairingHeap;
+
+            Node* left;
+            Node* right;
+            Node* parent;
+            int rank;
+            T key;
+
+        } Node;
+
+        // Helpful using clause for external users
+        using NODE_TYPE = Node*;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RankPairingHeap()
+            : m_count(0),
+            m_top(nullptr)
+        {
+            // ExtractTop expects every bucket to be empty on entry
+            memset(m_buckets, 0, sizeof(m_buckets));
+        }
+
+        ~RankPairingHeap()
+        {
+            // Delete all nodes
+            if (m_top)
+            {
+                NODE_TYPE iter = m_top->right;
+                m_top->right = nullptr;
+                Clear(iter);
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RankPairingHeap(RankPairingHeap&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        RankPairingHeap(RankPairingHeap&&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * One node per element and nothing else, the rank buckets live inside the heap itself
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const T& value)
+        {
+            // Create the new node
+            CountAllocation<T>();
+            NODE_TYPE new_node = new Node(value);
+            m_memory.Allocated(sizeof(Node));
+
+            // A single node is a half tree of rank 0
+            AddRoot(new_node);
+            ++m_count;
+
+            return new_node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            m_memory.Adopted(sizeof(Node));
+
+            // A single node is a half tree of rank 0
+            AddRoot(node);
+
+            ++m_count;
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Merge(RankPairingHeap& heap)
+        {
+            // Merging with ourselves would just orphan everything
+            if (this == &heap || !heap.m_top)
+            {
+                return;
+            }
+
+            if (!m_top)
+            {
+                m_top = heap.m_top;
+            }
+            else
+            {
+                // Splice the two circular root lists together
+                std::swap(m_top->right, heap.m_top->right);
+
+                if (m_heap_property(heap.m_top->key, m_top->key))
+                {
+                    m_top = heap.m_top;
+                }
+            }
+
+            // Update the count
+            m_count += heap.m_count;
+            m_memory.Steal(heap.m_memory);
+
+            // Invalidate the heap that was given to us
+            heap.m_top = nullptr;
+            heap.m_count = 0;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top()
+        {
+            // Just return to the user
+            return m_top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            NODE_TYPE top = ExtractTopImpl();
+
+            // The caller's from here on
+            if (top)
+            {
+                m_memory.Disowned(sizeof(Node));
+            }
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const T& value)
+        {
+            if (!m_heap_property(value, node->key))
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<T>(value);
+            }
+
+            // Update the nodes value
+            node->key = value;
+
+            // Anything that isn't a root gets cut loose into the root list
+            if (node->parent)
+            {
+                CutToRoot(node);
+            }
+
+            if (m_heap_property(node->key, m_top->key))
+            {
+                m_top = node;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            // Cut it loose, then pretend it's the top and extract it.  ExtractTop rescans every root, so the real top is
+            // found again afterwards
+            if (node->parent)
+            {
+                CutToRoot(node);
+            }
+
+            m_top = node;
+            ExtractTopImpl();
+
+            m_memory.Disowned(sizeof(Node));
+        }
+
+    private:
+
+        // Ranks are bounded by log_phi(n), this is plenty for a 32 bit count
+        static const unsigned int MAX_RANK = 64;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline int Rank(NODE_TYPE node)
+        {
+            // Missing children have rank -1
+            return node ? node->rank : -1;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline int RankRule(int left, int right)
+        {
+            int high = std::max(left, right);
+
+            if (Type == RankPairingType::Type1)
+            {
+                return (left == right) ? high + 1 : high;
+            }
+
+            int difference = left - right;
+            return (difference >= -1 && difference <= 1) ? high + 1 : high;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void AddRoot(NODE_TYPE node)
+        {
+            if (!m_top)
+            {
+                node->right = node;
+                m_top = node;
+                return;
+            }
+
+            // Splice in right after the top
+            node->right = m_top->right;
+            m_top->right = node;
+
+            if (m_heap_property(node->key, m_top->key))
+            {
+                m_top = node;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Link(NODE_TYPE first, NODE_TYPE second)
+        {
+            NODE_TYPE winner = first;
+            NODE_TYPE loser = second;
+
+            if (m_heap_property(second->key, first->key))
+            {
+                std::swap(winner, loser);
+            }
+
+            // Loser becomes the left child of the winner, and the old left child hangs off the loser's right
+            loser->right = winner->left;
+            if (loser->right)
+            {
+                loser->right->parent = loser;
+            }
+
+            winner->left = loser;
+            loser->parent = winner;
+
+            winner->rank = loser->rank + 1;
+
+            return winner;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void CutToRoot(NODE_TYPE node)
+        {
+            NODE_TYPE parent = node->parent;
+            NODE_TYPE replacement = node->right;
+
+            // The node's right subtree takes its place under the parent
+            if (parent->left == node)
+            {
+                parent->left = replacement;
+            }
+            else
+            {
+                parent->right = replacement;
+            }
+
+            if (replacement)
+            {
+                replacement->parent = parent;
+            }
+
+            // The node is now the root of a half tree
+            node->parent = nullptr;
+            node->rank = Rank(node->left) + 1;
+
+            AddRoot(node);
+
+            // Walk back up lowering ranks until nothing changes
+            NODE_TYPE iter = parent;
+            while (iter)
+            {
+                int rank = iter->parent ? RankRule(Rank(iter->left), Rank(iter->right)) : Rank(iter->left) + 1;
+
+                if (rank >= iter->rank)
+                {
+                    break;
+                }
+
+                iter->rank = rank;
+                iter = iter->parent;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Bucket(NODE_TYPE node)
+        {
+            int rank = node->rank;
+
+            // One pass only, a linked pair goes straight to the root list and isn't linked again
+            if (m_buckets[rank])
+            {
+                NODE_TYPE linked = Link(m_buckets[rank], node);
+                m_buckets[rank] = nullptr;
+                AddRoot(linked);
+            }
+            else
+            {
+                m_buckets[rank] = node;
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTopImpl()
+        {
+            NODE_TYPE top = m_top;
+
+            // We have no top
+            if (!top)
+            {
+                return top;
+            }
+
+            // Rebuild the root list from scratch
+            m_top = nullptr;
+
+            // Every other root
+            NODE_TYPE iter = top->right;
+            while (iter != top)
+            {
+                NODE_TYPE next = iter->right;
+                iter->right = nullptr;
+                Bucket(iter);
+                iter = next;
+            }
+
+            // The right spine of the top's left child are the top's children, each becomes a half tree
+            iter = top->left;
+            while (iter)
+            {
+                NODE_TYPE next = iter->right;
+                iter->right = nullptr;
+                iter->parent = nullptr;
+                iter->rank = Rank(iter->left) + 1;
+                Bucket(iter);
+                iter = next;
+            }
+
+            // Whatever didn't find a partner goes back as is
+            for (unsigned int i = 0; i < MAX_RANK; ++i)
+            {
+                if (m_buckets[i])
+                {
+                    AddRoot(m_buckets[i]);
+                    m_buckets[i] = nullptr;
+                }
+            }
+
+            --m_count;
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Clear(NODE_TYPE node)
+        {
+            while (node)
+            {
+                NODE_TYPE tmp = node;
+                node = node->right;
+
+                Clear(tmp->left);
+                delete tmp;
+                m_memory.Freed(sizeof(Node));
+            }
+        }
+
+        // How many things are in this heap
+        unsigned int m_count;
+
+        // Top of the heap, and an entry point into the circular root list
+        NODE_TYPE m_top;
+
+        // Scratch space for ExtractTop, indexed by rank
+        NODE_TYPE m_buckets[MAX_RANK];
+
+        MemoryTracker m_memory;
+
+        // Comparison function to determine max/min heap
+        Compare<T> m_heap_property;
+    };
+
+    template <typename T>
+    using MaxRankPairingHeapT1 = RankPairingHeap<T, max_heap, RankPairingType::Type1>;
+
+    template <typename T>
+    using MinRankPairingHeapT1 = RankPairingHeap<T, min_heap, RankPairingType::Type1>;
+
+    template <typename T>
+    using MaxRankPairingHeapT2 = RankPairingHeap<T, max_heap, RankPairingType::Type2>;
+
+    template <typename T>
+    using MinRankPairingHeapT2 = RankPairingHeap<T, min_heap, RankPairingType::Type2>;
+}
+}
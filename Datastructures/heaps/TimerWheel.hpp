@@ -0,0 +1,497 @@
+#pragma once
+
+#include "Heap.hpp"
+
+#include <limits>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Datastructures {
+namespace Heaps {
+
+    /***************************************************************************************************************
+    * Hierarchical timing wheel (Varghese, Lauck) for integer expiry times.  Every level has 64 slots, one per 6 bit
+    * digit of the key.  A timer lives on the level of the highest digit where its key differs from the current time,
+    * in the slot for that digit, so Insert and Remove are O(1) list splices.  Each level keeps a bitmap of its non
+    * empty slots and the wheel keeps a bitmap of its non empty levels, so finding the next timer is a couple of bit
+    * scans.  When the lowest non empty level isn't level 0, its first slot is cascaded down a level, and every timer
+    * cascades at most once per level.
+    *
+    * Expiry times can never go below the last key handed out by ExtractTop, Insert and AugmentKey throw
+    * InvalidKeyException if asked to.  Top only looks, so it never narrows what can still be inserted.  AugmentKey
+    * reschedules in either direction.
+    ***************************************************************************************************************/
+    template <
+        typename KeyType,
+        typename ValueType = KeyType
+    >
+    class TimerWheel
+    {
+        static_assert(std::is_integral<KeyType>::value, "TimerWheel requires an integral key");
+
+        // Keys are slotted by their bits, signed keys get their sign bit flipped so ordering survives
+        using Bits = typename std::make_unsigned<KeyType>::type;
+
+        static const unsigned int BITS = std::numeric_limits<Bits>::digits;
+        static const unsigned int SLOT_BITS = 6;
+        static const unsigned int SLOTS = 1u << SLOT_BITS;
+        static const unsigned int LEVELS = (BITS + SLOT_BITS - 1) / SLOT_BITS;
+
+    public:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        typedef struct Node
+        {
+        public:
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            Node(const KeyType& keyVal, const ValueType& valueVal)
+                : prev(nullptr), next(nullptr), level(0), slot(0), key(keyVal), value(valueVal)
+            {
+            }
+
+            /***********************************************************************************************************
+            *
+            *
+            ***********************************************************************************************************/
+            static void Clear(Node* node)
+            {
+                if (!node) { return; }
+
+                node->prev      = nullptr;
+                node->next      = nullptr;
+                node->level     = 0;
+                node->slot      = 0;
+            }
+
+            inline KeyType Key() const
+            {
+                return key;
+            }
+
+            inline const ValueType& Value() const
+            {
+                return value;
+            }
+
+        private:
+            friend TimerWheel;
+
+            Node* prev;
+            Node* next;
+            unsigned int level;
+            unsigned int slot;
+            KeyType key;
+            ValueType value;
+
+        } Node;
+
+        // Helpful using clauses for external users
+        using NODE_TYPE = Node*;
+        using KEY_TYPE = KeyType;
+        using VALUE_TYPE = ValueType;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        TimerWheel()
+            : m_count(0),
+            m_now(ToBits(std::numeric_limits<KeyType>::min())),
+            m_levels(0)
+        {
+            for (unsigned int level = 0; level < LEVELS; ++level)
+            {
+                m_occupied[level] = 0;
+                for (unsigned int slot = 0; slot < SLOTS; ++slot)
+                {
+                    m_slots[level][slot] = nullptr;
+                }
+            }
+        }
+
+        ~TimerWheel()
+        {
+            // Delete all nodes
+            for (unsigned int level = 0; level < LEVELS; ++level)
+            {
+                for (unsigned int slot = 0; slot < SLOTS; ++slot)
+                {
+                    NODE_TYPE iter = m_slots[level][slot];
+                    while (iter)
+                    {
+                        NODE_TYPE tmp = iter;
+                        iter = iter->next;
+                        delete tmp;
+                        m_memory.Freed(sizeof(Node));
+                    }
+                }
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        TimerWheel(TimerWheel&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        TimerWheel(TimerWheel&&) = delete;
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        bool Empty() const
+        {
+            return !m_count;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        unsigned int Count() const
+        {
+            return m_count;
+        }
+
+        /***************************************************************************************************************
+        * One node per element, the slots live inside the wheel itself
+        *
+        ***************************************************************************************************************/
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage((size_t)m_count * sizeof(Node), m_count);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key)
+        {
+            return Insert(key, ValueType());
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(const KeyType& key, const ValueType& value)
+        {
+            CheckMonotone(key);
+
+            // Create the new node
+            NODE_TYPE new_node = new Node(key, value);
+            m_memory.Allocated(sizeof(Node));
+
+            return InsertImpl(new_node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Insert(NODE_TYPE node)
+        {
+            if (!node)
+            {
+                return node;
+            }
+
+            CheckMonotone(node->key);
+
+            m_memory.Adopted(sizeof(Node));
+
+            return InsertImpl(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE Top() const
+        {
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            // Every slot on level 0 holds a single key, and none of them are behind the current time
+            if (m_occupied[0])
+            {
+                return m_slots[0][LowestBit(m_occupied[0])];
+            }
+
+            // Otherwise the top is somewhere in the first slot of the lowest level, which only ExtractTop cascades
+            unsigned int level = LowestBit(m_levels);
+            NODE_TYPE top = m_slots[level][LowestBit(m_occupied[level])];
+            for (NODE_TYPE iter = top->next; iter; iter = iter->next)
+            {
+                if (iter->key < top->key)
+                {
+                    top = iter;
+                }
+            }
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE ExtractTop()
+        {
+            // We have no top
+            if (!m_count)
+            {
+                return nullptr;
+            }
+
+            Settle();
+
+            NODE_TYPE top = m_slots[0][LowestBit(m_occupied[0])];
+
+            // Move the current time up to the top, nothing on level 0 is behind it and nothing above level 0 moves
+            m_now = ToBits(top->key);
+
+            Unlink(top);
+            --m_count;
+
+            // The caller's from here on
+            m_memory.Disowned(sizeof(Node));
+
+            // Invalidate top that is returned
+            Node::Clear(top);
+
+            return top;
+        }
+
+        /***************************************************************************************************************
+        * Reschedule, the new key can be earlier or later than the old one
+        *
+        ***************************************************************************************************************/
+        void AugmentKey(NODE_TYPE node, const KeyType& key)
+        {
+            CheckMonotone(key);
+
+            Unlink(node);
+            node->key = key;
+            Push(node);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Remove(NODE_TYPE node)
+        {
+            Unlink(node);
+            --m_count;
+
+            m_memory.Disowned(sizeof(Node));
+
+            Node::Clear(node);
+        }
+
+    private:
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        NODE_TYPE InsertImpl(NODE_TYPE node)
+        {
+            Push(node);
+            ++m_count;
+
+            // Return back to caller
+            return node;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline Bits ToBits(const KeyType& key)
+        {
+            // Flip the sign bit so negative keys sort below positive ones
+            if (std::is_signed<KeyType>::value)
+            {
+                return (Bits)key ^ ((Bits)1 << (BITS - 1));
+            }
+
+            return (Bits)key;
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline unsigned int LowestBit(unsigned long long bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, bits);
+            return (unsigned int)index;
+#else
+            return (unsigned int)__builtin_ctzll(bits);
+#endif
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        static inline unsigned int HighestBit(unsigned long long bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, bits);
+            return (unsigned int)index;
+#else
+            return 63u - (unsigned int)__builtin_clzll(bits);
+#endif
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void CheckMonotone(const KeyType& key) const
+        {
+            if (ToBits(key) < m_now)
+            {
+                throw Datastructures::Heaps::Exceptions::InvalidKeyException<KeyType>(key);
+            }
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Push(NODE_TYPE node)
+        {
+            Bits bits = ToBits(node->key);
+            Bits difference = bits ^ m_now;
+
+            // Highest digit that differs from the current time, equal keys go on level 0
+            unsigned int level = difference ? HighestBit(difference) / SLOT_BITS : 0;
+            unsigned int slot = (unsigned int)(bits >> (level * SLOT_BITS)) & (SLOTS - 1);
+
+            node->level = level;
+            node->slot = slot;
+            node->prev = nullptr;
+            node->next = m_slots[level][slot];
+
+            if (node->next)
+            {
+                node->next->prev = node;
+            }
+
+            m_slots[level][slot] = node;
+
+            m_occupied[level] |= (1ull << slot);
+            m_levels |= (1ull << level);
+        }
+
+        /***************************************************************************************************************
+        *
+        *
+        ***************************************************************************************************************/
+        void Unlink(NODE_TYPE node)
+        {
+            unsigned int level = node->level;
+            unsigned int slot = node->slot;
+
+            if (node->prev)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                m_slots[level][slot] = node->next;
+            }
+
+            if (node->next)
+            {
+                node->next->prev = node->prev;
+            }
+
+            if (!m_slots[level][slot])
+            {
+                m_occupied[level] &= ~(1ull << slot);
+                if (!m_occupied[level])
+                {
+                    m_levels &= ~(1ull << level);
+                }
+            }
+        }
+
+        /***************************************************************************************************************
+        * Cascade until level 0 has something on it
+        *
+        ***************************************************************************************************************/
+        void Settle()
+        {
+            while (!m_occupied[0])
+            {
+                unsigned int level = LowestBit(m_levels);
+                unsigned int slot = LowestBit(m_occupied[level]);
+
+                NODE_TYPE bucket = m_slots[level][slot];
+                m_slots[level][slot] = nullptr;
+                m_occupied[level] &= ~(1ull << slot);
+                if (!m_occupied[level])
+                {
+                    m_levels &= ~(1ull << level);
+                }
+
+                // Jump the current time to the start of the slot.  Everything left on this level is in a later slot
+                // and everything in the slot is at or after the new time, so it all lands on lower levels
+                unsigned int shift = level * SLOT_BITS;
+                Bits high = (shift + SLOT_BITS < BITS) ? (m_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS) : 0;
+                m_now = high | ((Bits)slot << shift);
+
+                NODE_TYPE iter = bucket;
+                while (iter)
+                {
+                    NODE_TYPE next = iter->next;
+                    Push(iter);
+                    iter = next;
+                }
+            }
+        }
+
+        // How many things are in this wheel
+        unsigned int m_count;
+
+        // Current time, stored as bits, nothing can be scheduled before it
+        Bits m_now;
+
+        // Bit i set when level i has anything on it
+        unsigned long long m_levels;
+
+        // Bit i set when slot i of a level is non empty
+        unsigned long long m_occupied[LEVELS];
+
+        // The wheels, one slot per digit on every level
+        NODE_TYPE m_slots[LEVELS][SLOTS];
+
+        MemoryTracker m_memory;
+    };
+}
+}
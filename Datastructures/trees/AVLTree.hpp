@@ -1,300 +1,932 @@
-#pragma once
-
-#include "Tree.hpp"
-#include "BinarySearchTree.hpp"
-
-namespace Datastructures
-{
-namespace Trees
-{   
-    template<
-        typename Type
-    >
-    class AVLTree
-    {
-
-    public:
-
-        struct Node
-        {
-            Node(const Type& data) :
-                left(nullptr),
-                right(nullptr),
-                key(data),
-                height(1),
-                count(1)
-            {
-            }
-
-            bool inline operator <(const Node& rhs) const
-            {
-                return key < rhs.key;
-            }
-
-            bool inline operator >(const Node& rhs) const
-            {
-                return key > rhs.key;
-            }
-
-            bool inline operator <(const Type& rhs) const
-            {
-                return key < rhs;
-            }
-
-            bool inline operator >(const Type& rhs) const
-            {
-                return key > rhs;
-            }
-
-            unsigned int height;
-            unsigned int count;
-
-            Type key;
-
-            Node* left;
-            Node* right;
-        };
-
-        using node_ptr = Node*;
-
-        static inline unsigned int NodeHeight(node_ptr node)
-        {
-            if (!node) { return 0; }
-            return node->height;
-        }
-
-        static inline void UpdateHeight(node_ptr node)
-        {
-            if (!node) { return; }
-            node->height = std::max(AVLTree::NodeHeight(node->left), AVLTree::NodeHeight(node->right)) + 1;
-        }
-
-        static inline int BalanceFactor(node_ptr node)
-        {
-            if (!node) { return 0; }
-            return AVLTree::NodeHeight(node->left) - AVLTree::NodeHeight(node->right);
-        }
-        
-        static node_ptr RR(node_ptr A)
-        {
-            node_ptr B  = A->right;
-            A->right    = B->left;
-            B->left     = A;
-
-            // Update the heights
-            AVLTree::UpdateHeight(A);
-            AVLTree::UpdateHeight(B);
-
-            return B;
-        }
-
-        static node_ptr LL(node_ptr A)
-        {
-            node_ptr B  = A->left;
-            A->left     = B->right;
-            B->right    = A;
-
-            // Update the heights
-            AVLTree::UpdateHeight(A);
-            AVLTree::UpdateHeight(B);
-
-            return B;
-        }
-
-        static node_ptr RL(node_ptr A)
-        {
-            A->right = LL(A->right);
-            return RR(A);
-        }
-
-        static  node_ptr LR(node_ptr A)
-        {
-            A->left = RR(A->left);
-            return LL(A);
-        }
-
-        static node_ptr Insert(node_ptr node, const Type& key, bool& balance)
-        {
-
-            // Current spot is empty, just return it
-            if (!node) { return new Node(key); }
-
-            // We need to search in left tree, node is less than current root
-            if (*node > key)
-            {
-                node->left = Insert(node->left, key, balance);
-            }
-            // We need to search in right tree, node is gets current root
-            else if (*node < key)
-            {
-                node->right = Insert(node->right, key, balance);
-            }
-            else
-            {
-                // Just increment a count.  No need to balance, just return all the way up
-                // The assumption here is that the tree is balanced before the insert.  Incrementing the counter
-                // won't unbalance the trees
-                ++(node->count);
-                balance = false;
-                return node;
-            }
-
-            // If we don't need to balance anymore, just unwind the callstack
-            if (!balance)
-            {
-                return node;
-            }
-
-            // Update the new heights
-            AVLTree::UpdateHeight(node);
-
-            // Get the balance factor of the root
-            int balance_factor = AVLTree::BalanceFactor(node);
-
-            // there is an imbalance on the left side
-            if (balance_factor >= 2)
-            {
-                if (*(node->left) > key)
-                {
-                    node = AVLTree::LL(node);
-                }
-                else
-                {
-                    node = AVLTree::LR(node);
-                }
-
-                // We don't need to balance anymore
-                balance = false;
-            }
-            // there is an imbalance on the right side
-            else if (balance_factor <= -2)
-            {
-                if (*(node->right) < key)
-                {
-                    node = AVLTree::RR(node);
-                }
-                else
-                {
-                    node = AVLTree::RL(node);
-                }
-
-                // We don't need to balance anymore
-                balance = false;
-            }
-            else if (!balance_factor)
-            {
-                // We don't need to balance anymore
-                balance = false;
-            }
-
-            return node;
-        }
-
-        static node_ptr Remove(node_ptr node, const Type& key, bool& balance)
-        {
-            if (!node) { return node; }
-
-            if (*node > key)
-            {
-                node->left = AVLTree::Remove(node->left, key, balance);
-            }
-            else if (*node < key)
-            {
-                node->right = AVLTree::Remove(node->right, key, balance);
-            }
-            else
-            {
-                --(node->count);
-
-                if (node->count)
-                {
-                    balance = false;
-                    return node;
-                }
-
-                if (!node->left)
-                {
-                    node_ptr temp = node->right;
-                    delete node;
-                    return temp;
-                }
-                else if (!node->right)
-                {
-                    node_ptr temp = node->left;
-                    delete node;
-                    return temp;
-                }
-
-                node_ptr temp = BinarySearchTree<Type, AVLTree::Node>::MinValue(node->right);
-                node->key = temp->key;
-                node->right = AVLTree::Remove(node->right, key, balance);
-            }
-
-            if (!node) { return node; }
-
-            // Update the height
-            AVLTree::UpdateHeight(node);
-
-            // Get the balance factor
-            int balance_factor = AVLTree::BalanceFactor(node);
-
-            if (balance_factor >= 2)
-            {
-                int left_balance = AVLTree::BalanceFactor(node->left);
-
-                if (left_balance >= 0)
-                {
-                    node = AVLTree::LL(node);
-                }
-                else if (left_balance < 0)
-                {
-                    node = AVLTree::LR(node);
-                }
-            }
-            else if (balance_factor <= -2)
-            {
-                int right_balance = AVLTree::BalanceFactor(node->right);
-
-                if (right_balance <= 0)
-                {
-                    node = RR(node);
-                }
-                else if (right_balance > 0)
-                {
-                    node = RL(node);
-                }
-            }
-
-            return node;
-        }
-
-    public:
-        AVLTree():
-            m_root(nullptr)
-        {
-
-        }
-
-        AVLTree(AVLTree&&) = delete;
-        AVLTree(AVLTree&) = delete;
-
-        void Insert(const Type& data)
-        {
-            // feed in the boolean to track balancing
-            bool balance = true;
-            m_root = AVLTree::Insert(m_root, data, balance);
-        }
-
-        void Remove(const Type& data)
-        {
-            bool balance = true;
-            AVLTree::Remove(m_root, data, balance);
-        }
-
-    private:
-        
-        // Hold the actual elements
-        node_ptr m_root;
-    };
-}
+#pragma once
+
+#include "Tree.hpp"
+#include "BinarySearchTree.hpp"
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace Datastructures
+{
+namespace Trees
+{   
+    template<
+        typename Type
+    >
+    class AVLTree
+    {
+
+    public:
+
+        struct Node
+        {
+            Node(const Type& data) :
+                height(1),
+                count(1),
+                size(1),
+                nodes(1),
+                key(data),
+                left(nullptr),
+                right(nullptr)
+            {
+            }
+
+            bool inline operator <(const Node& rhs) const
+            {
+                return key < rhs.key;
+            }
+
+            bool inline operator >(const Node& rhs) const
+            {
+                return key > rhs.key;
+            }
+
+            bool inline operator <(const Type& rhs) const
+            {
+                return key < rhs;
+            }
+
+            bool inline operator >(const Type& rhs) const
+            {
+                return key > rhs;
+            }
+
+            unsigned int height;
+            unsigned int count;
+
+            // Every copy of every key in this subtree, duplicates included
+            unsigned int size;
+
+            // Distinct keys in this subtree, one per node
+            unsigned int nodes;
+
+            Type key;
+
+            Node* left;
+            Node* right;
+        };
+
+        using node_ptr = Node*;
+
+        // An AVL tree is never more than 1.44 log2(n) high, so this covers any tree that fits in a 64 bit address space
+        static constexpr unsigned int MAX_HEIGHT = 96;
+
+        // Union, Intersection and Difference fork when both sides of a step hold at least this many copies
+        static constexpr unsigned int PARALLEL_THRESHOLD = 1u << 16;
+
+        static void InOrder(node_ptr node, std::vector<node_ptr>& inorder)
+        {
+            BinarySearchTree<Type, AVLTree::Node>::InOrder(node, inorder);
+        }
+
+        // i-th smallest copy, counting from 1 like OrderStatistic::Search
+        static node_ptr Select(node_ptr node, unsigned int i)
+        {
+            node_ptr iter = node;
+            while (iter)
+            {
+                unsigned int left = AVLTree::NodeSize(iter->left);
+
+                if (i <= left)
+                {
+                    iter = iter->left;
+                }
+                else if (i <= left + iter->count)
+                {
+                    return iter;
+                }
+                else
+                {
+                    i -= left + iter->count;
+                    iter = iter->right;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // How many copies are less than key
+        static unsigned int Rank(node_ptr node, const Type& key)
+        {
+            unsigned int rank = 0;
+
+            node_ptr iter = node;
+            while (iter)
+            {
+                if (*iter < key)
+                {
+                    rank += AVLTree::NodeSize(iter->left) + iter->count;
+                    iter = iter->right;
+                }
+                else
+                {
+                    iter = iter->left;
+                }
+            }
+
+            return rank;
+        }
+
+        static inline unsigned int NodeHeight(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return node->height;
+        }
+
+        static inline void UpdateHeight(node_ptr node)
+        {
+            if (!node) { return; }
+            node->height = std::max(AVLTree::NodeHeight(node->left), AVLTree::NodeHeight(node->right)) + 1;
+        }
+
+        static inline unsigned int NodeSize(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return node->size;
+        }
+
+        static inline unsigned int NodeCount(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return node->nodes;
+        }
+
+        static inline void UpdateSize(node_ptr node)
+        {
+            if (!node) { return; }
+            node->size = AVLTree::NodeSize(node->left) + AVLTree::NodeSize(node->right) + node->count;
+            node->nodes = AVLTree::NodeCount(node->left) + AVLTree::NodeCount(node->right) + 1;
+        }
+
+        static inline int BalanceFactor(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return AVLTree::NodeHeight(node->left) - AVLTree::NodeHeight(node->right);
+        }
+        
+        static node_ptr RR(node_ptr A)
+        {
+            node_ptr B  = A->right;
+            A->right    = B->left;
+            B->left     = A;
+
+            // Update the heights, and the sizes while we're at it
+            AVLTree::UpdateHeight(A);
+            AVLTree::UpdateHeight(B);
+            AVLTree::UpdateSize(A);
+            AVLTree::UpdateSize(B);
+
+            return B;
+        }
+
+        static node_ptr LL(node_ptr A)
+        {
+            node_ptr B  = A->left;
+            A->left     = B->right;
+            B->right    = A;
+
+            // Update the heights, and the sizes while we're at it
+            AVLTree::UpdateHeight(A);
+            AVLTree::UpdateHeight(B);
+            AVLTree::UpdateSize(A);
+            AVLTree::UpdateSize(B);
+
+            return B;
+        }
+
+        static node_ptr RL(node_ptr A)
+        {
+            A->right = LL(A->right);
+            return RR(A);
+        }
+
+        static  node_ptr LR(node_ptr A)
+        {
+            A->left = RR(A->left);
+            return LL(A);
+        }
+
+        // memory, when there is one, is told about the node allocated for a new key
+        static node_ptr Insert(node_ptr node, const Type& key, MemoryTracker* memory = nullptr)
+        {
+            node_ptr path[MAX_HEIGHT];
+            bool went_left[MAX_HEIGHT];
+            unsigned int depth = 0;
+
+            node_ptr iter = node;
+            while (iter)
+            {
+                // The key ends up somewhere below here either way
+                ++(iter->size);
+
+                if (*iter > key)
+                {
+                    went_left[depth] = true;
+                }
+                else if (*iter < key)
+                {
+                    went_left[depth] = false;
+                }
+                else
+                {
+                    // Just increment a count.  No need to balance, the assumption here is that the tree is balanced
+                    // before the insert.  Incrementing the counter won't unbalance the trees
+                    ++(iter->count);
+                    return node;
+                }
+
+                path[depth++] = iter;
+                iter = went_left[depth - 1] ? iter->left : iter->right;
+            }
+
+            // Rebalance on the way back up, child is whatever now roots the subtree below the current node
+            node_ptr child = new Node(key);
+            if (memory) { memory->Allocated(sizeof(Node)); }
+
+            // A new node rather than another copy, so every subtree on the way down gained one
+            for (unsigned int i = 0; i < depth; ++i)
+            {
+                ++(path[i]->nodes);
+            }
+
+            bool balance = true;
+            while (depth)
+            {
+                --depth;
+                node_ptr parent = path[depth];
+
+                if (went_left[depth])
+                {
+                    parent->left = child;
+                }
+                else
+                {
+                    parent->right = child;
+                }
+
+                // Nothing above here changes height, and the root is still the root
+                if (!balance)
+                {
+                    return node;
+                }
+
+                // Update the new heights
+                AVLTree::UpdateHeight(parent);
+
+                // Get the balance factor of the root
+                int balance_factor = AVLTree::BalanceFactor(parent);
+
+                // there is an imbalance on the left side
+                if (balance_factor >= 2)
+                {
+                    if (*(parent->left) > key)
+                    {
+                        parent = AVLTree::LL(parent);
+                    }
+                    else
+                    {
+                        parent = AVLTree::LR(parent);
+                    }
+
+                    // We don't need to balance anymore
+                    balance = false;
+                }
+                // there is an imbalance on the right side
+                else if (balance_factor <= -2)
+                {
+                    if (*(parent->right) < key)
+                    {
+                        parent = AVLTree::RR(parent);
+                    }
+                    else
+                    {
+                        parent = AVLTree::RL(parent);
+                    }
+
+                    // We don't need to balance anymore
+                    balance = false;
+                }
+                else if (!balance_factor)
+                {
+                    // We don't need to balance anymore
+                    balance = false;
+                }
+
+                child = parent;
+            }
+
+            return child;
+        }
+
+        // memory, when there is one, is told about the node freed when the last copy goes
+        static node_ptr Remove(node_ptr node, const Type& key, MemoryTracker* memory = nullptr)
+        {
+            node_ptr path[MAX_HEIGHT];
+            bool went_left[MAX_HEIGHT];
+            unsigned int depth = 0;
+
+            node_ptr iter = node;
+            while (iter && (*iter > key || *iter < key))
+            {
+                went_left[depth] = *iter > key;
+                path[depth++] = iter;
+                iter = went_left[depth - 1] ? iter->left : iter->right;
+            }
+
+            if (!iter) { return node; }
+
+            --(iter->count);
+
+            if (iter->count)
+            {
+                // Only the sizes on the way down change
+                --(iter->size);
+                for (unsigned int i = 0; i < depth; ++i)
+                {
+                    --(path[i]->size);
+                }
+
+                return node;
+            }
+
+            node_ptr child;
+            if (!iter->left || !iter->right)
+            {
+                child = iter->left ? iter->left : iter->right;
+                delete iter;
+            }
+            else
+            {
+                // Prefer successor, and keep it on the path so everything down to it gets fixed up too
+                went_left[depth] = false;
+                path[depth++] = iter;
+
+                node_ptr temp = iter->right;
+                while (temp->left)
+                {
+                    went_left[depth] = true;
+                    path[depth++] = temp;
+                    temp = temp->left;
+                }
+
+                // All of the successor's copies live here now, and it has no left child to worry about
+                iter->key = temp->key;
+                iter->count = temp->count;
+
+                child = temp->right;
+                delete temp;
+            }
+
+            if (memory) { memory->Freed(sizeof(Node)); }
+
+            while (depth)
+            {
+                --depth;
+                node_ptr parent = path[depth];
+
+                if (went_left[depth])
+                {
+                    parent->left = child;
+                }
+                else
+                {
+                    parent->right = child;
+                }
+
+                // Update the height and size
+                AVLTree::UpdateHeight(parent);
+                AVLTree::UpdateSize(parent);
+
+                // Get the balance factor
+                int balance_factor = AVLTree::BalanceFactor(parent);
+
+                if (balance_factor >= 2)
+                {
+                    int left_balance = AVLTree::BalanceFactor(parent->left);
+
+                    if (left_balance >= 0)
+                    {
+                        parent = AVLTree::LL(parent);
+                    }
+                    else
+                    {
+                        parent = AVLTree::LR(parent);
+                    }
+                }
+                else if (balance_factor <= -2)
+                {
+                    int right_balance = AVLTree::BalanceFactor(parent->right);
+
+                    if (right_balance <= 0)
+                    {
+                        parent = AVLTree::RR(parent);
+                    }
+                    else
+                    {
+                        parent = AVLTree::RL(parent);
+                    }
+                }
+
+                child = parent;
+            }
+
+            return child;
+        }
+
+        // Perfectly balanced tree over sorted keys in O(n).  Runs of equal keys fold into one node with a count
+        template<typename Iterator>
+        static node_ptr FromSorted(Iterator begin, Iterator end, MemoryTracker* memory = nullptr)
+        {
+            std::vector<node_ptr> nodes;
+
+            try
+            {
+                for (; begin != end; ++begin)
+                {
+                    if (!nodes.empty() && !(*nodes.back() < *begin))
+                    {
+                        if (*nodes.back() > *begin)
+                        {
+                            throw Exceptions::UnsortedKeyException<Type>(*begin, nodes.back()->key);
+                        }
+
+                        ++(nodes.back()->count);
+                    }
+                    else
+                    {
+                        nodes.push_back(new Node(*begin));
+                    }
+                }
+            }
+            catch (...)
+            {
+                for (node_ptr node : nodes)
+                {
+                    delete node;
+                }
+                throw;
+            }
+
+            if (memory) { memory->Allocated(nodes.size() * sizeof(Node), nodes.size()); }
+
+            return AVLTree::Balanced(nodes, 0, nodes.size());
+        }
+
+        // Every key in left is less than middle->key and every key in right is greater.  Hangs all three together
+        // with one climb down the spine of the taller side, O(|height(left) - height(right)|)
+        static node_ptr Join(node_ptr left, node_ptr middle, node_ptr right)
+        {
+            if (AVLTree::NodeHeight(left) > AVLTree::NodeHeight(right) + 1)
+            {
+                return AVLTree::JoinRight(left, middle, right);
+            }
+
+            if (AVLTree::NodeHeight(right) > AVLTree::NodeHeight(left) + 1)
+            {
+                return AVLTree::JoinLeft(left, middle, right);
+            }
+
+            return AVLTree::Link(left, middle, right);
+        }
+
+        // Join without a middle node, the largest node of left is pulled out to stand in for it
+        static node_ptr Join(node_ptr left, node_ptr right)
+        {
+            if (!left) { return right; }
+
+            node_ptr last;
+            left = AVLTree::SplitLast(left, last);
+
+            return AVLTree::Join(left, last, right);
+        }
+
+        // Breaks node into the keys less than key and the keys greater than it.  The node holding key comes back
+        // detached in found, or nullptr if there isn't one
+        static void Split(node_ptr node, const Type& key, node_ptr& less, node_ptr& found, node_ptr& greater)
+        {
+            if (!node)
+            {
+                less = found = greater = nullptr;
+                return;
+            }
+
+            node_ptr left = node->left;
+            node_ptr right = node->right;
+
+            if (*node > key)
+            {
+                AVLTree::Split(left, key, less, found, greater);
+                greater = AVLTree::Join(greater, node, right);
+            }
+            else if (*node < key)
+            {
+                AVLTree::Split(right, key, less, found, greater);
+                less = AVLTree::Join(left, node, less);
+            }
+            else
+            {
+                less = left;
+                greater = right;
+                found = node;
+                found->left = found->right = nullptr;
+            }
+        }
+
+        // Every copy from both trees, counts add up.  Both trees are consumed.  The set operations fork, so they add up
+        // the nodes they free in deleted, when there is one, for the caller to settle after
+        static node_ptr Union(node_ptr lhs, node_ptr rhs, std::atomic<size_t>* deleted = nullptr)
+        {
+            if (!lhs) { return rhs; }
+            if (!rhs) { return lhs; }
+
+            // Measured up front, splitting takes both trees apart
+            unsigned int size = AVLTree::NodeSize(lhs) + AVLTree::NodeSize(rhs);
+
+            node_ptr less, found, greater;
+            AVLTree::Split(rhs, lhs->key, less, found, greater);
+
+            if (found)
+            {
+                lhs->count += found->count;
+                delete found;
+                AVLTree::Deleted(deleted, 1);
+            }
+
+            node_ptr left, right;
+            AVLTree::Both(
+                [&]() { left = AVLTree::Union(lhs->left, less, deleted); },
+                [&]() { right = AVLTree::Union(lhs->right, greater, deleted); },
+                size
+            );
+
+            return AVLTree::Join(left, lhs, right);
+        }
+
+        // Keys in both trees, with the smaller of the two counts.  Both trees are consumed
+        static node_ptr Intersection(node_ptr lhs, node_ptr rhs, std::atomic<size_t>* deleted = nullptr)
+        {
+            if (!lhs || !rhs)
+            {
+                AVLTree::Deleted(deleted, BinarySearchTree<Type, AVLTree::Node>::Clear(lhs));
+                AVLTree::Deleted(deleted, BinarySearchTree<Type, AVLTree::Node>::Clear(rhs));
+                return nullptr;
+            }
+
+            unsigned int size = AVLTree::NodeSize(lhs) + AVLTree::NodeSize(rhs);
+
+            node_ptr less, found, greater;
+            AVLTree::Split(rhs, lhs->key, less, found, greater);
+
+            node_ptr left, right;
+            AVLTree::Both(
+                [&]() { left = AVLTree::Intersection(lhs->left, less, deleted); },
+                [&]() { right = AVLTree::Intersection(lhs->right, greater, deleted); },
+                size
+            );
+
+            // One of the two nodes goes either way
+            AVLTree::Deleted(deleted, 1);
+
+            if (!found)
+            {
+                delete lhs;
+                return AVLTree::Join(left, right);
+            }
+
+            lhs->count = std::min(lhs->count, found->count);
+            delete found;
+
+            return AVLTree::Join(left, lhs, right);
+        }
+
+        // Copies in lhs less the copies in rhs, keys whose count runs out go away.  Both trees are consumed
+        static node_ptr Difference(node_ptr lhs, node_ptr rhs, std::atomic<size_t>* deleted = nullptr)
+        {
+            if (!lhs || !rhs)
+            {
+                AVLTree::Deleted(deleted, BinarySearchTree<Type, AVLTree::Node>::Clear(rhs));
+                return lhs;
+            }
+
+            unsigned int size = AVLTree::NodeSize(lhs) + AVLTree::NodeSize(rhs);
+
+            node_ptr less, found, greater;
+            AVLTree::Split(lhs, rhs->key, less, found, greater);
+
+            node_ptr left, right;
+            AVLTree::Both(
+                [&]() { left = AVLTree::Difference(less, rhs->left, deleted); },
+                [&]() { right = AVLTree::Difference(greater, rhs->right, deleted); },
+                size
+            );
+
+            unsigned int removed = rhs->count;
+            delete rhs;
+            AVLTree::Deleted(deleted, 1);
+
+            if (!found || found->count <= removed)
+            {
+                delete found;
+                AVLTree::Deleted(deleted, found ? 1 : 0);
+                return AVLTree::Join(left, right);
+            }
+
+            found->count -= removed;
+
+            return AVLTree::Join(left, found, right);
+        }
+
+    public:
+        AVLTree():
+            m_root(nullptr)
+        {
+
+        }
+
+        ~AVLTree()
+        {
+            Free(BinarySearchTree<Type, AVLTree::Node>::Clear(m_root));
+        }
+
+        AVLTree(AVLTree&&) = delete;
+        AVLTree(AVLTree&) = delete;
+
+        void Insert(const Type& data)
+        {
+            m_root = AVLTree::Insert(m_root, data, &m_memory);
+        }
+
+        void Remove(const Type& data)
+        {
+            m_root = AVLTree::Remove(m_root, data, &m_memory);
+        }
+
+        void InOrder(std::vector<node_ptr>& inorder)
+        {
+            AVLTree::InOrder(m_root, inorder);
+        }
+
+        node_ptr Find(const Type& key) const
+        {
+            return BinarySearchTree<Type, AVLTree::Node>::Find(m_root, key);
+        }
+
+        bool Contains(const Type& key) const
+        {
+            return Find(key) != nullptr;
+        }
+
+        // Duplicates are stored once with a count
+        unsigned int Count(const Type& key) const
+        {
+            node_ptr node = Find(key);
+            return node ? node->count : 0;
+        }
+
+        node_ptr LowerBound(const Type& key) const
+        {
+            return BinarySearchTree<Type, AVLTree::Node>::LowerBound(m_root, key);
+        }
+
+        node_ptr UpperBound(const Type& key) const
+        {
+            return BinarySearchTree<Type, AVLTree::Node>::UpperBound(m_root, key);
+        }
+
+        // Every node with a key in [low, high], in order, found as it's walked
+        TreeRange<Type, Node> Range(const Type& low, const Type& high) const
+        {
+            return TreeRange<Type, Node>(m_root, low, high);
+        }
+
+        // Replaces everything in the tree, keys must be sorted
+        template<typename Iterator>
+        void BuildFromSorted(Iterator begin, Iterator end)
+        {
+            node_ptr root = AVLTree::FromSorted(begin, end, &m_memory);
+
+            Free(BinarySearchTree<Type, AVLTree::Node>::Clear(m_root));
+            m_root = root;
+        }
+
+        // Moves every copy in other over, other is left empty
+        void Union(AVLTree& other)
+        {
+            if (this == &other) { return; }
+
+            std::atomic<size_t> deleted(0);
+            m_memory.Steal(other.m_memory);
+
+            m_root = AVLTree::Union(m_root, other.m_root, &deleted);
+            other.m_root = nullptr;
+
+            Free(deleted.load());
+        }
+
+        // Keeps the keys other has too, other is left empty
+        void Intersection(AVLTree& other)
+        {
+            if (this == &other) { return; }
+
+            std::atomic<size_t> deleted(0);
+            m_memory.Steal(other.m_memory);
+
+            m_root = AVLTree::Intersection(m_root, other.m_root, &deleted);
+            other.m_root = nullptr;
+
+            Free(deleted.load());
+        }
+
+        // Takes other's copies away from this tree, other is left empty
+        void Difference(AVLTree& other)
+        {
+            if (this == &other) { return; }
+
+            std::atomic<size_t> deleted(0);
+            m_memory.Steal(other.m_memory);
+
+            m_root = AVLTree::Difference(m_root, other.m_root, &deleted);
+            other.m_root = nullptr;
+
+            Free(deleted.load());
+        }
+
+        // Keeps the keys less than key, everything else moves to greater, replacing what it held
+        void Split(const Type& key, AVLTree& greater)
+        {
+            if (this == &greater) { return; }
+
+            greater.Free(BinarySearchTree<Type, AVLTree::Node>::Clear(greater.m_root));
+
+            node_ptr less, found, high;
+            AVLTree::Split(m_root, key, less, found, high);
+
+            m_root = less;
+            greater.m_root = found ? AVLTree::Join(nullptr, found, high) : high;
+
+            // Every node left behind is still ours, the rest changed hands
+            greater.m_memory.Steal(m_memory, (size_t)AVLTree::NodeCount(m_root) * sizeof(Node));
+        }
+
+        // Every copy, duplicates included
+        unsigned int Size() const
+        {
+            return AVLTree::NodeSize(m_root);
+        }
+
+        // i-th smallest copy, counting from 1, in O(log n).  Incremental counterpart to OrderStatistic::Search, nullptr
+        // when i is 0 or past the end
+        node_ptr Select(unsigned int i) const
+        {
+            if (!i) { return nullptr; }
+
+            return AVLTree::Select(m_root, i);
+        }
+
+        // How many copies are less than key in O(log n), so Select(Rank(key) + 1) is the first copy of key if there is
+        // one
+        unsigned int Rank(const Type& key) const
+        {
+            return AVLTree::Rank(m_root, key);
+        }
+
+        // One node per distinct key, duplicates only bump its count, so every live byte is in use
+        MemoryUsage MemoryStats() const
+        {
+            size_t nodes = m_memory.Live() / sizeof(Node);
+            return m_memory.Usage(m_memory.Live(), nodes);
+        }
+
+    private:
+
+        inline void Free(size_t nodes)
+        {
+            m_memory.Freed(nodes * sizeof(Node), nodes);
+        }
+
+        static inline void Deleted(std::atomic<size_t>* deleted, size_t nodes)
+        {
+            if (deleted && nodes) { deleted->fetch_add(nodes, std::memory_order_relaxed); }
+        }
+
+        static node_ptr Balanced(const std::vector<node_ptr>& nodes, size_t low, size_t high)
+        {
+            if (low >= high) { return nullptr; }
+
+            size_t middle = low + ((high - low) >> 1);
+
+            return AVLTree::Link(
+                AVLTree::Balanced(nodes, low, middle),
+                nodes[middle],
+                AVLTree::Balanced(nodes, middle + 1, high)
+            );
+        }
+
+        static inline node_ptr Link(node_ptr left, node_ptr middle, node_ptr right)
+        {
+            middle->left = left;
+            middle->right = right;
+
+            AVLTree::UpdateHeight(middle);
+            AVLTree::UpdateSize(middle);
+
+            return middle;
+        }
+
+        // left is the taller side, walk down its right spine to a subtree right can sit next to
+        static node_ptr JoinRight(node_ptr left, node_ptr middle, node_ptr right)
+        {
+            node_ptr inner = left->right;
+
+            if (AVLTree::NodeHeight(inner) <= AVLTree::NodeHeight(right) + 1)
+            {
+                node_ptr joined = AVLTree::Link(inner, middle, right);
+
+                if (AVLTree::NodeHeight(joined) <= AVLTree::NodeHeight(left->left) + 1)
+                {
+                    return AVLTree::Link(left->left, left, joined);
+                }
+
+                return AVLTree::RR(AVLTree::Link(left->left, left, AVLTree::LL(joined)));
+            }
+
+            node_ptr joined = AVLTree::JoinRight(inner, middle, right);
+            node_ptr linked = AVLTree::Link(left->left, left, joined);
+
+            if (AVLTree::NodeHeight(joined) <= AVLTree::NodeHeight(left->left) + 1)
+            {
+                return linked;
+            }
+
+            return AVLTree::RR(linked);
+        }
+
+        // Mirror of JoinRight
+        static node_ptr JoinLeft(node_ptr left, node_ptr middle, node_ptr right)
+        {
+            node_ptr inner = right->left;
+
+            if (AVLTree::NodeHeight(inner) <= AVLTree::NodeHeight(left) + 1)
+            {
+                node_ptr joined = AVLTree::Link(left, middle, inner);
+
+                if (AVLTree::NodeHeight(joined) <= AVLTree::NodeHeight(right->right) + 1)
+                {
+                    return AVLTree::Link(joined, right, right->right);
+                }
+
+                return AVLTree::LL(AVLTree::Link(AVLTree::RR(joined), right, right->right));
+            }
+
+            node_ptr joined = AVLTree::JoinLeft(left, middle, inner);
+            node_ptr linked = AVLTree::Link(joined, right, right->right);
+
+            if (AVLTree::NodeHeight(joined) <= AVLTree::NodeHeight(right->right) + 1)
+            {
+                return linked;
+            }
+
+            return AVLTree::LL(linked);
+        }
+
+        // Pulls the largest node out of node, returns what's left
+        static node_ptr SplitLast(node_ptr node, node_ptr& last)
+        {
+            if (!node->right)
+            {
+                last = node;
+                node_ptr left = node->left;
+                last->left = nullptr;
+                return left;
+            }
+
+            node_ptr right = AVLTree::SplitLast(node->right, last);
+
+            return AVLTree::Join(node->left, node, right);
+        }
+
+        // Runs both halves of a set operation, the first on its own thread when there's enough work to pay for one
+        template<typename First, typename Second>
+        static void Both(First first, Second second, unsigned int size)
+        {
+            if (size < PARALLEL_THRESHOLD)
+            {
+                first();
+                second();
+                return;
+            }
+
+            std::future<void> forked = std::async(std::launch::async, first);
+            second();
+            forked.get();
+        }
+
+        // Hold the actual elements
+        node_ptr m_root;
+
+        MemoryTracker m_memory;
+    };
+}
 }
\ No newline at end of file
@@ -0,0 +1,767 @@
+#pragma once
+
+#include "Tree.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BTREE_SSE2
+#endif
+
+namespace Datastructures
+{
+namespace Trees
+{
+    /***************************************************************************************************************
+    * B+tree keyed on unique keys.  Nodes are sized to NodeBytes, so a cache line or a page holds a whole node and a
+    * lookup costs one miss per level instead of one per key compared.  Values only live in the leaves, and the
+    * leaves are linked left to right so in order scans never go back up the tree.
+    *
+    * Searching inside a node narrows down with a branchless binary search, then counts the keys in what's left,
+    * 4 at a time with SSE2 for int keys.
+    ***************************************************************************************************************/
+    template<
+        typename Key,
+        typename Value = Key,
+        size_t NodeBytes = 256
+    >
+    class BTree
+    {
+        // Every node gets one slot past its capacity, so an insert can land first and split after
+        static constexpr size_t HEADER_BYTES = sizeof(void*) + 2 * sizeof(unsigned int);
+
+        static constexpr size_t LeafCapacity()
+        {
+            size_t slots = (NodeBytes - HEADER_BYTES) / (sizeof(Key) + sizeof(Value));
+            return slots > 5 ? slots - 1 : 4;
+        }
+
+        static constexpr size_t InnerCapacity()
+        {
+            size_t slots = (NodeBytes - HEADER_BYTES - sizeof(void*)) / (sizeof(Key) + sizeof(void*));
+            return slots > 5 ? slots - 1 : 4;
+        }
+
+        static constexpr unsigned int LEAF_CAPACITY = (unsigned int)LeafCapacity();
+        static constexpr unsigned int INNER_CAPACITY = (unsigned int)InnerCapacity();
+
+        // Fewest keys a node other than the root can hold
+        static constexpr unsigned int LEAF_MIN = LEAF_CAPACITY / 2;
+        static constexpr unsigned int INNER_MIN = INNER_CAPACITY / 2;
+
+        // Below this many keys, a straight count beats halving
+        static constexpr unsigned int LINEAR_SCAN = 32;
+
+        struct Node
+        {
+            Node(bool is_leaf) :
+                count(0),
+                leaf(is_leaf)
+            {
+            }
+
+            unsigned int count;
+            bool leaf;
+        };
+
+        struct Leaf : public Node
+        {
+            Leaf() :
+                Node(true),
+                next(nullptr)
+            {
+            }
+
+            Key keys[LEAF_CAPACITY + 1];
+            Value values[LEAF_CAPACITY + 1];
+
+            Leaf* next;
+        };
+
+        struct Inner : public Node
+        {
+            Inner() :
+                Node(false)
+            {
+            }
+
+            // keys[i] is the smallest key anywhere under children[i + 1]
+            Key keys[INNER_CAPACITY + 1];
+            Node* children[INNER_CAPACITY + 2];
+        };
+
+    public:
+
+        // What a scan hands back for each key
+        struct Entry
+        {
+            const Key& key;
+            Value& value;
+        };
+
+        class Iterator
+        {
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Entry;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = Entry;
+
+            Iterator() :
+                m_leaf(nullptr),
+                m_index(0),
+                m_high(),
+                m_bounded(false)
+            {
+            }
+
+            Iterator(Leaf* leaf, unsigned int index, const Key* high) :
+                m_leaf(leaf),
+                m_index(index),
+                m_high(high ? *high : Key()),
+                m_bounded(high != nullptr)
+            {
+                Settle();
+            }
+
+            Entry operator*() const
+            {
+                return Entry{ m_leaf->keys[m_index], m_leaf->values[m_index] };
+            }
+
+            Iterator& operator++()
+            {
+                ++m_index;
+                Settle();
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const Iterator& rhs) const
+            {
+                return m_leaf == rhs.m_leaf && m_index == rhs.m_index;
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+
+            // Step over the end of a leaf, and stop for good past high
+            void Settle()
+            {
+                while (m_leaf && m_index >= m_leaf->count)
+                {
+                    m_leaf = m_leaf->next;
+                    m_index = 0;
+                }
+
+                if (m_leaf && m_bounded && m_high < m_leaf->keys[m_index])
+                {
+                    m_leaf = nullptr;
+                    m_index = 0;
+                }
+            }
+
+            Leaf* m_leaf;
+            unsigned int m_index;
+
+            // Last key a range wants, a copy so Between(a, b) on temporaries is fine
+            Key m_high;
+            bool m_bounded;
+        };
+
+        class Range
+        {
+
+        public:
+            Range(Iterator first) :
+                m_first(first)
+            {
+            }
+
+            Iterator begin() const
+            {
+                return m_first;
+            }
+
+            Iterator end() const
+            {
+                return Iterator();
+            }
+
+        private:
+            Iterator m_first;
+        };
+
+        BTree() :
+            m_root(nullptr),
+            m_size(0)
+        {
+        }
+
+        ~BTree()
+        {
+            BTree::Clear(m_root, m_memory);
+        }
+
+        BTree(BTree&&) = delete;
+        BTree(BTree&) = delete;
+
+        size_t Size() const
+        {
+            return m_size;
+        }
+
+        bool Empty() const
+        {
+            return !m_size;
+        }
+
+        // Returns false if the key was already there, its value is overwritten
+        bool Insert(const Key& key)
+        {
+            return Insert(key, Value());
+        }
+
+        // Returns false if the key was already there, its value is overwritten
+        bool Insert(const Key& key, const Value& value)
+        {
+            if (!m_root)
+            {
+                m_root = new Leaf();
+                m_memory.Allocated(sizeof(Leaf));
+            }
+
+            Key split_key;
+            Node* split_node = nullptr;
+
+            bool inserted = BTree::Insert(m_root, key, value, split_key, split_node, m_memory);
+
+            // The root split, grow a level
+            if (split_node)
+            {
+                Inner* root = new Inner();
+                m_memory.Allocated(sizeof(Inner));
+                root->count = 1;
+                root->keys[0] = split_key;
+                root->children[0] = m_root;
+                root->children[1] = split_node;
+
+                m_root = root;
+            }
+
+            if (inserted)
+            {
+                ++m_size;
+            }
+
+            return inserted;
+        }
+
+        // Returns false if the key wasn't there
+        bool Remove(const Key& key)
+        {
+            if (!m_root) { return false; }
+
+            if (!BTree::Remove(m_root, key, m_memory)) { return false; }
+
+            --m_size;
+
+            // The root ran out of separators, its only child takes over
+            if (!m_root->leaf && !m_root->count)
+            {
+                Inner* root = static_cast<Inner*>(m_root);
+                m_root = root->children[0];
+                delete root;
+                m_memory.Freed(sizeof(Inner));
+            }
+            else if (m_root->leaf && !m_root->count)
+            {
+                delete static_cast<Leaf*>(m_root);
+                m_memory.Freed(sizeof(Leaf));
+                m_root = nullptr;
+            }
+
+            return true;
+        }
+
+        // nullptr when the key isn't there
+        Value* Find(const Key& key) const
+        {
+            unsigned int index;
+            Leaf* leaf = BTree::FindLeaf(m_root, key, index);
+
+            if (!leaf || index >= leaf->count || key < leaf->keys[index]) { return nullptr; }
+
+            return &leaf->values[index];
+        }
+
+        bool Contains(const Key& key) const
+        {
+            return Find(key) != nullptr;
+        }
+
+        // Keys are unique, so this is always 0 or 1
+        unsigned int Count(const Key& key) const
+        {
+            return Contains(key) ? 1 : 0;
+        }
+
+        // First key that isn't less than key
+        Iterator LowerBound(const Key& key) const
+        {
+            unsigned int index;
+            Leaf* leaf = BTree::FindLeaf(m_root, key, index);
+
+            return Iterator(leaf, index, nullptr);
+        }
+
+        // First key that is greater than key
+        Iterator UpperBound(const Key& key) const
+        {
+            Iterator iter = LowerBound(key);
+
+            if (iter != End() && !(key < (*iter).key))
+            {
+                ++iter;
+            }
+
+            return iter;
+        }
+
+        Iterator Begin() const
+        {
+            Node* iter = m_root;
+            while (iter && !iter->leaf)
+            {
+                iter = static_cast<Inner*>(iter)->children[0];
+            }
+
+            return Iterator(static_cast<Leaf*>(iter), 0, nullptr);
+        }
+
+        Iterator End() const
+        {
+            return Iterator();
+        }
+
+        // Every key in [low, high], in order, walked along the leaves
+        Range Between(const Key& low, const Key& high) const
+        {
+            unsigned int index;
+            Leaf* leaf = BTree::FindLeaf(m_root, low, index);
+
+            return Range(Iterator(leaf, index, &high));
+        }
+
+        // Used is one key and value per entry, the rest is empty slots in the leaves and the inner nodes above them
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage(m_size * (sizeof(Key) + sizeof(Value)), m_size);
+        }
+
+    private:
+
+        // How many of the first count keys are less than key, or with Inclusive, not greater than key
+        template<bool Inclusive>
+        static inline unsigned int Scan(const Key* keys, unsigned int count, const Key& key)
+        {
+            unsigned int total = 0;
+            unsigned int i = 0;
+
+#ifdef BTREE_SSE2
+            if constexpr (std::is_same<Key, int>::value)
+            {
+                __m128i needle = _mm_set1_epi32(key);
+                __m128i totals = _mm_setzero_si128();
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+
+                    // Matching lanes come back as -1, so subtracting the mask counts them
+                    __m128i mask = Inclusive ?
+                        _mm_xor_si128(_mm_cmpgt_epi32(block, needle), _mm_set1_epi32(-1)) :
+                        _mm_cmpgt_epi32(needle, block);
+
+                    totals = _mm_sub_epi32(totals, mask);
+                }
+
+                alignas(16) int lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), totals);
+                total = (unsigned int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+            }
+#endif
+
+            // No branches to mispredict, and simple enough for the compiler to vectorize for other keys
+            for (; i < count; ++i)
+            {
+                total += Inclusive ? (unsigned int)!(key < keys[i]) : (unsigned int)(keys[i] < key);
+            }
+
+            return total;
+        }
+
+        // Number of keys less than key, or with Inclusive, not greater than key.  Keys are sorted
+        template<bool Inclusive>
+        static inline unsigned int Search(const Key* keys, unsigned int count, const Key& key)
+        {
+            unsigned int base = 0;
+            unsigned int n = count;
+
+            // Halve without branching until a straight count is cheaper
+            while (n > LINEAR_SCAN)
+            {
+                unsigned int half = n >> 1;
+                const Key& probe = keys[base + half - 1];
+
+                bool right = Inclusive ? !(key < probe) : (probe < key);
+
+                base += right ? half : 0;
+                n = right ? n - half : half;
+            }
+
+            return base + BTree::Scan<Inclusive>(keys + base, n, key);
+        }
+
+        // Leaf that key belongs in, and where in it
+        static Leaf* FindLeaf(Node* node, const Key& key, unsigned int& index)
+        {
+            index = 0;
+
+            if (!node) { return nullptr; }
+
+            while (!node->leaf)
+            {
+                Inner* inner = static_cast<Inner*>(node);
+                node = inner->children[BTree::Search<true>(inner->keys, inner->count, key)];
+            }
+
+            Leaf* leaf = static_cast<Leaf*>(node);
+            index = BTree::Search<false>(leaf->keys, leaf->count, key);
+
+            return leaf;
+        }
+
+        template<typename Array>
+        static inline void ShiftRight(Array* items, unsigned int from, unsigned int count)
+        {
+            for (unsigned int i = count; i > from; --i)
+            {
+                items[i] = std::move(items[i - 1]);
+            }
+        }
+
+        template<typename Array>
+        static inline void ShiftLeft(Array* items, unsigned int from, unsigned int count)
+        {
+            for (unsigned int i = from; i + 1 < count; ++i)
+            {
+                items[i] = std::move(items[i + 1]);
+            }
+        }
+
+        // On a split, split_node is the new right sibling and split_key is the smallest key under it
+        static bool Insert(Node* node, const Key& key, const Value& value, Key& split_key, Node*& split_node, MemoryTracker& memory)
+        {
+            split_node = nullptr;
+
+            if (node->leaf)
+            {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                unsigned int index = BTree::Search<false>(leaf->keys, leaf->count, key);
+
+                if (index < leaf->count && !(key < leaf->keys[index]))
+                {
+                    leaf->values[index] = value;
+                    return false;
+                }
+
+                BTree::ShiftRight(leaf->keys, index, leaf->count);
+                BTree::ShiftRight(leaf->values, index, leaf->count);
+                leaf->keys[index] = key;
+                leaf->values[index] = value;
+                ++leaf->count;
+
+                if (leaf->count > LEAF_CAPACITY)
+                {
+                    split_node = BTree::Split(leaf, split_key, memory);
+                }
+
+                return true;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            unsigned int index = BTree::Search<true>(inner->keys, inner->count, key);
+
+            Key child_key;
+            Node* child_node;
+            bool inserted = BTree::Insert(inner->children[index], key, value, child_key, child_node, memory);
+
+            if (child_node)
+            {
+                BTree::ShiftRight(inner->keys, index, inner->count);
+                BTree::ShiftRight(inner->children, index + 1, inner->count + 1);
+                inner->keys[index] = child_key;
+                inner->children[index + 1] = child_node;
+                ++inner->count;
+
+                if (inner->count > INNER_CAPACITY)
+                {
+                    split_node = BTree::Split(inner, split_key, memory);
+                }
+            }
+
+            return inserted;
+        }
+
+        static Leaf* Split(Leaf* leaf, Key& split_key, MemoryTracker& memory)
+        {
+            Leaf* right = new Leaf();
+            memory.Allocated(sizeof(Leaf));
+
+            unsigned int keep = leaf->count >> 1;
+            for (unsigned int i = keep; i < leaf->count; ++i)
+            {
+                right->keys[i - keep] = std::move(leaf->keys[i]);
+                right->values[i - keep] = std::move(leaf->values[i]);
+            }
+
+            right->count = leaf->count - keep;
+            leaf->count = keep;
+
+            right->next = leaf->next;
+            leaf->next = right;
+
+            split_key = right->keys[0];
+
+            return right;
+        }
+
+        static Inner* Split(Inner* inner, Key& split_key, MemoryTracker& memory)
+        {
+            Inner* right = new Inner();
+            memory.Allocated(sizeof(Inner));
+
+            // The middle key moves up instead of over
+            unsigned int middle = inner->count >> 1;
+            split_key = std::move(inner->keys[middle]);
+
+            for (unsigned int i = middle + 1; i < inner->count; ++i)
+            {
+                right->keys[i - middle - 1] = std::move(inner->keys[i]);
+            }
+
+            for (unsigned int i = middle + 1; i <= inner->count; ++i)
+            {
+                right->children[i - middle - 1] = inner->children[i];
+            }
+
+            right->count = inner->count - middle - 1;
+            inner->count = middle;
+
+            return right;
+        }
+
+        static bool Remove(Node* node, const Key& key, MemoryTracker& memory)
+        {
+            if (node->leaf)
+            {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                unsigned int index = BTree::Search<false>(leaf->keys, leaf->count, key);
+
+                if (index >= leaf->count || key < leaf->keys[index]) { return false; }
+
+                BTree::ShiftLeft(leaf->keys, index, leaf->count);
+                BTree::ShiftLeft(leaf->values, index, leaf->count);
+                --leaf->count;
+
+                return true;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            unsigned int index = BTree::Search<true>(inner->keys, inner->count, key);
+
+            if (!BTree::Remove(inner->children[index], key, memory)) { return false; }
+
+            Node* child = inner->children[index];
+            if (child->count < (child->leaf ? LEAF_MIN : INNER_MIN))
+            {
+                BTree::Rebalance(inner, index, memory);
+            }
+
+            // Separators can outlive the key they were copied from, they still route correctly
+            return true;
+        }
+
+        // children[index] fell under the minimum, borrow from a sibling or merge with one
+        static void Rebalance(Inner* parent, unsigned int index, MemoryTracker& memory)
+        {
+            Node* child = parent->children[index];
+            Node* left = index ? parent->children[index - 1] : nullptr;
+            Node* right = (index < parent->count) ? parent->children[index + 1] : nullptr;
+
+            unsigned int minimum = child->leaf ? LEAF_MIN : INNER_MIN;
+
+            if (left && left->count > minimum)
+            {
+                child->leaf ?
+                    BTree::BorrowLeft(static_cast<Leaf*>(left), static_cast<Leaf*>(child), parent->keys[index - 1]) :
+                    BTree::BorrowLeft(static_cast<Inner*>(left), static_cast<Inner*>(child), parent->keys[index - 1]);
+            }
+            else if (right && right->count > minimum)
+            {
+                child->leaf ?
+                    BTree::BorrowRight(static_cast<Leaf*>(child), static_cast<Leaf*>(right), parent->keys[index]) :
+                    BTree::BorrowRight(static_cast<Inner*>(child), static_cast<Inner*>(right), parent->keys[index]);
+            }
+            else
+            {
+                // Always fold the right node of the pair into the left one
+                unsigned int separator = left ? index - 1 : index;
+                Node* into = left ? left : child;
+                Node* from = left ? child : right;
+
+                child->leaf ?
+                    BTree::Merge(static_cast<Leaf*>(into), static_cast<Leaf*>(from), memory) :
+                    BTree::Merge(static_cast<Inner*>(into), static_cast<Inner*>(from), parent->keys[separator], memory);
+
+                BTree::ShiftLeft(parent->keys, separator, parent->count);
+                BTree::ShiftLeft(parent->children, separator + 1, parent->count + 1);
+                --parent->count;
+            }
+        }
+
+        static void BorrowLeft(Leaf* left, Leaf* child, Key& separator)
+        {
+            BTree::ShiftRight(child->keys, 0, child->count);
+            BTree::ShiftRight(child->values, 0, child->count);
+
+            --left->count;
+            child->keys[0] = std::move(left->keys[left->count]);
+            child->values[0] = std::move(left->values[left->count]);
+            ++child->count;
+
+            separator = child->keys[0];
+        }
+
+        static void BorrowRight(Leaf* child, Leaf* right, Key& separator)
+        {
+            child->keys[child->count] = std::move(right->keys[0]);
+            child->values[child->count] = std::move(right->values[0]);
+            ++child->count;
+
+            BTree::ShiftLeft(right->keys, 0, right->count);
+            BTree::ShiftLeft(right->values, 0, right->count);
+            --right->count;
+
+            separator = right->keys[0];
+        }
+
+        static void BorrowLeft(Inner* left, Inner* child, Key& separator)
+        {
+            // The separator comes down, the left's last key goes up in its place
+            BTree::ShiftRight(child->keys, 0, child->count);
+            BTree::ShiftRight(child->children, 0, child->count + 1);
+
+            child->keys[0] = std::move(separator);
+            child->children[0] = left->children[left->count];
+            ++child->count;
+
+            --left->count;
+            separator = std::move(left->keys[left->count]);
+        }
+
+        static void BorrowRight(Inner* child, Inner* right, Key& separator)
+        {
+            child->keys[child->count] = std::move(separator);
+            child->children[child->count + 1] = right->children[0];
+            ++child->count;
+
+            separator = std::move(right->keys[0]);
+
+            BTree::ShiftLeft(right->keys, 0, right->count);
+            BTree::ShiftLeft(right->children, 0, right->count + 1);
+            --right->count;
+        }
+
+        static void Merge(Leaf* into, Leaf* from, MemoryTracker& memory)
+        {
+            for (unsigned int i = 0; i < from->count; ++i)
+            {
+                into->keys[into->count + i] = std::move(from->keys[i]);
+                into->values[into->count + i] = std::move(from->values[i]);
+            }
+
+            into->count += from->count;
+            into->next = from->next;
+
+            delete from;
+            memory.Freed(sizeof(Leaf));
+        }
+
+        static void Merge(Inner* into, Inner* from, const Key& separator, MemoryTracker& memory)
+        {
+            // The separator comes down between the two halves
+            into->keys[into->count] = separator;
+
+            for (unsigned int i = 0; i < from->count; ++i)
+            {
+                into->keys[into->count + 1 + i] = std::move(from->keys[i]);
+            }
+
+            for (unsigned int i = 0; i <= from->count; ++i)
+            {
+                into->children[into->count + 1 + i] = from->children[i];
+            }
+
+            into->count += from->count + 1;
+
+            delete from;
+            memory.Freed(sizeof(Inner));
+        }
+
+        static void Clear(Node* node, MemoryTracker& memory)
+        {
+            if (!node) { return; }
+
+            if (node->leaf)
+            {
+                delete static_cast<Leaf*>(node);
+                memory.Freed(sizeof(Leaf));
+                return;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            for (unsigned int i = 0; i <= inner->count; ++i)
+            {
+                BTree::Clear(inner->children[i], memory);
+            }
+
+            delete inner;
+            memory.Freed(sizeof(Inner));
+        }
+
+        // Hold the actual elements
+        Node* m_root;
+
+        size_t m_size;
+
+        MemoryTracker m_memory;
+    };
+}
+}
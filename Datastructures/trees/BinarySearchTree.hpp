@@ -1,194 +1,375 @@
-#pragma once
-
-#include "Tree.hpp"
-
-namespace Datastructures
-{
-    namespace Trees
-    {
-        template<typename Type>
-        struct BSTNode
-        {
-            BSTNode(const Type& data) :
-                left(nullptr),
-                right(nullptr),
-                key(data),
-                count(1)
-            {
-            }
-
-            bool inline operator <(const BSTNode& rhs) const
-            {
-                return key < rhs.key;
-            }
-
-            bool inline operator >(const BSTNode& rhs) const
-            {
-                return key > rhs.key;
-            }
-
-            bool inline operator <(const Type& rhs) const
-            {
-                return key < rhs;
-            }
-
-            bool inline operator >(const Type& rhs) const
-            {
-                return key > rhs;
-            }
-
-            unsigned int count;
-
-            Type key;
-
-            BSTNode* left;
-            BSTNode* right;
-        };
-
-        template<
-            typename Type,
-            typename NodeType = BSTNode<Type>
-        >
-            class BinarySearchTree
-        {
-
-        public:
-
-            using node_ptr = NodeType*;
-
-            static node_ptr MinValue(node_ptr node)
-            {
-                if (!node) { throw Exceptions::NullNodeException(); }
-
-                node_ptr iter = node;
-                while (iter->left)
-                {
-                    iter = iter->left;
-                }
-                return iter;
-            }
-
-            static node_ptr MaxValue(node_ptr node)
-            {
-                if (!node) { throw Exceptions::NullNodeException(); }
-
-                node_ptr iter = node;
-                while (iter->right)
-                {
-                    iter = iter->right;
-                }
-                return iter;
-            }
-
-            static void InOrder(node_ptr node, std::vector<node_ptr>& inorder)
-            {
-                if (!root) { return; }
-
-                BinarySearchTree::InOrder(node->left, inorder);
-                inorder.push_back(node);
-                BinarySearchTree::InOrder(node->right, inorder);
-            }
-
-            static node_ptr Insert(node_ptr node, const Type& key)
-            {
-
-                // Current spot is empty, just return it
-                if (!node) { return new NodeType(key); }
-
-                // We need to search in left tree, node is less than current root
-                if (*node > key)
-                {
-                    node->left = Insert(node->left, key);
-                }
-                // We need to search in right tree, node is gets current root
-                else if (*node < key)
-                {
-                    node->right = Insert(node->right, key);
-                }
-                else
-                {
-                    // Increment the count of this object
-                    ++(node->count);
-                }
-
-                return node;
-            }
-
-            static node_ptr Remove(node_ptr node, const Type& key)
-            {
-                if (!node) { return node; }
-
-                if (*node > key)
-                {
-                    node->left = Remove(node->left, key);
-                }
-                else if (*node < key)
-                {
-                    node->right = Remove(node->right, key);
-                }
-                else
-                {
-                    // Decrement the count
-                    --(node->count);
-
-                    // There is still some left
-                    if (node->count) { return node; }
-
-                    // Single child cases
-                    if (!node->left)
-                    {
-                        node_ptr temp = node->right;
-                        delete node;
-                        return temp;
-                    }
-                    else if (!node->right)
-                    {
-                        node_ptr temp = node->left;
-                        delete node;
-                        return temp;
-                    }
-
-                    // Prefer successor
-                    node_ptr temp = BinarySearchTree::MinValue(node->right);
-
-                    // copy over key
-                    node->key = temp->key;
-
-                    //delete the node
-                    node->right = BinarySearchTree::Remove(node->right, temp->key);
-                }
-
-                return node;
-            }
-
-        public:
-            BinarySearchTree() :
-                m_root(nullptr)
-            {
-            }
-
-            BinarySearchTree(BinarySearchTree&&) = delete;
-            BinarySearchTree(BinarySearchTree&) = delete;
-
-            void Insert(const Type& data)
-            {
-                m_root = BinarySearchTree::Insert(m_root, data);
-            }
-
-            void Remove(const Type& data)
-            {
-                m_root = BinarySearchTree::Remove(m_root, data);
-            }
-
-            void InOrder(std::vector<node_ptr>& inorder)
-            {
-                BinarySearchTree::InOrder(m_root, inorder);
-            }
-
-        private:
-
-            // Hold the actual elements
-            node_ptr m_root;
-        };
-    }
+#pragma once
+
+#include "Tree.hpp"
+
+#include <vector>
+
+namespace Datastructures
+{
+    namespace Trees
+    {
+        template<typename Type>
+        struct BSTNode
+        {
+            BSTNode(const Type& data) :
+                count(1),
+                key(data),
+                left(nullptr),
+                right(nullptr)
+            {
+            }
+
+            bool inline operator <(const BSTNode& rhs) const
+            {
+                return key < rhs.key;
+            }
+
+            bool inline operator >(const BSTNode& rhs) const
+            {
+                return key > rhs.key;
+            }
+
+            bool inline operator <(const Type& rhs) const
+            {
+                return key < rhs;
+            }
+
+            bool inline operator >(const Type& rhs) const
+            {
+                return key > rhs;
+            }
+
+            unsigned int count;
+
+            Type key;
+
+            BSTNode* left;
+            BSTNode* right;
+        };
+
+        template<
+            typename Type,
+            typename NodeType = BSTNode<Type>
+        >
+            class BinarySearchTree
+        {
+
+        public:
+
+            using node_ptr = NodeType*;
+
+            static node_ptr MinValue(node_ptr node)
+            {
+                if (!node) { throw Exceptions::NullNodeException(); }
+
+                node_ptr iter = node;
+                while (iter->left)
+                {
+                    iter = iter->left;
+                }
+                return iter;
+            }
+
+            static node_ptr MaxValue(node_ptr node)
+            {
+                if (!node) { throw Exceptions::NullNodeException(); }
+
+                node_ptr iter = node;
+                while (iter->right)
+                {
+                    iter = iter->right;
+                }
+                return iter;
+            }
+
+            static node_ptr Find(node_ptr node, const Type& key)
+            {
+                node_ptr iter = node;
+                while (iter)
+                {
+                    if (*iter > key)
+                    {
+                        iter = iter->left;
+                    }
+                    else if (*iter < key)
+                    {
+                        iter = iter->right;
+                    }
+                    else
+                    {
+                        return iter;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            // First node whose key isn't less than key
+            static node_ptr LowerBound(node_ptr node, const Type& key)
+            {
+                node_ptr bound = nullptr;
+
+                node_ptr iter = node;
+                while (iter)
+                {
+                    if (*iter < key)
+                    {
+                        iter = iter->right;
+                    }
+                    else
+                    {
+                        bound = iter;
+                        iter = iter->left;
+                    }
+                }
+
+                return bound;
+            }
+
+            // First node whose key is greater than key
+            static node_ptr UpperBound(node_ptr node, const Type& key)
+            {
+                node_ptr bound = nullptr;
+
+                node_ptr iter = node;
+                while (iter)
+                {
+                    if (*iter > key)
+                    {
+                        bound = iter;
+                        iter = iter->left;
+                    }
+                    else
+                    {
+                        iter = iter->right;
+                    }
+                }
+
+                return bound;
+            }
+
+            // Explicit stack instead of recursion, a degenerate tree is as deep as it is big
+            static void InOrder(node_ptr node, std::vector<node_ptr>& inorder)
+            {
+                std::vector<node_ptr> stack;
+
+                node_ptr iter = node;
+                while (iter || !stack.empty())
+                {
+                    while (iter)
+                    {
+                        stack.push_back(iter);
+                        iter = iter->left;
+                    }
+
+                    iter = stack.back();
+                    stack.pop_back();
+
+                    inorder.push_back(iter);
+                    iter = iter->right;
+                }
+            }
+
+            // Deletes every node without a stack.  Left children are rotated up until there aren't any, then the
+            // node can go and its right subtree takes its place.  Returns how many nodes went
+            static size_t Clear(node_ptr node)
+            {
+                size_t deleted = 0;
+
+                node_ptr iter = node;
+                while (iter)
+                {
+                    if (iter->left)
+                    {
+                        node_ptr left = iter->left;
+                        iter->left = left->right;
+                        left->right = iter;
+                        iter = left;
+                    }
+                    else
+                    {
+                        node_ptr right = iter->right;
+                        delete iter;
+                        iter = right;
+                        ++deleted;
+                    }
+                }
+
+                return deleted;
+            }
+
+            // memory, when there is one, is told about the node allocated for a new key
+            static node_ptr Insert(node_ptr node, const Type& key, MemoryTracker* memory = nullptr)
+            {
+                // Walk the links instead of the nodes, so the new node can be hung straight off whichever one is empty
+                node_ptr* link = &node;
+                while (*link)
+                {
+                    // We need to search in left tree, node is less than current root
+                    if (**link > key)
+                    {
+                        link = &(*link)->left;
+                    }
+                    // We need to search in right tree, node is gets current root
+                    else if (**link < key)
+                    {
+                        link = &(*link)->right;
+                    }
+                    else
+                    {
+                        // Increment the count of this object
+                        ++((*link)->count);
+                        return node;
+                    }
+                }
+
+                *link = new NodeType(key);
+                if (memory) { memory->Allocated(sizeof(NodeType)); }
+
+                return node;
+            }
+
+            // memory, when there is one, is told about the node freed when the last copy goes
+            static node_ptr Remove(node_ptr node, const Type& key, MemoryTracker* memory = nullptr)
+            {
+                node_ptr* link = &node;
+                while (*link)
+                {
+                    if (**link > key)
+                    {
+                        link = &(*link)->left;
+                    }
+                    else if (**link < key)
+                    {
+                        link = &(*link)->right;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+
+                node_ptr target = *link;
+                if (!target) { return node; }
+
+                // Decrement the count
+                --(target->count);
+
+                // There is still some left
+                if (target->count) { return node; }
+
+                if (memory) { memory->Freed(sizeof(NodeType)); }
+
+                // Single child cases
+                if (!target->left)
+                {
+                    *link = target->right;
+                    delete target;
+                    return node;
+                }
+                else if (!target->right)
+                {
+                    *link = target->left;
+                    delete target;
+                    return node;
+                }
+
+                // Prefer successor
+                node_ptr* successor = &target->right;
+                while ((*successor)->left)
+                {
+                    successor = &(*successor)->left;
+                }
+
+                node_ptr temp = *successor;
+
+                // copy over key, and every duplicate along with it
+                target->key = temp->key;
+                target->count = temp->count;
+
+                // The successor has no left child, so its right one takes its place
+                *successor = temp->right;
+                delete temp;
+
+                return node;
+            }
+
+        public:
+            BinarySearchTree() :
+                m_root(nullptr)
+            {
+            }
+
+            ~BinarySearchTree()
+            {
+                size_t deleted = BinarySearchTree::Clear(m_root);
+                m_memory.Freed(deleted * sizeof(NodeType), deleted);
+            }
+
+            BinarySearchTree(BinarySearchTree&&) = delete;
+            BinarySearchTree(BinarySearchTree&) = delete;
+
+            void Insert(const Type& data)
+            {
+                m_root = BinarySearchTree::Insert(m_root, data, &m_memory);
+            }
+
+            void Remove(const Type& data)
+            {
+                m_root = BinarySearchTree::Remove(m_root, data, &m_memory);
+            }
+
+            void InOrder(std::vector<node_ptr>& inorder)
+            {
+                BinarySearchTree::InOrder(m_root, inorder);
+            }
+
+            node_ptr Find(const Type& key) const
+            {
+                return BinarySearchTree::Find(m_root, key);
+            }
+
+            bool Contains(const Type& key) const
+            {
+                return BinarySearchTree::Find(m_root, key) != nullptr;
+            }
+
+            // Duplicates are stored once with a count
+            unsigned int Count(const Type& key) const
+            {
+                node_ptr node = BinarySearchTree::Find(m_root, key);
+                return node ? node->count : 0;
+            }
+
+            node_ptr LowerBound(const Type& key) const
+            {
+                return BinarySearchTree::LowerBound(m_root, key);
+            }
+
+            node_ptr UpperBound(const Type& key) const
+            {
+                return BinarySearchTree::UpperBound(m_root, key);
+            }
+
+            // Every node with a key in [low, high], in order, found as it's walked
+            TreeRange<Type, NodeType> Range(const Type& low, const Type& high) const
+            {
+                return TreeRange<Type, NodeType>(m_root, low, high);
+            }
+
+            // One node per distinct key, duplicates only bump its count, so every live byte is in use
+            MemoryUsage MemoryStats() const
+            {
+                size_t nodes = m_memory.Live() / sizeof(NodeType);
+                return m_memory.Usage(m_memory.Live(), nodes);
+            }
+
+        private:
+
+            // Hold the actual elements
+            node_ptr m_root;
+
+            MemoryTracker m_memory;
+        };
+    }
 }
\ No newline at end of file
@@ -0,0 +1,489 @@
+#pragma once
+
+#include "Tree.hpp"
+#include "BinarySearchTree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Datastructures
+{
+namespace Trees
+{
+    /***************************************************************************************************************
+    * AVLTree for many readers and few writers, RCU style.  A published node is never written again: a writer copies
+    * the path down to the key it touches, rebalances the copies, and swaps the root over in one atomic store.
+    * Readers load the root and search it without taking a lock or writing to a node, so they never wait on a writer
+    * or on each other.
+    *
+    * Writers are serialized on a mutex.  Nodes a write replaces are retired, and freed in batches once every reader
+    * that could still see them is gone.  Readers announce themselves in one of two epochs on striped counters, a
+    * reclaim flips the epoch and waits for the old one to drain.
+    *
+    * Readers only ever get copies of keys back, a node can be freed as soon as the read it was found in ends.
+    ***************************************************************************************************************/
+    template<
+        typename Type
+    >
+    class ConcurrentAVLTree
+    {
+
+    public:
+
+        struct Node
+        {
+            Node(const Type& data, unsigned long long write) :
+                height(1),
+                count(1),
+                size(1),
+                birth(write),
+                key(data),
+                left(nullptr),
+                right(nullptr)
+            {
+            }
+
+            Node(const Node& rhs, unsigned long long write) :
+                height(rhs.height),
+                count(rhs.count),
+                size(rhs.size),
+                birth(write),
+                key(rhs.key),
+                left(rhs.left),
+                right(rhs.right)
+            {
+            }
+
+            bool inline operator <(const Type& rhs) const
+            {
+                return key < rhs;
+            }
+
+            bool inline operator >(const Type& rhs) const
+            {
+                return key > rhs;
+            }
+
+            unsigned int height;
+            unsigned int count;
+            unsigned int size;
+
+            // Write that made this node, it can only be changed in place during that write
+            unsigned long long birth;
+
+            Type key;
+
+            Node* left;
+            Node* right;
+        };
+
+        using node_ptr = Node*;
+
+        ConcurrentAVLTree() :
+            m_root(nullptr),
+            m_epoch(0),
+            m_write(0)
+        {
+            for (Stripe& stripe : m_readers)
+            {
+                stripe.count[0].store(0);
+                stripe.count[1].store(0);
+            }
+        }
+
+        // Nobody can be reading by now
+        ~ConcurrentAVLTree()
+        {
+            size_t deleted = BinarySearchTree<Type, Node>::Clear(m_root.load());
+            m_memory.Freed(deleted * sizeof(Node), deleted);
+
+            for (node_ptr node : m_retired)
+            {
+                delete node;
+            }
+
+            m_memory.Freed(m_retired.size() * sizeof(Node), m_retired.size());
+        }
+
+        ConcurrentAVLTree(ConcurrentAVLTree&&) = delete;
+        ConcurrentAVLTree(ConcurrentAVLTree&) = delete;
+
+        void Insert(const Type& key)
+        {
+            std::lock_guard<std::mutex> lock(m_writer);
+            ++m_write;
+
+            m_root.store(Insert(m_root.load(std::memory_order_relaxed), key), std::memory_order_release);
+
+            ReclaimIfFull();
+        }
+
+        // Returns false if there was no copy of key to remove
+        bool Remove(const Type& key)
+        {
+            std::lock_guard<std::mutex> lock(m_writer);
+
+            node_ptr root = m_root.load(std::memory_order_relaxed);
+
+            // Nothing moves while we hold the lock, so look before copying anything
+            if (!BinarySearchTree<Type, Node>::Find(root, key)) { return false; }
+
+            ++m_write;
+
+            m_root.store(Remove(root, key), std::memory_order_release);
+
+            ReclaimIfFull();
+
+            return true;
+        }
+
+        bool Contains(const Type& key) const
+        {
+            return Count(key) != 0;
+        }
+
+        // Duplicates are stored once with a count
+        unsigned int Count(const Type& key) const
+        {
+            ReadSection read(*this);
+
+            node_ptr node = BinarySearchTree<Type, Node>::Find(read.Root(), key);
+            return node ? node->count : 0;
+        }
+
+        // Copies out the smallest key that isn't less than key, false if there isn't one
+        bool LowerBound(const Type& key, Type& bound) const
+        {
+            ReadSection read(*this);
+
+            node_ptr node = BinarySearchTree<Type, Node>::LowerBound(read.Root(), key);
+            if (!node) { return false; }
+
+            bound = node->key;
+            return true;
+        }
+
+        // Every copy, duplicates included
+        unsigned int Size() const
+        {
+            ReadSection read(*this);
+
+            return ConcurrentAVLTree::NodeSize(read.Root());
+        }
+
+        // Every key once, in order, all from the same version of the tree
+        void InOrder(std::vector<Type>& keys) const
+        {
+            ReadSection read(*this);
+
+            std::vector<node_ptr> inorder;
+            BinarySearchTree<Type, Node>::InOrder(read.Root(), inorder);
+
+            for (node_ptr node : inorder)
+            {
+                keys.push_back(node->key);
+            }
+        }
+
+        // Waits out every reader that started before the call and frees everything retired so far.  Writers call
+        // this on their own once enough has piled up
+        void Synchronize()
+        {
+            std::lock_guard<std::mutex> lock(m_writer);
+            Reclaim();
+        }
+
+        // Waits for the writer like any other write.  Everything past the nodes in the tree is path copies retired
+        // and waiting for the readers to move on, so how much slack there is depends on when the last Reclaim ran
+        MemoryUsage MemoryStats() const
+        {
+            std::lock_guard<std::mutex> lock(m_writer);
+
+            size_t used = m_memory.Live() - m_retired.size() * sizeof(Node);
+            return m_memory.Usage(used, used / sizeof(Node));
+        }
+
+    private:
+
+        // Retired nodes are freed in batches of at least this many
+        static constexpr size_t RECLAIM_THRESHOLD = 1024;
+
+        // Readers spread their announcements over this many cache lines
+        static constexpr unsigned int STRIPES = 64;
+
+        struct alignas(64) Stripe
+        {
+            // Readers currently inside each epoch parity
+            std::atomic<long> count[2];
+        };
+
+        // Announces a reader for as long as it's alive, the root it hands out stays valid until then
+        class ReadSection
+        {
+
+        public:
+            ReadSection(const ConcurrentAVLTree& tree) :
+                m_stripe(tree.m_readers[ConcurrentAVLTree::StripeIndex()])
+            {
+                // If the epoch flips between reading it and announcing, a reclaim may already have counted this
+                // stripe, so go again on the new one
+                for (;;)
+                {
+                    m_parity = (unsigned int)(tree.m_epoch.load() & 1);
+                    m_stripe.count[m_parity].fetch_add(1);
+
+                    if ((unsigned int)(tree.m_epoch.load() & 1) == m_parity) { break; }
+
+                    m_stripe.count[m_parity].fetch_sub(1);
+                }
+
+                m_root = tree.m_root.load(std::memory_order_acquire);
+            }
+
+            ~ReadSection()
+            {
+                m_stripe.count[m_parity].fetch_sub(1, std::memory_order_release);
+            }
+
+            ReadSection(ReadSection&) = delete;
+
+            node_ptr Root() const
+            {
+                return m_root;
+            }
+
+        private:
+            Stripe& m_stripe;
+            unsigned int m_parity;
+            node_ptr m_root;
+        };
+
+        static unsigned int StripeIndex()
+        {
+            static thread_local unsigned int index =
+                (unsigned int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % STRIPES);
+
+            return index;
+        }
+
+        static inline unsigned int NodeHeight(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return node->height;
+        }
+
+        static inline unsigned int NodeSize(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return node->size;
+        }
+
+        static inline int BalanceFactor(node_ptr node)
+        {
+            if (!node) { return 0; }
+            return (int)ConcurrentAVLTree::NodeHeight(node->left) - (int)ConcurrentAVLTree::NodeHeight(node->right);
+        }
+
+        static inline void Update(node_ptr node)
+        {
+            node->height = std::max(NodeHeight(node->left), NodeHeight(node->right)) + 1;
+            node->size = NodeSize(node->left) + NodeSize(node->right) + node->count;
+        }
+
+        // A node this write may change in place.  Anything older is copied, and the original retired
+        node_ptr Own(node_ptr node)
+        {
+            if (node->birth == m_write) { return node; }
+
+            node_ptr copy = new Node(*node, m_write);
+            m_memory.Allocated(sizeof(Node));
+            m_retired.push_back(node);
+
+            return copy;
+        }
+
+        node_ptr RR(node_ptr A)
+        {
+            node_ptr B  = Own(A->right);
+            A->right    = B->left;
+            B->left     = A;
+
+            ConcurrentAVLTree::Update(A);
+            ConcurrentAVLTree::Update(B);
+
+            return B;
+        }
+
+        node_ptr LL(node_ptr A)
+        {
+            node_ptr B  = Own(A->left);
+            A->left     = B->right;
+            B->right    = A;
+
+            ConcurrentAVLTree::Update(A);
+            ConcurrentAVLTree::Update(B);
+
+            return B;
+        }
+
+        // node is owned by this write, its children may not be
+        node_ptr Rebalance(node_ptr node)
+        {
+            ConcurrentAVLTree::Update(node);
+
+            int balance_factor = ConcurrentAVLTree::BalanceFactor(node);
+
+            if (balance_factor >= 2)
+            {
+                if (ConcurrentAVLTree::BalanceFactor(node->left) < 0)
+                {
+                    node->left = RR(Own(node->left));
+                }
+
+                return LL(node);
+            }
+
+            if (balance_factor <= -2)
+            {
+                if (ConcurrentAVLTree::BalanceFactor(node->right) > 0)
+                {
+                    node->right = LL(Own(node->right));
+                }
+
+                return RR(node);
+            }
+
+            return node;
+        }
+
+        // Recursion is bounded by the height of the tree
+        node_ptr Insert(node_ptr node, const Type& key)
+        {
+            if (!node)
+            {
+                m_memory.Allocated(sizeof(Node));
+                return new Node(key, m_write);
+            }
+
+            node_ptr copy = Own(node);
+
+            if (*copy > key)
+            {
+                copy->left = Insert(copy->left, key);
+            }
+            else if (*copy < key)
+            {
+                copy->right = Insert(copy->right, key);
+            }
+            else
+            {
+                ++(copy->count);
+            }
+
+            return Rebalance(copy);
+        }
+
+        // key is known to be in the tree
+        node_ptr Remove(node_ptr node, const Type& key)
+        {
+            // The last copy of a key with at most one child just drops out, no need to copy it first
+            if (!(*node > key) && !(*node < key) && node->count == 1 && (!node->left || !node->right))
+            {
+                m_retired.push_back(node);
+                return node->left ? node->left : node->right;
+            }
+
+            node_ptr copy = Own(node);
+
+            if (*copy > key)
+            {
+                copy->left = Remove(copy->left, key);
+            }
+            else if (*copy < key)
+            {
+                copy->right = Remove(copy->right, key);
+            }
+            else if (copy->count > 1)
+            {
+                --(copy->count);
+            }
+            else
+            {
+                // Pull the successor out of the right subtree and take over its key and copies
+                node_ptr successor;
+                copy->right = RemoveFirst(copy->right, successor);
+
+                copy->key = successor->key;
+                copy->count = successor->count;
+                m_retired.push_back(successor);
+            }
+
+            return Rebalance(copy);
+        }
+
+        // Detaches the smallest node, the caller retires it once it's done with it
+        node_ptr RemoveFirst(node_ptr node, node_ptr& first)
+        {
+            if (!node->left)
+            {
+                first = node;
+                return node->right;
+            }
+
+            node_ptr copy = Own(node);
+            copy->left = RemoveFirst(copy->left, first);
+
+            return Rebalance(copy);
+        }
+
+        void ReclaimIfFull()
+        {
+            if (m_retired.size() >= RECLAIM_THRESHOLD)
+            {
+                Reclaim();
+            }
+        }
+
+        // Everything retired was unreachable from the root before the flip, so once the readers from before the flip
+        // are gone, nobody can be holding any of it
+        void Reclaim()
+        {
+            unsigned int parity = (unsigned int)(m_epoch.fetch_add(1) & 1);
+
+            for (const Stripe& stripe : m_readers)
+            {
+                while (stripe.count[parity].load())
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            for (node_ptr node : m_retired)
+            {
+                delete node;
+            }
+
+            m_memory.Freed(m_retired.size() * sizeof(Node), m_retired.size());
+            m_retired.clear();
+        }
+
+        // Hold the actual elements
+        std::atomic<node_ptr> m_root;
+
+        // Readers announce themselves under the low bit
+        std::atomic<unsigned long long> m_epoch;
+        mutable Stripe m_readers[STRIPES];
+
+        // Writers only, and MemoryStats
+        mutable std::mutex m_writer;
+        unsigned long long m_write;
+        std::vector<node_ptr> m_retired;
+
+        MemoryTracker m_memory;
+    };
+}
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Tree.hpp"
+
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Datastructures
+{
+namespace Trees
+{
+    /***************************************************************************************************************
+    * Read only snapshot of a BinarySearchTree or AVLTree, packed into one array in Eytzinger (BFS) order.  The
+    * children of slot k are 2k and 2k + 1, so a search walks down a single array with no pointers to chase, and
+    * the top levels that every search touches share a handful of cache lines.  Searching is branchless, the only
+    * branch left is the loop condition, which is taken the same number of times for every key.
+    *
+    * Nothing is linked back to the source tree, rebuild the snapshot after the tree changes.
+    ***************************************************************************************************************/
+    template<
+        typename Type
+    >
+    class FrozenTree
+    {
+
+    public:
+        FrozenTree() :
+            m_keys(1),
+            m_counts(1),
+            m_size(0)
+        {
+            m_memory.Allocated(Capacity(), 2);
+        }
+
+        ~FrozenTree()
+        {
+            m_memory.Freed(Capacity(), 2);
+        }
+
+        // Packs any tree with an InOrder that hands back nodes holding key and count
+        template<typename Tree>
+        explicit FrozenTree(Tree& tree) :
+            FrozenTree()
+        {
+            Freeze(tree);
+        }
+
+        template<typename Tree>
+        void Freeze(Tree& tree)
+        {
+            std::vector<typename Tree::node_ptr> inorder;
+            tree.InOrder(inorder);
+
+            m_size = inorder.size();
+            size_t capacity = Capacity();
+
+            // Slot 0 is never used, it keeps the child math at 2k and 2k + 1
+            m_keys.assign(m_size + 1, Type());
+            m_counts.assign(m_size + 1, 0);
+            m_memory.Reallocated(capacity, Capacity());
+
+            FrozenTree::Layout(inorder, 0, 1, m_keys, m_counts);
+        }
+
+        size_t Size() const
+        {
+            return m_size;
+        }
+
+        bool Contains(const Type& key) const
+        {
+            return Count(key) != 0;
+        }
+
+        // Number of copies of key, duplicates are folded into a count just like in the source tree
+        unsigned int Count(const Type& key) const
+        {
+            size_t k = Search(key);
+
+            if (!k || key < m_keys[k]) { return 0; }
+
+            return m_counts[k];
+        }
+
+        // Smallest key that isn't less than key, nullptr if there isn't one
+        const Type* LowerBound(const Type& key) const
+        {
+            size_t k = Search(key);
+
+            if (!k) { return nullptr; }
+
+            return &m_keys[k];
+        }
+
+        // Slot 0 and whatever capacity is left from a bigger tree frozen before are the only slack
+        MemoryUsage MemoryStats() const
+        {
+            return m_memory.Usage(m_size * (sizeof(Type) + sizeof(unsigned int)), m_size);
+        }
+
+    private:
+
+        inline size_t Capacity() const
+        {
+            return m_keys.capacity() * sizeof(Type) + m_counts.capacity() * sizeof(unsigned int);
+        }
+
+        // In order walk of the implicit tree, dropping the sorted keys into the slots as they're visited
+        template<typename NodePtr>
+        static size_t Layout(
+            const std::vector<NodePtr>& inorder,
+            size_t i,
+            size_t k,
+            std::vector<Type>& keys,
+            std::vector<unsigned int>& counts
+        )
+        {
+            if (k >= keys.size()) { return i; }
+
+            i = FrozenTree::Layout(inorder, i, k << 1, keys, counts);
+
+            keys[k] = inorder[i]->key;
+            counts[k] = inorder[i]->count;
+            ++i;
+
+            return FrozenTree::Layout(inorder, i, (k << 1) + 1, keys, counts);
+        }
+
+        static inline unsigned int TrailingZeros(size_t bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, bits);
+            return (unsigned int)index;
+#else
+            return (unsigned int)__builtin_ctzll(bits);
+#endif
+        }
+
+        // Slot of the lower bound of key, 0 when every key is less than it
+        inline size_t Search(const Type& key) const
+        {
+            size_t k = 1;
+
+            // Go right whenever the slot is too small, the comparison becomes the low bit of the next slot
+            while (k <= m_size)
+            {
+                k = (k << 1) + (size_t)(m_keys[k] < key);
+            }
+
+            // The path ends with a run of rights after the last left turn, which was at the answer.  Strip the run
+            // and the left turn off
+            return k >> (FrozenTree::TrailingZeros(~k) + 1);
+        }
+
+        // Keys and duplicate counts in Eytzinger order, both 1 indexed
+        std::vector<Type> m_keys;
+        std::vector<unsigned int> m_counts;
+
+        size_t m_size;
+
+        MemoryTracker m_memory;
+    };
+}
+}
@@ -1,16 +1,163 @@
-#pragma once
-
-#include <algorithm>
-#include "TreeExceptions.hpp"
-
-namespace Datastructures
-{
-namespace Trees
-{
-    template<typename Type>
-    using max_tree = std::greater_equal<Type>;
-
-    template<typename Type>
-    using min_tree = std::less_equal<Type>;
-}
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "TreeExceptions.hpp"
+#include "../MemoryTracker.hpp"
+
+namespace Datastructures
+{
+namespace Trees
+{
+    template<typename Type>
+    using max_tree = std::greater_equal<Type>;
+
+    template<typename Type>
+    using min_tree = std::less_equal<Type>;
+
+    /***************************************************************************************************************
+    * Lazy in order walk over the nodes with keys in [low, high].  Only the path down to low is pushed up front, and
+    * every step after that pushes the left spine of one right subtree, so visiting k nodes touches O(log n + k).
+    * Works on any node with key, left and right.
+    ***************************************************************************************************************/
+    template<
+        typename Type,
+        typename NodeType
+    >
+    class TreeRange
+    {
+
+    public:
+
+        using node_ptr = NodeType*;
+
+        class Iterator
+        {
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = node_ptr;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const node_ptr*;
+            using reference         = const node_ptr&;
+
+            // The end of every range
+            Iterator() :
+                m_high()
+            {
+            }
+
+            Iterator(node_ptr root, const Type& low, const Type& high) :
+                m_high(high)
+            {
+                // Walk down to low, keeping every node we pass on the left since it's still ahead of us
+                node_ptr iter = root;
+                while (iter)
+                {
+                    if (iter->key < low)
+                    {
+                        iter = iter->right;
+                    }
+                    else
+                    {
+                        m_stack.push_back(iter);
+                        iter = iter->left;
+                    }
+                }
+
+                Trim();
+            }
+
+            reference operator*() const
+            {
+                return m_stack.back();
+            }
+
+            pointer operator->() const
+            {
+                return &m_stack.back();
+            }
+
+            Iterator& operator++()
+            {
+                node_ptr node = m_stack.back();
+                m_stack.pop_back();
+
+                // Everything in the right subtree comes next, smallest first
+                node_ptr iter = node->right;
+                while (iter)
+                {
+                    m_stack.push_back(iter);
+                    iter = iter->left;
+                }
+
+                Trim();
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const Iterator& rhs) const
+            {
+                if (m_stack.empty() || rhs.m_stack.empty())
+                {
+                    return m_stack.empty() == rhs.m_stack.empty();
+                }
+
+                return m_stack.back() == rhs.m_stack.back();
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+
+            // Past high, nothing left on the stack can be in range either
+            void Trim()
+            {
+                if (!m_stack.empty() && m_high < m_stack.back()->key)
+                {
+                    m_stack.clear();
+                }
+            }
+
+            // Nodes still to be visited, the next one on top
+            std::vector<node_ptr> m_stack;
+
+            Type m_high;
+        };
+
+        TreeRange(node_ptr root, const Type& low, const Type& high) :
+            m_root(root),
+            m_low(low),
+            m_high(high)
+        {
+        }
+
+        Iterator begin() const
+        {
+            return Iterator(m_root, m_low, m_high);
+        }
+
+        Iterator end() const
+        {
+            return Iterator();
+        }
+
+    private:
+        node_ptr m_root;
+
+        Type m_low;
+        Type m_high;
+    };
+}
 }
\ No newline at end of file
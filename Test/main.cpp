@@ -1,664 +1,1511 @@
-#include <sstream>
-#include <fstream>
-#include <iostream>
-#include <time.h>
-#include <chrono>
-#include <queue>
-#include <unordered_map>
-
-// Datastructures
-#include "FibonacciHeap.hpp"
-#include "PairingHeap.hpp"
-#include "BinomialHeap.hpp"
-#include "BinaryHeap.hpp"
-#include "BinarySearchTree.hpp"
-#include "AVLTree.hpp"
-
-// Sorting
-#include "MergeSort.hpp"
-#include "InsertionSort.hpp"
-#include "BubbleSort.hpp"
-#include "SmartMergeSort.hpp"
-//#include "SmartQuickSort.hpp"
-#include "QuickSort.hpp"
-#include "HeapSort.hpp"
-#include "CountingSort.hpp"
-
-// Searching
-#include "MaxCrossingSubarray.hpp"
-#include "OrderStatistic.hpp"
-
-using namespace Datastructures::Heaps;
-using namespace Datastructures::Trees;
-using namespace Algorithms::Sort;
-using namespace Algorithms::Search;
-
-const std::vector<std::string> operations = {
-    "Insert",
-    "ExtractTop",
-    "Remove",
-    "AugmentKey"
-};
-
-void PrintTimingInfo(
-    const std::string& name,
-    std::unordered_map<std::string, std::chrono::microseconds>& timing_info,
-    std::unordered_map<std::string, int>& operation_count)
-{
-    std::stringstream ss;
-    ss << "Timing Info for " << name << '\n';
-    for (const std::string& operation : operations)
-    {
-        ss  << '\t' << operation << '\n'
-            << "\t\tNumber of Times Called: " << operation_count[operation] << '\n'
-            << "\t\tAverage Time (microseconds): " << ((double)timing_info[operation].count() / (double)operation_count[operation]) << '\n';
-    }
-
-    std::cout << ss.str() << "\n\n";
-}
-
-template<typename Heap>
-void TestHeap(const std::string& name, Heap& heap, bool min)
-{
-    std::unordered_map<int, Heap::NODE_TYPE> key_to_node;
-    std::unordered_map<Heap::NODE_TYPE, int> node_to_key;
-
-    std::unordered_map<std::string, std::chrono::microseconds> timing_info;
-    std::unordered_map<std::string, int> operation_count;
-    for (const std::string& operation : operations)
-    {
-        timing_info[operation] = std::chrono::microseconds();
-        operation_count[operation] = 0;
-    }
-
-    std::ifstream in("HeapDriver.in");
-
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    std::string line = "";
-    while (std::getline(in, line))
-    {
-        size_t colon = line.find_first_of(':');
-        std::string action(line.substr(0, colon));
-        std::string args(line.substr(colon + 1, line.length() - colon));
-
-        if (action == "Insert")
-        {
-            size_t comma = args.find(',');
-            int key = stoi(args.substr(0, comma));
-            int value = stoi(args.substr(comma + 1, args.length() - comma));
-
-            start = std::chrono::high_resolution_clock::now();
-            key_to_node[key] = heap.Insert(value);
-            end = std::chrono::high_resolution_clock::now();
-
-            node_to_key[key_to_node[key]] = key;
-        }
-        else if (action == "ExtractTop")
-        {
-            start = std::chrono::high_resolution_clock::now();
-            Heap::NODE_TYPE top = heap.ExtractTop();
-            end = std::chrono::high_resolution_clock::now();
-
-            int key = node_to_key[top];
-            node_to_key.erase(top);
-            key_to_node.erase(key);
-        }
-        else if (action == "Remove")
-        {
-            int key = stoi(args);
-
-            if (!key_to_node.count(key)) { continue; }
-
-            start = std::chrono::high_resolution_clock::now();
-            heap.Remove(key_to_node[key]);
-            end = std::chrono::high_resolution_clock::now();
-
-            Heap::NODE_TYPE node = key_to_node[key];
-            node_to_key.erase(node);
-            key_to_node.erase(key);
-        }
-        else if (action == "AugmentKey")
-        {
-            size_t comma = args.find(',');
-            int key = stoi(args.substr(0, comma));
-            int value = stoi(args.substr(comma + 1, args.length() - comma));
-
-            if (!key_to_node.count(key)) { continue; }
-            Heap::NODE_TYPE node = key_to_node[key];
-
-            start = std::chrono::high_resolution_clock::now();
-            heap.AugmentKey(node, min ?  node->Key() - value : node->Key() + value);
-            end = std::chrono::high_resolution_clock::now();
-        }
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    PrintTimingInfo(name, timing_info, operation_count);
-}
-
-template<typename Heap>
-void TestHeap_LinkedList(const std::string& name, Heap& heap, bool min)
-{
-    std::unordered_map<std::string, std::chrono::microseconds> timing_info;
-    std::unordered_map<std::string, int> operation_count;
-
-    std::unordered_map<int, Heap::NODE_TYPE> key_to_node;
-    std::unordered_map<Heap::NODE_TYPE, int> node_to_key;
-
-    for (const std::string& operation : operations)
-    {
-        timing_info[operation] = std::chrono::microseconds();
-        operation_count[operation] = 0;
-    }
-
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    unsigned int count = 10;
-
-    std::string action = "Insert";
-    for (unsigned int i = 0; i < count; i++)
-    {
-        int val = rand() % 100;
-        start = std::chrono::high_resolution_clock::now();
-        Heap::NODE_TYPE node = heap.Insert(val);
-        end = std::chrono::high_resolution_clock::now();
-
-        key_to_node[i] = node;
-        node_to_key[node] = i;
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "AugmentKey";
-    for (unsigned int i = 0; i < count; i++)
-    {
-        size_t idx = rand() % count;
-        int delta = rand() % 1000 + 1;
-
-        Heap::NODE_TYPE node = key_to_node[i];
-
-        start = std::chrono::high_resolution_clock::now();
-        heap.AugmentKey(node, min ? node->Key() - delta : node->Key() + delta);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "ExtractTop";
-    for (unsigned int i = 0; i < (count >> 1); i++)
-    {
-        start = std::chrono::high_resolution_clock::now();
-        Heap::NODE_TYPE node = heap.ExtractTop();
-        end = std::chrono::high_resolution_clock::now();
-
-        int key = node_to_key[node];
-
-        node_to_key.erase(node);
-        key_to_node.erase(key);
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "Remove";
-    for (std::pair<Heap::NODE_TYPE, int> next : node_to_key)
-    {
-        start = std::chrono::high_resolution_clock::now();
-        heap.Remove(next.first);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    PrintTimingInfo(name, timing_info, operation_count);
-}
-
-template<typename Heap>
-void TestHeap_Array(const std::string& name, Heap& heap, bool min)
-{
-    std::unordered_map<std::string, std::chrono::microseconds> timing_info;
-    std::unordered_map<std::string, int> operation_count;
-
-    for (const std::string& operation : operations)
-    {
-        timing_info[operation] = std::chrono::microseconds();
-        operation_count[operation] = 0;
-    }
-
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    std::string action = "Insert";
-    for (unsigned int i = 0; i < 250000; i++)
-    {
-        int val = rand() % 100;
-        start = std::chrono::high_resolution_clock::now();
-        heap.Insert(val);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "AugmentKey";
-    for (unsigned int i = 0; i < 250000; i++)
-    {
-        size_t idx = rand() % 249999;
-        int delta = rand() % 1000 + 1;
-
-        start = std::chrono::high_resolution_clock::now();
-        heap.DeltaKey(idx, min ? -1 * delta : delta);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "ExtractTop";
-    for (unsigned int i = 0; i < 125000; i++)
-    {
-        start = std::chrono::high_resolution_clock::now();
-        heap.ExtractTop();
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "Remove";
-    size_t num_left = 125000;
-    for (unsigned int i = 0; i < 125000; i++)
-    {
-        size_t idx = rand() % num_left;
-        --num_left;
-
-        start = std::chrono::high_resolution_clock::now();
-        heap.Remove(idx);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    PrintTimingInfo(name, timing_info, operation_count);
-}
-
-template<typename Heap>
-void TestHeap_StlPriorityQueue(const std::string& name, Heap& heap, bool min)
-{
-    std::unordered_map<std::string, std::chrono::microseconds> timing_info;
-    std::unordered_map<std::string, int> operation_count;
-
-    for (const std::string& operation : operations)
-    {
-        timing_info[operation] = std::chrono::microseconds();
-        operation_count[operation] = 0;
-    }
-
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    std::string action = "Insert";
-    for (unsigned int i = 0; i < 250000; i++)
-    {
-        int val = rand() % 100;
-        start = std::chrono::high_resolution_clock::now();
-        heap.push(val);
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    action = "ExtractTop";
-    for (unsigned int i = 0; i < 125000; i++)
-    {
-        start = std::chrono::high_resolution_clock::now();
-        heap.pop();
-        end = std::chrono::high_resolution_clock::now();
-
-        timing_info[action] += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        ++operation_count[action];
-    }
-
-    PrintTimingInfo(name, timing_info, operation_count);
-}
-
-void TestMaxBinaryHeap()
-{
-    BinaryHeap<int, std::greater> heap;
-    TestHeap_Array("MaxHeap", heap, false);
-}
-
-void TestMinBinaryHeap()
-{
-    MinBinaryHeap<int> heap;
-    TestHeap_Array("MinHeap", heap, true);
-}
-
-void TestMaxStlPriorityQueue()
-{
-    std::priority_queue<int, std::vector<int>, std::less<int>> heap;
-    TestHeap_StlPriorityQueue("MaxStlPriorityQueue", heap, false);
-}
-
-void TestMinStlPriorityQueue()
-{
-    std::priority_queue<int, std::vector<int>, std::greater<int>> heap;
-    TestHeap_StlPriorityQueue("MinStlPriorityQueue", heap, true);
-}
-
-void TestMaxFibonacciHeap()
-{
-    MaxFibonacciHeap<int> fib_heap;
-    TestHeap_LinkedList("Max Fibonacci Heap with Consecutive Operations", fib_heap, false);
-
-    MaxFibonacciHeap<int> fib_heap2;
-    TestHeap("Max Fibonacci Heap with Random Operations", fib_heap2, false);
-}
-
-void TestMinFibonacciHeap()
-{
-    MinFibonacciHeap<int> fib_heap;
-    TestHeap_LinkedList("Min Fibonacci Heap with Consecutive Operations", fib_heap, true);
-
-    MinFibonacciHeap<int> fib_heap2;
-    TestHeap("Min Fibonacci Heap with Random Operations", fib_heap2, true);
-}
-
-/*
-void TestMaxBinomialHeap()
-{
-    MaxBinomialHeap<int> bin_heap;
-    TestHeap_LinkedList("Max Binomial Heap with Consecutive Operations", bin_heap, false);
-
-    MaxFibonacciHeap<int> bin_heap2;
-    TestHeap("Max Binomial Heap with Random Operations", bin_heap2, false);
-}
-
-void TestMinBinomialHeap()
-{
-    MinBinomialHeap<int> bin_heap;
-    TestHeap_LinkedList("Min Binomial Heap with Consecutive Operations", bin_heap, true);
-
-    MinBinomialHeap<int> bin_heap2;
-    TestHeap("Min Binomial Heap with Random Operations", bin_heap2, true);
-}
-*/
-
-void TestMaxPairingHeap()
-{
-    MaxPairingHeap<int> heap;
-    TestHeap_LinkedList("Max Pairing Heap with Consecutive Operations", heap, false);
-
-    MaxPairingHeap<int> heap2;
-    TestHeap("Max Pairing Heap with Random Operations", heap2, false);
-}
-
-void TestMinPairingHeap()
-{
-    MinPairingHeap<int> heap;
-    TestHeap_LinkedList("Min Pairing Heap with Consecutive Operations", heap, true);
-
-    MinPairingHeap<int> heap2;
-    TestHeap("Min Pairing Heap with Random Operations", heap2, true);
-}
-
-void GenRandomHeapData(unsigned int num_operations, std::vector<std::string>& output)
-{
-    std::vector<int> node_keys;
-    unsigned int count = 0;
-    unsigned int key_count = 0;
-
-    for (unsigned int i = 0; i < num_operations; ++i)
-    {
-        unsigned int next_op = 0;
-
-        if (count)
-        {
-            next_op = std::rand() % operations.size();
-        }
-
-        std::stringstream ss;
-        ss << operations[next_op] << ':';
-        switch (next_op)
-        {
-        // inserting
-        case 0:
-        {
-            int key = key_count;
-            ++key_count;
-            unsigned int value = std::rand() % 100;
-            ss << key << ',' << value;
-            node_keys.push_back(key);
-            ++count;
-            break;
-        }
-        // Extract Top
-        case 1:
-            --count;
-            break;
-        // Removing
-        case 2:
-        {
-            unsigned int index = std::rand() % node_keys.size();
-            unsigned int key = node_keys[index];
-            std::vector<int>::iterator it = std::find(node_keys.begin(), node_keys.end(), key);
-            node_keys.erase(it);
-            ss << key;
-            --count;
-            break;
-        }
-        // Augmenting
-        case 3:
-        {
-            unsigned int index = std::rand() % node_keys.size();
-            unsigned int key = node_keys[index];
-            unsigned int value = std::rand() % 100 + 1;
-            ss << key << ',' << value;
-            break;
-        }
-        }
-
-        output.push_back(ss.str());
-    }
-}
-
-template<typename Container>
-void PrintArray(const Container& container)
-{
-    std::stringstream ss;
-    bool first = true;
-    for (const auto& next : container)
-    {
-        if (first)
-        {
-            first = false;
-        }
-        else
-        {
-            ss << ',';
-        }
-
-        ss << next;
-    }
-
-    std::cout << ss.str() << '\n';
-}
-
-template<typename Sorter, typename Container>
-void TestSort(const std::string& name, const Container& unsorted)
-{
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    std::stringstream ss;
-
-    Container to_sort(unsorted);
-    start = std::chrono::high_resolution_clock::now();
-    Sorter::Sort(to_sort);
-    end = std::chrono::high_resolution_clock::now();
-    ss << name << " Total Time: " << std::chrono::duration<double, std::milli>(end - start).count() << "(ms)\n";
-
-    bool valid = validate_sort<Container, Sorter::compare>(to_sort);
-    ss << "Sorting Valid: " << (valid ? "True" : "False") << '\n';
-
-    std::cout << ss.str();
-#ifdef DEBUG
-    //PrintArray(to_sort);
-#endif
-    std::cout << '\n';
-}
-
-template<typename Container, typename Compare>
-bool validate_sort(const Container& A)
-{
-    Compare comp;
-
-    for (Container::size_type i = 1; i < A.size(); ++i)
-    {
-        if ((A[i] != A[i-1]) && !comp(A[i], A[i - 1]))
-        {
-            std::cout << "crap\n";
-            return false;
-        }
-    }
-
-    return true;
-}
-
-int main()
-{
-    BinarySearchTree<int> bst;
-    bst.Insert(5);
-    bst.Insert(4);
-    bst.Insert(3);
-    bst.Insert(5);
-    bst.Remove(5);
-    bst.Remove(5);
-
-    AVLTree<int> tree;
-    tree.Insert(5);
-    tree.Insert(4);
-    tree.Insert(3);
-    tree.Insert(6);
-    tree.Insert(7);
-    tree.Insert(1);
-    tree.Insert(2);
-    tree.Insert(8);
-    tree.Insert(9);
-    tree.Insert(5);
-    tree.Remove(5);
-    tree.Remove(5);
- 
-    // Sed the rand
-    srand(static_cast<int>(time(0)));
-
-    bool gen_file = false;
-    if (gen_file)
-    {
-        std::vector<std::string> save_to_file;
-        GenRandomHeapData(1000000, save_to_file);
-
-        // Dump to a file
-        std::ofstream out("HeapDriver.in");
-        if (!out.is_open())
-        {
-            std::cout << "Could not create output file\n";
-            return -1;
-        }
-
-        for (const std::string& next : save_to_file)
-        {
-            out << next << '\n';
-        }
-
-        out.close();
-
-        return 0;
-    }
-
-    /*
-    //TestMaxBinomialHeap();
-    //TestMinBinomialHeap();
-
-    TestMaxBinaryHeap();
-    TestMinBinaryHeap();
-    
-    TestMinStlPriorityQueue();
-    TestMaxStlPriorityQueue();
-
-    TestMaxFibonacciHeap();
-    TestMinFibonacciHeap();
-
-    TestMaxPairingHeap();
-    TestMinPairingHeap();
-    */
-
-    // Randomize
-#ifdef DEBUG
-    const unsigned int count = 100;
-    const unsigned int range = 100;
-#else
-    const unsigned int count = 1000000;
-    const unsigned int range = 10000;
-#endif
-
-    using Container = std::vector<unsigned int>;
-    using SignedContainer = std::vector<int>;
-
-    Container to_sort;
-    SignedContainer to_search;
-    for (unsigned int i = 0; i < count; ++i)
-    {
-        to_sort.push_back(rand() % range);
-        to_search.push_back((rand() % range) * ((rand() % 2) ? -1 : 1));
-    }
-
-#ifdef DEBUG
-    TestSort<IncreasingBubbleSort<Container>>                                               ("BubbleSort",                          to_sort);
-    TestSort<IncreasingInsertionSort<Container>>("InsertionSort", to_sort);
-    TestSort<IncreasingCountingSort<Container, range>>("CountingSort", to_sort);
-#endif
-    TestSort<IncreasingQuickSort<Container>>                                                ("QuickSort",                           to_sort);
-    TestSort<IncreasingHeapSort<Container, BinaryHeap>>                                     ("MaxHeapSort (using BinaryHeap)",      to_sort);
-    TestSort<IncreasingMergeSort<Container>>                                                ("MergeSort",                           to_sort);
-    TestSort<IncreasingSmartMergeSort<Container, IncreasingInsertionSort<Container>>>       ("SmartMergeSort (using Insertion)",    to_sort);
-    TestSort<IncreasingSmartMergeSort<Container, IncreasingQuickSort<Container>>>           ("SmartMergeSort (using Quick)",        to_sort);
-    TestSort<IncreasingSmartMergeSort<Container, IncreasingBubbleSort<Container>>>          ("SmartMergeSort (using Bubble)",       to_sort);
-    TestSort<IncreasingSmartMergeSort<Container, IncreasingHeapSort<Container, BinaryHeap>>>("SmartMergeSort (using HeapSort)",     to_sort);
-
-    /*
-    TestSort<IncreasingSmartQuickSort<Container, IncreasingInsertionSort<Container>>>       ("SmartQuickSort (using Insertion)",    to_sort);
-    TestSort<IncreasingSmartQuickSort<Container, IncreasingBubbleSort<Container>>>          ("SmartQuickSort (using Bubble)",       to_sort);
-    TestSort<IncreasingSmartQuickSort<Container, IncreasingHeapSort<Container, BinaryHeap>>>("SmartQuickSort (using HeapSort)",     to_sort);
-    */
-    std::chrono::high_resolution_clock::time_point start;
-    std::chrono::high_resolution_clock::time_point end;
-
-    start = std::chrono::high_resolution_clock::now();
-    std::sort(to_sort.begin(), to_sort.end());
-    end = std::chrono::high_resolution_clock::now();
-
-    std::cout << "Stl Sort" << " Total Time: " << std::chrono::duration<double, std::milli>(end - start).count() << "(ms)\n";
-
-    std::cout << "\nFinding\n";
-    MaximumSubarray<SignedContainer>::ReturnType ret = MaximumSubarray<SignedContainer>::Search(to_search);
-    std::cout << "From " << ret.start << " to " << ret.end << " with value " << ret.sum << '\n';
-
-    SignedContainer::value_type ith_stat = OrderStatistic<SignedContainer>::Search(to_search, count >> 2);
-    std::cout << "Order Statistic: Finding " << (count >> 2) << "th stat, " << ith_stat << '\n';
-    
-    int temp;
-    std::cin >> temp;
-
-    return 0;
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <time.h>
+#include <chrono>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+// Datastructures
+#include "FibonacciHeap.hpp"
+#include "PairingHeap.hpp"
+#include "RankPairingHeap.hpp"
+#include "BinomialHeap.hpp"
+#include "BinaryHeap.hpp"
+#include "MultiQueue.hpp"
+#include "RadixHeap.hpp"
+#include "BucketQueue.hpp"
+#include "TimerWheel.hpp"
+#include "CalendarQueue.hpp"
+#include "BinarySearchTree.hpp"
+#include "AVLTree.hpp"
+#include "FrozenTree.hpp"
+#include "BTree.hpp"
+#include "ConcurrentAVLTree.hpp"
+
+// Sorting
+#include "MergeSort.hpp"
+#include "InsertionSort.hpp"
+#include "BubbleSort.hpp"
+#include "SmartMergeSort.hpp"
+#include "SmartQuickSort.hpp"
+#include "BinaryInsertionSort.hpp"
+#include "SortingNetwork.hpp"
+#include "QuickSort.hpp"
+#include "IntroSort.hpp"
+#include "HeapSort.hpp"
+#include "CountingSort.hpp"
+
+// Searching
+#include "MaxCrossingSubarray.hpp"
+#include "OrderStatistic.hpp"
+
+// Measuring
+#include "Histogram.hpp"
+#include "Timestamp.hpp"
+
+using namespace Datastructures::Heaps;
+using namespace Datastructures::Trees;
+using namespace Algorithms::Sort;
+using namespace Algorithms::Search;
+
+const std::vector<std::string> operations = {
+    "Insert",
+    "ExtractTop",
+    "Remove",
+    "AugmentKey"
+};
+
+// Reports like the sorts do, so a run can be searched for "Valid: False"
+void Check(const std::string& name, bool valid)
+{
+    std::cout << name << " Valid: " << (valid ? "True" : "False") << '\n';
+}
+
+// Extracts everything left in heap, in the order it comes out
+template<typename Heap>
+std::vector<int> Drain(Heap& heap)
+{
+    std::vector<int> order;
+    while (!heap.Empty())
+    {
+        typename Heap::NODE_TYPE top = heap.ExtractTop();
+        order.push_back((int)top->Key());
+        delete top;
+    }
+
+    return order;
+}
+
+void PrintTimingInfo(const std::string& name, Bench::Latencies& timing_info)
+{
+    // The histograms hold timestamp ticks
+    const double scale = Bench::NanosecondsPerTick();
+
+    std::stringstream ss;
+    ss << "Timing Info for " << name << '\n';
+    for (const std::string& operation : operations)
+    {
+        const Bench::Histogram& histogram = timing_info[operation];
+        ss  << '\t' << operation << '\n'
+            << "\t\tNumber of Times Called: " << histogram.Count() << '\n'
+            << "\t\tAverage Time (nanoseconds): " << histogram.Mean() * scale << '\n'
+            << "\t\tp50 / p99 / p99.9 / Max (nanoseconds): "
+            << (double)histogram.Percentile(0.5) * scale << " / "
+            << (double)histogram.Percentile(0.99) * scale << " / "
+            << (double)histogram.Percentile(0.999) * scale << " / "
+            << (double)histogram.Max() * scale << '\n';
+    }
+
+    std::cout << ss.str() << "\n\n";
+}
+
+template<typename Heap>
+void TestHeap(const std::string& name, Heap& heap, bool min)
+{
+    std::unordered_map<int, typename Heap::NODE_TYPE> key_to_node;
+    std::unordered_map<typename Heap::NODE_TYPE, int> node_to_key;
+
+    Bench::Latencies timing_info;
+
+    std::ifstream in("HeapDriver.in");
+
+    uint64_t start;
+    uint64_t end;
+
+    std::string line = "";
+    while (std::getline(in, line))
+    {
+        size_t colon = line.find_first_of(':');
+        std::string action(line.substr(0, colon));
+        std::string args(line.substr(colon + 1, line.length() - colon));
+
+        if (action == "Insert")
+        {
+            size_t comma = args.find(',');
+            int key = stoi(args.substr(0, comma));
+            int value = stoi(args.substr(comma + 1, args.length() - comma));
+
+            start = Bench::ReadTimestamp();
+            key_to_node[key] = heap.Insert(value);
+            end = Bench::ReadTimestamp();
+
+            node_to_key[key_to_node[key]] = key;
+        }
+        else if (action == "ExtractTop")
+        {
+            start = Bench::ReadTimestamp();
+            typename Heap::NODE_TYPE top = heap.ExtractTop();
+            end = Bench::ReadTimestamp();
+
+            int key = node_to_key[top];
+            node_to_key.erase(top);
+            key_to_node.erase(key);
+        }
+        else if (action == "Remove")
+        {
+            int key = stoi(args);
+
+            if (!key_to_node.count(key)) { continue; }
+
+            start = Bench::ReadTimestamp();
+            heap.Remove(key_to_node[key]);
+            end = Bench::ReadTimestamp();
+
+            typename Heap::NODE_TYPE node = key_to_node[key];
+            node_to_key.erase(node);
+            key_to_node.erase(key);
+        }
+        else if (action == "AugmentKey")
+        {
+            size_t comma = args.find(',');
+            int key = stoi(args.substr(0, comma));
+            int value = stoi(args.substr(comma + 1, args.length() - comma));
+
+            if (!key_to_node.count(key)) { continue; }
+            typename Heap::NODE_TYPE node = key_to_node[key];
+
+            start = Bench::ReadTimestamp();
+            heap.AugmentKey(node, min ?  node->Key() - value : node->Key() + value);
+            end = Bench::ReadTimestamp();
+        }
+        else
+        {
+            // Blank or unknown lines time nothing
+            continue;
+        }
+
+        timing_info[action].Record(end - start);
+    }
+
+    PrintTimingInfo(name, timing_info);
+}
+
+template<typename Heap>
+void TestHeap_LinkedList(const std::string& name, Heap& heap, bool min)
+{
+    Bench::Latencies timing_info;
+
+    std::unordered_map<int, typename Heap::NODE_TYPE> key_to_node;
+    std::unordered_map<typename Heap::NODE_TYPE, int> node_to_key;
+
+    uint64_t start;
+    uint64_t end;
+
+    unsigned int count = 10;
+
+    std::string action = "Insert";
+    for (unsigned int i = 0; i < count; i++)
+    {
+        int val = rand() % 100;
+        start = Bench::ReadTimestamp();
+        typename Heap::NODE_TYPE node = heap.Insert(val);
+        end = Bench::ReadTimestamp();
+
+        key_to_node[i] = node;
+        node_to_key[node] = i;
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "AugmentKey";
+    for (unsigned int i = 0; i < count; i++)
+    {
+        int delta = rand() % 1000 + 1;
+
+        typename Heap::NODE_TYPE node = key_to_node[i];
+
+        start = Bench::ReadTimestamp();
+        heap.AugmentKey(node, min ? node->Key() - delta : node->Key() + delta);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "ExtractTop";
+    for (unsigned int i = 0; i < (count >> 1); i++)
+    {
+        start = Bench::ReadTimestamp();
+        typename Heap::NODE_TYPE node = heap.ExtractTop();
+        end = Bench::ReadTimestamp();
+
+        int key = node_to_key[node];
+
+        node_to_key.erase(node);
+        key_to_node.erase(key);
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "Remove";
+    for (std::pair<typename Heap::NODE_TYPE, int> next : node_to_key)
+    {
+        start = Bench::ReadTimestamp();
+        heap.Remove(next.first);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    PrintTimingInfo(name, timing_info);
+}
+
+template<typename Heap>
+void TestHeap_Array(const std::string& name, Heap& heap, bool min)
+{
+    Bench::Latencies timing_info;
+
+    uint64_t start;
+    uint64_t end;
+
+    std::string action = "Insert";
+    for (unsigned int i = 0; i < 250000; i++)
+    {
+        int val = rand() % 100;
+        start = Bench::ReadTimestamp();
+        heap.Insert(val);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "AugmentKey";
+    for (unsigned int i = 0; i < 250000; i++)
+    {
+        size_t idx = rand() % 249999;
+        int delta = rand() % 1000 + 1;
+
+        start = Bench::ReadTimestamp();
+        heap.DeltaKey(idx, min ? -1 * delta : delta);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "ExtractTop";
+    for (unsigned int i = 0; i < 125000; i++)
+    {
+        start = Bench::ReadTimestamp();
+        heap.ExtractTop();
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "Remove";
+    size_t num_left = 125000;
+    for (unsigned int i = 0; i < 125000; i++)
+    {
+        size_t idx = rand() % num_left;
+        --num_left;
+
+        start = Bench::ReadTimestamp();
+        heap.Remove(idx);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    PrintTimingInfo(name, timing_info);
+}
+
+template<typename Heap>
+void TestHeap_StlPriorityQueue(const std::string& name, Heap& heap, bool min)
+{
+    Bench::Latencies timing_info;
+
+    uint64_t start;
+    uint64_t end;
+
+    std::string action = "Insert";
+    for (unsigned int i = 0; i < 250000; i++)
+    {
+        int val = rand() % 100;
+        start = Bench::ReadTimestamp();
+        heap.push(val);
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    action = "ExtractTop";
+    for (unsigned int i = 0; i < 125000; i++)
+    {
+        start = Bench::ReadTimestamp();
+        heap.pop();
+        end = Bench::ReadTimestamp();
+
+        timing_info[action].Record(end - start);
+    }
+
+    PrintTimingInfo(name, timing_info);
+}
+
+void TestMaxBinaryHeap()
+{
+    BinaryHeap<int, std::greater> heap;
+    TestHeap_Array("MaxHeap", heap, false);
+}
+
+void TestMinBinaryHeap()
+{
+    MinBinaryHeap<int> heap;
+    TestHeap_Array("MinHeap", heap, true);
+}
+
+void TestMaxUncheckedBinaryHeap()
+{
+    MaxUncheckedBinaryHeap<int> heap;
+    TestHeap_Array("Unchecked MaxHeap", heap, false);
+}
+
+void TestMinUncheckedBinaryHeap()
+{
+    MinUncheckedBinaryHeap<int> heap;
+    TestHeap_Array("Unchecked MinHeap", heap, true);
+}
+
+void TestMaxStlPriorityQueue()
+{
+    std::priority_queue<int, std::vector<int>, std::less<int>> heap;
+    TestHeap_StlPriorityQueue("MaxStlPriorityQueue", heap, false);
+}
+
+void TestMinStlPriorityQueue()
+{
+    std::priority_queue<int, std::vector<int>, std::greater<int>> heap;
+    TestHeap_StlPriorityQueue("MinStlPriorityQueue", heap, true);
+}
+
+template<typename Heap>
+void TestHeap_Concurrent(const std::string& name, Heap& heap, unsigned int threads)
+{
+    const unsigned int per_thread = 250000;
+
+    std::chrono::high_resolution_clock::time_point start;
+    std::chrono::high_resolution_clock::time_point end;
+
+    // Each thread records into its own histograms, merged once they're all done
+    std::vector<Bench::Latencies> latencies(threads);
+
+    // Every thread does an even mix of inserts and extracts
+    std::vector<std::thread> workers;
+    start = std::chrono::high_resolution_clock::now();
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&heap, &latencies, t, per_thread]()
+        {
+            Bench::Histogram& insert = latencies[t]["Insert"];
+            Bench::Histogram& extract = latencies[t]["ExtractTop"];
+
+            for (unsigned int i = 0; i < per_thread; ++i)
+            {
+                uint64_t op_start = Bench::ReadTimestamp();
+                heap.Insert((int)(t * per_thread + i));
+                insert.Record(Bench::ReadTimestamp() - op_start);
+
+                if (i & 1)
+                {
+                    op_start = Bench::ReadTimestamp();
+                    heap.TryExtractTop();
+                    extract.Record(Bench::ReadTimestamp() - op_start);
+                }
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    end = std::chrono::high_resolution_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    double ops = (double)threads * (per_thread + (per_thread >> 1));
+
+    std::cout << name << " with " << threads << " threads Total Time: " << ms << "(ms), "
+              << (ops / ms) / 1000.0 << " Mops/s\n";
+
+    Bench::Latencies timing_info;
+    for (const Bench::Latencies& next : latencies)
+    {
+        timing_info.Merge(next);
+    }
+
+    PrintTimingInfo(name, timing_info);
+}
+
+void TestMinMultiQueue()
+{
+    for (unsigned int threads = 1; threads <= std::thread::hardware_concurrency(); threads <<= 1)
+    {
+        MinMultiQueue<int> heap(threads);
+        TestHeap_Concurrent("Min MultiQueue", heap, threads);
+    }
+}
+
+void TestMultiQueueThreads()
+{
+    const unsigned int threads = 4;
+    const int per_thread = 20000;
+
+    MinMultiQueue<int> heap(threads);
+    std::vector<std::vector<int>> popped(threads);
+
+    // Every thread pushes its own keys, popping now and then, then they all drain what's left between them
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&heap, &popped, t, per_thread]()
+        {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                heap.Insert((int)t * per_thread + i);
+
+                if (i % 3 == 0)
+                {
+                    std::optional<int> top = heap.TryExtractTop();
+                    if (top)
+                    {
+                        popped[t].push_back(*top);
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&heap, &popped, t]()
+        {
+            while (std::optional<int> top = heap.TryExtractTop())
+            {
+                popped[t].push_back(*top);
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    std::vector<int> seen;
+    for (const std::vector<int>& next : popped)
+    {
+        seen.insert(seen.end(), next.begin(), next.end());
+    }
+    std::sort(seen.begin(), seen.end());
+
+    bool valid = heap.Empty() && seen.size() == (size_t)threads * per_thread;
+    for (size_t i = 0; valid && i < seen.size(); ++i)
+    {
+        valid = seen[i] == (int)i;
+    }
+
+    Check("Min MultiQueue Threads", valid);
+}
+
+void TestMaxFibonacciHeap()
+{
+    MaxFibonacciHeap<int> fib_heap;
+    TestHeap_LinkedList("Max Fibonacci Heap with Consecutive Operations", fib_heap, false);
+
+    MaxFibonacciHeap<int> fib_heap2;
+    TestHeap("Max Fibonacci Heap with Random Operations", fib_heap2, false);
+}
+
+void TestMinFibonacciHeap()
+{
+    MinFibonacciHeap<int> fib_heap;
+    TestHeap_LinkedList("Min Fibonacci Heap with Consecutive Operations", fib_heap, true);
+
+    MinFibonacciHeap<int> fib_heap2;
+    TestHeap("Min Fibonacci Heap with Random Operations", fib_heap2, true);
+}
+
+void TestMinLazyFibonacciHeap()
+{
+    MinFibonacciHeap<int> fib_heap(true);
+    TestHeap_LinkedList("Min Lazy Remove Fibonacci Heap with Consecutive Operations", fib_heap, true);
+
+    MinFibonacciHeap<int> fib_heap2(true);
+    TestHeap("Min Lazy Remove Fibonacci Heap with Random Operations", fib_heap2, true);
+}
+
+void TestLazyFibonacciBatch()
+{
+    MinFibonacciHeap<int> heap(true);
+    std::vector<MinFibonacciHeap<int>::NODE_TYPE> nodes;
+    for (int i = 0; i < 64; ++i)
+    {
+        nodes.push_back(heap.Insert(1000 + 10 * i));
+    }
+
+    // Consolidating builds trees, so the batch has children to cut
+    delete heap.ExtractTop();
+    nodes[0] = nullptr;
+
+    // The heap frees lazily removed nodes itself
+    for (size_t i = 7; i < nodes.size(); i += 7)
+    {
+        heap.Remove(nodes[i]);
+        nodes[i] = nullptr;
+    }
+
+    std::vector<std::pair<MinFibonacciHeap<int>::NODE_TYPE, int>> batch;
+    for (size_t i = 3; i < nodes.size(); i += 3)
+    {
+        if (nodes[i])
+        {
+            batch.emplace_back(nodes[i], (int)(i * 37) % 500);
+        }
+    }
+    heap.BatchAugmentKey(batch.begin(), batch.end());
+
+    std::vector<int> expected;
+    for (MinFibonacciHeap<int>::NODE_TYPE node : nodes)
+    {
+        if (node)
+        {
+            expected.push_back(node->Key());
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    Check("Lazy Fibonacci Heap Batch", Drain(heap) == expected);
+}
+
+/*
+void TestMaxBinomialHeap()
+{
+    MaxBinomialHeap<int> bin_heap;
+    TestHeap_LinkedList("Max Binomial Heap with Consecutive Operations", bin_heap, false);
+
+    MaxFibonacciHeap<int> bin_heap2;
+    TestHeap("Max Binomial Heap with Random Operations", bin_heap2, false);
+}
+
+void TestMinBinomialHeap()
+{
+    MinBinomialHeap<int> bin_heap;
+    TestHeap_LinkedList("Min Binomial Heap with Consecutive Operations", bin_heap, true);
+
+    MinBinomialHeap<int> bin_heap2;
+    TestHeap("Min Binomial Heap with Random Operations", bin_heap2, true);
+}
+*/
+
+void TestMaxPairingHeap()
+{
+    MaxPairingHeap<int> heap;
+    TestHeap_LinkedList("Max Pairing Heap with Consecutive Operations", heap, false);
+
+    MaxPairingHeap<int> heap2;
+    TestHeap("Max Pairing Heap with Random Operations", heap2, false);
+}
+
+void TestMinPairingHeap()
+{
+    MinPairingHeap<int> heap;
+    TestHeap_LinkedList("Min Pairing Heap with Consecutive Operations", heap, true);
+
+    MinPairingHeap<int> heap2;
+    TestHeap("Min Pairing Heap with Random Operations", heap2, true);
+}
+
+void TestMaxMultipassPairingHeap()
+{
+    MaxMultipassPairingHeap<int> heap;
+    TestHeap_LinkedList("Max Multipass Pairing Heap with Consecutive Operations", heap, false);
+
+    MaxMultipassPairingHeap<int> heap2;
+    TestHeap("Max Multipass Pairing Heap with Random Operations", heap2, false);
+}
+
+void TestMinMultipassPairingHeap()
+{
+    MinMultipassPairingHeap<int> heap;
+    TestHeap_LinkedList("Min Multipass Pairing Heap with Consecutive Operations", heap, true);
+
+    MinMultipassPairingHeap<int> heap2;
+    TestHeap("Min Multipass Pairing Heap with Random Operations", heap2, true);
+}
+
+void TestMaxLazyPairingHeap()
+{
+    MaxLazyPairingHeap<int> heap;
+    TestHeap_LinkedList("Max Lazy Insert Pairing Heap with Consecutive Operations", heap, false);
+
+    MaxLazyPairingHeap<int> heap2;
+    TestHeap("Max Lazy Insert Pairing Heap with Random Operations", heap2, false);
+}
+
+void TestMinLazyPairingHeap()
+{
+    MinLazyPairingHeap<int> heap;
+    TestHeap_LinkedList("Min Lazy Insert Pairing Heap with Consecutive Operations", heap, true);
+
+    MinLazyPairingHeap<int> heap2;
+    TestHeap("Min Lazy Insert Pairing Heap with Random Operations", heap2, true);
+}
+
+void TestMaxRankPairingHeapT1()
+{
+    MaxRankPairingHeapT1<int> heap;
+    TestHeap_LinkedList("Max Type 1 Rank Pairing Heap with Consecutive Operations", heap, false);
+
+    MaxRankPairingHeapT1<int> heap2;
+    TestHeap("Max Type 1 Rank Pairing Heap with Random Operations", heap2, false);
+}
+
+void TestMinRankPairingHeapT1()
+{
+    MinRankPairingHeapT1<int> heap;
+    TestHeap_LinkedList("Min Type 1 Rank Pairing Heap with Consecutive Operations", heap, true);
+
+    MinRankPairingHeapT1<int> heap2;
+    TestHeap("Min Type 1 Rank Pairing Heap with Random Operations", heap2, true);
+}
+
+void TestMaxRankPairingHeapT2()
+{
+    MaxRankPairingHeapT2<int> heap;
+    TestHeap_LinkedList("Max Type 2 Rank Pairing Heap with Consecutive Operations", heap, false);
+
+    MaxRankPairingHeapT2<int> heap2;
+    TestHeap("Max Type 2 Rank Pairing Heap with Random Operations", heap2, false);
+}
+
+void TestMinRankPairingHeapT2()
+{
+    MinRankPairingHeapT2<int> heap;
+    TestHeap_LinkedList("Min Type 2 Rank Pairing Heap with Consecutive Operations", heap, true);
+
+    MinRankPairingHeapT2<int> heap2;
+    TestHeap("Min Type 2 Rank Pairing Heap with Random Operations", heap2, true);
+}
+
+// Pops, moves toward the top and removes nodes that sit below a root, then merges in a second heap, and checks the
+// whole pop order against a sorted copy of what should be left
+template<typename Heap>
+void TestHeapOperations(const std::string& name, bool min)
+{
+    const int toward_top = min ? -150 : 150;
+
+    Heap heap;
+    std::vector<typename Heap::NODE_TYPE> nodes;
+    std::vector<int> keys;
+    for (int i = 0; i < 64; ++i)
+    {
+        keys.push_back((i * 37) % 101);
+        nodes.push_back(heap.Insert(keys.back()));
+    }
+
+    // The first extraction links everything into trees
+    std::vector<int>::iterator best = min ?
+        std::min_element(keys.begin(), keys.end()) :
+        std::max_element(keys.begin(), keys.end());
+    size_t first = (size_t)(best - keys.begin());
+    typename Heap::NODE_TYPE top = heap.ExtractTop();
+    bool valid = top == nodes[first];
+    delete top;
+    nodes[first] = nullptr;
+
+    for (size_t i = 0; i < nodes.size(); i += 5)
+    {
+        if (nodes[i])
+        {
+            keys[i] += toward_top;
+            heap.AugmentKey(nodes[i], keys[i]);
+        }
+    }
+
+    for (size_t i = 4; i < nodes.size(); i += 9)
+    {
+        if (nodes[i])
+        {
+            heap.Remove(nodes[i]);
+            delete nodes[i];
+            nodes[i] = nullptr;
+        }
+    }
+
+    Heap other;
+    std::vector<int> expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        expected.push_back((i * 53) % 97 + 50);
+        other.Insert(expected.back());
+    }
+
+    heap.Merge(other);
+    valid = valid && other.Empty();
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i])
+        {
+            expected.push_back(keys[i]);
+        }
+    }
+
+    std::sort(expected.begin(), expected.end());
+    if (!min)
+    {
+        std::reverse(expected.begin(), expected.end());
+    }
+
+    Check(name, valid && Drain(heap) == expected);
+}
+
+void TestPairingHeapVariants()
+{
+    TestHeapOperations<MaxMultipassPairingHeap<int>>("Max Multipass Pairing Heap", false);
+    TestHeapOperations<MinMultipassPairingHeap<int>>("Min Multipass Pairing Heap", true);
+    TestHeapOperations<MaxLazyPairingHeap<int>>("Max Lazy Insert Pairing Heap", false);
+    TestHeapOperations<MinLazyPairingHeap<int>>("Min Lazy Insert Pairing Heap", true);
+    TestHeapOperations<MaxRankPairingHeapT1<int>>("Max Type 1 Rank Pairing Heap", false);
+    TestHeapOperations<MinRankPairingHeapT1<int>>("Min Type 1 Rank Pairing Heap", true);
+    TestHeapOperations<MaxRankPairingHeapT2<int>>("Max Type 2 Rank Pairing Heap", false);
+    TestHeapOperations<MinRankPairingHeapT2<int>>("Min Type 2 Rank Pairing Heap", true);
+}
+
+// The random operations in HeapDriver.in aren't monotone, so the integer heaps only get the consecutive run
+void TestRadixHeap()
+{
+    RadixHeap<int> heap;
+    TestHeap_LinkedList("Radix Heap with Consecutive Operations", heap, true);
+}
+
+void TestRadixHeapMonotone()
+{
+    RadixHeap<int> heap;
+    std::vector<int> expected;
+    std::vector<RadixHeap<int>::NODE_TYPE> nodes;
+    for (int i = 0; i < 200; ++i)
+    {
+        expected.push_back((i * 7919) % 1000 + 100);
+        nodes.push_back(heap.Insert(expected.back()));
+    }
+
+    // Pull the lowest few out, then push some of the rest down, still above the last one extracted
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i)
+    {
+        RadixHeap<int>::NODE_TYPE top = heap.ExtractTop();
+        order.push_back(top->Key());
+        nodes[std::find(nodes.begin(), nodes.end(), top) - nodes.begin()] = nullptr;
+        delete top;
+    }
+
+    for (size_t i = 0; i < nodes.size(); i += 4)
+    {
+        if (nodes[i] && nodes[i]->Key() > order.back() + 50)
+        {
+            expected[i] = nodes[i]->Key() - 50;
+            heap.AugmentKey(nodes[i], expected[i]);
+        }
+    }
+
+    // Top only looks, a key between the last extracted one and the top still fits afterwards
+    bool valid = heap.Top()->Key() > order.back() + 1;
+    try
+    {
+        heap.Insert(order.back() + 1);
+        expected.push_back(order.back() + 1);
+
+        std::vector<int> rest = Drain(heap);
+        order.insert(order.end(), rest.begin(), rest.end());
+    }
+    catch (const std::exception&)
+    {
+        valid = false;
+    }
+
+    std::sort(expected.begin(), expected.end());
+    Check("Radix Heap Monotone", valid && order == expected);
+}
+
+void TestBucketQueue()
+{
+    // Keys start in [0, 100) and get pushed down by up to 1000
+    BucketQueue<int> heap(2000, -1000);
+    TestHeap_LinkedList("Bucket Queue with Consecutive Operations", heap, true);
+}
+
+void TestBucketQueueWindow()
+{
+    // Looking at the top after removing the minimum can't narrow the window, 30 is above the last extracted key
+    BucketQueue<int> window(100);
+    window.Insert(10);
+    delete window.ExtractTop();
+    window.Insert(50);
+    BucketQueue<int>::NODE_TYPE lowest = window.Insert(20);
+    window.Insert(40);
+    window.Remove(lowest);
+    delete lowest;
+
+    bool valid = window.Top()->Key() == 40;
+    try
+    {
+        window.Insert(30);
+
+        std::vector<int> order;
+        while (!window.Empty())
+        {
+            BucketQueue<int>::NODE_TYPE top = window.ExtractTop();
+            order.push_back(top->Key());
+            delete top;
+        }
+
+        valid = valid && order == std::vector<int>({ 30, 40, 50 });
+    }
+    catch (const std::exception&)
+    {
+        valid = false;
+    }
+
+    Check("Bucket Queue Window", valid);
+}
+
+void TestTimerWheel()
+{
+    TimerWheel<int> heap;
+    TestHeap_LinkedList("Timer Wheel with Consecutive Operations", heap, true);
+}
+
+void TestCalendarQueue()
+{
+    CalendarQueue<int> heap;
+    TestHeap_LinkedList("Calendar Queue with Consecutive Operations", heap, true);
+
+    CalendarQueue<int> heap2;
+    TestHeap("Calendar Queue with Random Operations", heap2, true);
+}
+
+void TestTimerWheelCascade()
+{
+    // Keys spread over 30 bits start out on every level from 0 to 4 and cascade down as the wheel catches up
+    TimerWheel<int> heap;
+    std::vector<int> expected;
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        expected.push_back((int)((i * 2654435761u) >> 2));
+        heap.Insert(expected.back());
+    }
+
+    // Top only looks, so the same node comes out and a key below it still fits in between
+    std::vector<int> order;
+    bool valid = true;
+    for (int i = 0; i < 500; ++i)
+    {
+        TimerWheel<int>::NODE_TYPE top = heap.Top();
+        TimerWheel<int>::NODE_TYPE extracted = heap.ExtractTop();
+        valid = valid && top == extracted;
+        order.push_back(extracted->Key());
+        delete extracted;
+    }
+
+    try
+    {
+        int late = heap.Top()->Key() - 1;
+        if (late > order.back())
+        {
+            heap.Insert(late);
+            expected.push_back(late);
+        }
+
+        std::vector<int> rest = Drain(heap);
+        order.insert(order.end(), rest.begin(), rest.end());
+    }
+    catch (const std::exception&)
+    {
+        valid = false;
+    }
+
+    std::sort(expected.begin(), expected.end());
+    Check("Timer Wheel Cascade", valid && order == expected);
+}
+
+void TestCalendarQueueResize()
+{
+    // 2 buckets to start, 5000 keys doubles the year up to 4096 days and draining halves it back down
+    CalendarQueue<int> heap;
+    std::vector<int> expected;
+    for (int i = 0; i < 5000; ++i)
+    {
+        expected.push_back((i * 7919) % 100000);
+        heap.Insert(expected.back());
+    }
+
+    std::vector<int> order;
+    for (int i = 0; i < 4900; ++i)
+    {
+        CalendarQueue<int>::NODE_TYPE top = heap.ExtractTop();
+        order.push_back(top->Key());
+        delete top;
+    }
+
+    // Grow again with keys behind the last top, on a much narrower spacing than the width was estimated from
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected.push_back(i % 50);
+        heap.Insert(expected.back());
+    }
+
+    std::vector<int> rest = Drain(heap);
+
+    // Everything taken out before the second batch went in is sorted on its own, and so is the rest
+    std::vector<int> first(expected.begin(), expected.begin() + 5000);
+    std::sort(first.begin(), first.end());
+    std::vector<int> second(first.begin() + 4900, first.end());
+    second.insert(second.end(), expected.begin() + 5000, expected.end());
+    std::sort(second.begin(), second.end());
+    first.resize(4900);
+
+    Check("Calendar Queue Resize", order == first && rest == second);
+}
+
+// One row per structure per N, ready to plot.  Phase "full" is right after N inserts, "drained" after half of
+// them were taken back out, which is where dead nodes, pool blocks and buffers that never shrink show up
+void PrintMemoryUsage(std::ostream& out, const std::string& name, const char* phase, unsigned int n, const Datastructures::MemoryUsage& usage)
+{
+    out << name << ',' << phase << ',' << n << ','
+        << usage.live_bytes << ','
+        << usage.peak_bytes << ','
+        << usage.BytesPerElement() << ','
+        << usage.allocations << ','
+        << usage.Fragmentation() << '\n';
+}
+
+template<typename Heap>
+void ProfileHeapMemory(std::ostream& out, const std::string& name, unsigned int n)
+{
+    Heap heap;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        heap.Insert(std::rand());
+    }
+
+    PrintMemoryUsage(out, name, "full", n, heap.MemoryStats());
+
+    for (unsigned int i = 0; i < (n >> 1); ++i)
+    {
+        delete heap.ExtractTop();
+    }
+
+    PrintMemoryUsage(out, name, "drained", n, heap.MemoryStats());
+}
+
+template<typename Tree>
+void ProfileTreeMemory(std::ostream& out, const std::string& name, unsigned int n)
+{
+    std::vector<int> keys;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        keys.push_back(std::rand());
+    }
+
+    Tree tree;
+    for (int key : keys)
+    {
+        tree.Insert(key);
+    }
+
+    PrintMemoryUsage(out, name, "full", n, tree.MemoryStats());
+
+    for (unsigned int i = 0; i < (n >> 1); ++i)
+    {
+        tree.Remove(keys[i]);
+    }
+
+    PrintMemoryUsage(out, name, "drained", n, tree.MemoryStats());
+}
+
+void ProfileMemory(std::ostream& out)
+{
+    out << "structure,phase,n,live_bytes,peak_bytes,bytes_per_element,allocations,fragmentation\n";
+
+    for (unsigned int n = 1 << 10; n <= (1u << 20); n <<= 2)
+    {
+        ProfileHeapMemory<MinFibonacciHeap<int>>    (out, "FibonacciHeap",      n);
+        ProfileHeapMemory<MinPairingHeap<int>>      (out, "PairingHeap",        n);
+        ProfileHeapMemory<MinBinomialHeap<int>>     (out, "BinomialHeap",       n);
+        ProfileTreeMemory<AVLTree<int>>             (out, "AVLTree",            n);
+        ProfileTreeMemory<BinarySearchTree<int>>    (out, "BinarySearchTree",   n);
+    }
+}
+
+void GenRandomHeapData(unsigned int num_operations, std::vector<std::string>& output)
+{
+    std::vector<int> node_keys;
+    unsigned int count = 0;
+    unsigned int key_count = 0;
+
+    for (unsigned int i = 0; i < num_operations; ++i)
+    {
+        unsigned int next_op = 0;
+
+        if (count)
+        {
+            next_op = std::rand() % operations.size();
+        }
+
+        std::stringstream ss;
+        ss << operations[next_op] << ':';
+        switch (next_op)
+        {
+        // inserting
+        case 0:
+        {
+            int key = key_count;
+            ++key_count;
+            unsigned int value = std::rand() % 100;
+            ss << key << ',' << value;
+            node_keys.push_back(key);
+            ++count;
+            break;
+        }
+        // Extract Top
+        case 1:
+            --count;
+            break;
+        // Removing
+        case 2:
+        {
+            unsigned int index = std::rand() % node_keys.size();
+            unsigned int key = node_keys[index];
+            std::vector<int>::iterator it = std::find(node_keys.begin(), node_keys.end(), key);
+            node_keys.erase(it);
+            ss << key;
+            --count;
+            break;
+        }
+        // Augmenting
+        case 3:
+        {
+            unsigned int index = std::rand() % node_keys.size();
+            unsigned int key = node_keys[index];
+            unsigned int value = std::rand() % 100 + 1;
+            ss << key << ',' << value;
+            break;
+        }
+        }
+
+        output.push_back(ss.str());
+    }
+}
+
+template<typename Container>
+void PrintArray(const Container& container)
+{
+    std::stringstream ss;
+    bool first = true;
+    for (const auto& next : container)
+    {
+        if (first)
+        {
+            first = false;
+        }
+        else
+        {
+            ss << ',';
+        }
+
+        ss << next;
+    }
+
+    std::cout << ss.str() << '\n';
+}
+
+template<typename Container, typename Compare>
+bool validate_sort(const Container& A)
+{
+    Compare comp;
+
+    for (typename Container::size_type i = 1; i < A.size(); ++i)
+    {
+        if ((A[i] != A[i-1]) && !comp(A[i], A[i - 1]))
+        {
+            std::cout << "crap\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename Sorter, typename Container>
+void TestSort(const std::string& name, const Container& unsorted)
+{
+    std::stringstream ss;
+
+    // Timing lives in the Bench project now, this only checks the result
+    Container to_sort(unsorted);
+    Sorter::Sort(to_sort);
+    ss << name << '\n';
+
+    bool valid = validate_sort<Container, typename Sorter::compare>(to_sort);
+    ss << "Sorting Valid: " << (valid ? "True" : "False") << '\n';
+
+    std::cout << ss.str();
+#ifdef DEBUG
+    //PrintArray(to_sort);
+#endif
+    std::cout << '\n';
+}
+
+// Every kernel this CPU can run has to give back exactly what the scalar code does
+void TestIsas(const std::vector<int>& keys)
+{
+    using namespace Algorithms::Simd;
+    using Ints = std::vector<int>;
+
+    auto run = [&keys]()
+    {
+        std::vector<Ints> results;
+
+        Ints increasing(keys);
+        IncreasingQuickSort<Ints>::Sort(increasing);
+        results.push_back(increasing);
+
+        Ints decreasing(keys);
+        DecreasingQuickSort<Ints>::Sort(decreasing);
+        results.push_back(decreasing);
+
+        Ints merged(keys);
+        IncreasingMergeSort<Ints>::Sort(merged);
+        results.push_back(merged);
+
+        merged = keys;
+        DecreasingMergeSort<Ints>::Sort(merged);
+        results.push_back(merged);
+
+        for (size_t n = 1; n <= 17 && n <= keys.size(); ++n)
+        {
+            Ints up(keys.begin(), keys.begin() + n);
+            Ints down(up);
+            IncreasingSortingNetwork<Ints>::Sort(up);
+            DecreasingSortingNetwork<Ints>::Sort(down);
+            results.push_back(up);
+            results.push_back(down);
+        }
+
+        for (size_t n = 1; n <= keys.size(); n += 1 + n / 3)
+        {
+            Ints prefix(keys.begin(), keys.begin() + n);
+            MaximumSubarray<Ints>::ReturnType found = MaximumSubarray<Ints>::Search(prefix);
+            results.push_back({ (int)found.start, (int)found.end, found.sum });
+        }
+
+        return results;
+    };
+
+    Isa active = ActiveIsa();
+
+    ForceIsa(Isa::Scalar);
+    std::vector<Ints> expected = run();
+
+    for (Isa isa : { Isa::AVX2, Isa::AVX512 })
+    {
+        if (ForceIsa(isa) != isa) { continue; }
+
+        std::cout << "Kernels (" << IsaName(isa) << ")\n"
+            << "Matches Scalar: " << (run() == expected ? "True" : "False") << "\n\n";
+    }
+
+    ForceIsa(active);
+}
+
+// Comparisons, swaps, moves and allocations, handy for telling a degenerate partition from a slow machine
+template<template<typename, template<typename> typename> typename Sorter, typename Container>
+void TestSortOperations(const std::string& name, const Container& unsorted)
+{
+    using Value = Counted<typename Container::value_type>;
+    using CountedContainer = std::vector<Value, CountingAllocator<Value>>;
+
+    CountedContainer to_sort(unsorted.begin(), unsorted.end());
+
+    ResetOperations();
+    Sorter<CountedContainer, counting_increasing>::Sort(to_sort);
+    OperationCounts counts = Operations();
+
+    std::stringstream ss;
+    ss << name << " Operations\n"
+        << "\tComparisons: " << counts.comparisons << '\n'
+        << "\tSwaps: " << counts.swaps << '\n'
+        << "\tMoves: " << counts.moves << '\n'
+        << "\tAllocations: " << counts.allocations << "\n\n";
+
+    std::cout << ss.str();
+}
+
+int main()
+{
+    BinarySearchTree<int> bst;
+    bst.Insert(5);
+    bst.Insert(4);
+    bst.Insert(3);
+    bst.Insert(5);
+    bst.Remove(5);
+    bst.Remove(5);
+
+    AVLTree<int> tree;
+    tree.Insert(5);
+    tree.Insert(4);
+    tree.Insert(3);
+    tree.Insert(6);
+    tree.Insert(7);
+    tree.Insert(1);
+    tree.Insert(2);
+    tree.Insert(8);
+    tree.Insert(9);
+    tree.Insert(5);
+    tree.Remove(5);
+    tree.Remove(5);
+
+    unsigned int in_range = 0;
+    for (AVLTree<int>::node_ptr node : tree.Range(2, 6))
+    {
+        in_range += node->count;
+    }
+
+    // Both copies of 5 are gone, leaving 2, 3, 4 and 6
+    Check("Tree Range", in_range == 4 && tree.Count(5) == 0 && tree.LowerBound(5)->key == 6);
+
+    // Median, and how many copies sit below 5
+    AVLTree<int>::node_ptr median = tree.Select((tree.Size() + 1) >> 1);
+    unsigned int below = tree.Rank(5);
+    Check("Tree Order Statistics", tree.Size() == 8 && median && median->key == 4 && below == 4 &&
+        tree.Select(below + 1)->key == 6);
+
+    // Merge in a sorted delta, then peel off everything from 8 up
+    std::vector<int> delta_keys = { 1, 2, 2, 3, 8, 10 };
+    AVLTree<int> delta;
+    delta.BuildFromSorted(delta_keys.begin(), delta_keys.end());
+    tree.Union(delta);
+
+    AVLTree<int> high;
+    tree.Split(8, high);
+
+    // Copies add up, so 1, 1, 2, 2, 2, 3, 3, 4, 6, 7 stay and 8, 8, 9, 10 move, then only a copy each of 8 and 9
+    // survive the intersection
+    std::vector<int> probe_keys = { 8, 9, 11 };
+    AVLTree<int> probe;
+    probe.BuildFromSorted(probe_keys.begin(), probe_keys.end());
+    unsigned int split_high = high.Size();
+    high.Intersection(probe);
+
+    // The nodes for 1, 2, 3, 4, 6 and 7 stay accounted for here, the ones for 8 and 9 in high
+    bool split_memory = tree.MemoryStats().elements == 6 && high.MemoryStats().elements == 2;
+
+    Check("Tree Set Operations", tree.Size() == 10 && tree.Count(2) == 3 && split_high == 4 && high.Size() == 2 &&
+        high.Count(8) == 1 && !high.Contains(10) && probe.Size() == 0 && split_memory);
+
+    // Readers never block, the writer publishes a new root per change
+    ConcurrentAVLTree<int> shared;
+    std::thread writer([&shared]()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            shared.Insert(i);
+        }
+    });
+
+    unsigned int seen = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seen += shared.Contains(i) ? 1 : 0;
+    }
+
+    writer.join();
+
+    // Whatever the readers raced into, every key is there once the writer is done
+    unsigned int after = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        after += shared.Contains(i) ? 1 : 0;
+    }
+
+    Check("Concurrent Tree", seen <= 1000 && after == 1000 && !shared.Contains(1000));
+
+    FrozenTree<int> frozen(tree);
+    const int* frozen_bound = frozen.LowerBound(5);
+    Check("Frozen Tree", frozen.Size() == 6 && frozen.Contains(7) && !frozen.Contains(5) &&
+        frozen_bound && *frozen_bound == 6);
+
+    BTree<int, int> btree;
+    for (int i = 0; i < 1000; ++i)
+    {
+        btree.Insert(i, i * i);
+    }
+    btree.Remove(500);
+
+    int* squared = btree.Find(20);
+    unsigned int in_btree_range = 0;
+    for (BTree<int, int>::Entry entry : btree.Between(490, 510))
+    {
+        in_btree_range += entry.value == entry.key * entry.key;
+    }
+
+    // 490 through 510 less the removed 500
+    Check("BTree", squared && *squared == 400 && !btree.Find(500) && in_btree_range == 20);
+ 
+    // Sed the rand
+    srand(static_cast<int>(time(0)));
+
+    bool gen_file = false;
+    if (gen_file)
+    {
+        std::vector<std::string> save_to_file;
+        GenRandomHeapData(1000000, save_to_file);
+
+        // Dump to a file
+        std::ofstream out("HeapDriver.in");
+        if (!out.is_open())
+        {
+            std::cout << "Could not create output file\n";
+            return -1;
+        }
+
+        for (const std::string& next : save_to_file)
+        {
+            out << next << '\n';
+        }
+
+        out.close();
+
+        return 0;
+    }
+
+    bool profile_memory = false;
+    if (profile_memory)
+    {
+        std::stringstream ss;
+        ProfileMemory(ss);
+
+        std::ofstream out("MemoryProfile.csv");
+        out << ss.str();
+        std::cout << ss.str();
+
+        return 0;
+    }
+
+    /*
+    //TestMaxBinomialHeap();
+    //TestMinBinomialHeap();
+
+    TestMaxBinaryHeap();
+    TestMinBinaryHeap();
+    TestMaxUncheckedBinaryHeap();
+    TestMinUncheckedBinaryHeap();
+    
+    TestMinStlPriorityQueue();
+    TestMaxStlPriorityQueue();
+
+    TestMinMultiQueue();
+
+    TestMaxFibonacciHeap();
+    TestMinFibonacciHeap();
+    TestMinLazyFibonacciHeap();
+
+    TestMaxPairingHeap();
+    TestMinPairingHeap();
+
+    TestMaxMultipassPairingHeap();
+    TestMinMultipassPairingHeap();
+
+    TestMaxLazyPairingHeap();
+    TestMinLazyPairingHeap();
+
+    TestMaxRankPairingHeapT1();
+    TestMinRankPairingHeapT1();
+
+    TestMaxRankPairingHeapT2();
+    TestMinRankPairingHeapT2();
+
+    TestRadixHeap();
+    TestBucketQueue();
+    TestTimerWheel();
+    TestCalendarQueue();
+    */
+
+    TestLazyFibonacciBatch();
+    TestPairingHeapVariants();
+    TestMultiQueueThreads();
+    TestRadixHeapMonotone();
+    TestTimerWheelCascade();
+    TestCalendarQueueResize();
+    TestBucketQueueWindow();
+
+    // Randomize
+#ifdef DEBUG
+    const unsigned int count = 100;
+    const unsigned int range = 100;
+#else
+    const unsigned int count = 1000000;
+    const unsigned int range = 10000;
+#endif
+
+    using Container = std::vector<unsigned int>;
+    using SignedContainer = std::vector<int>;
+
+    Container to_sort;
+    SignedContainer to_search;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        to_sort.push_back(rand() % range);
+        to_search.push_back((rand() % range) * ((rand() % 2) ? -1 : 1));
+    }
+
+#ifdef DEBUG
+    TestSort<IncreasingBubbleSort<Container>>                                               ("BubbleSort",                          to_sort);
+    TestSort<IncreasingInsertionSort<Container>>("InsertionSort", to_sort);
+    TestSort<IncreasingCountingSort<Container, range>>("CountingSort", to_sort);
+#endif
+    TestSort<IncreasingQuickSort<Container>>                                                ("QuickSort",                           to_sort);
+    TestSort<IncreasingIntroSort<Container>>                                                ("IntroSort",                           to_sort);
+    TestSort<IncreasingHeapSort<Container, BinaryHeap>>                                     ("MaxHeapSort (using BinaryHeap)",      to_sort);
+    TestSort<IncreasingHeapSort<Container, FibonacciHeap>>                                  ("MaxHeapSort (using FibonacciHeap)",   to_sort);
+    TestSort<IncreasingHeapSort<Container, BinomialHeap>>                                   ("MaxHeapSort (using BinomialHeap)",    to_sort);
+    TestSort<IncreasingHeapSort<Container, PairingHeap>>                                    ("MaxHeapSort (using PairingHeap)",     to_sort);
+    TestSort<IncreasingMergeSort<Container>>                                                ("MergeSort",                           to_sort);
+    TestSort<IncreasingSmartMergeSort<Container, IncreasingInsertionSort<Container>>>       ("SmartMergeSort (using Insertion)",    to_sort);
+    TestSort<IncreasingSmartMergeSort<Container, IncreasingQuickSort<Container>>>           ("SmartMergeSort (using Quick)",        to_sort);
+    TestSort<IncreasingSmartMergeSort<Container, IncreasingBubbleSort<Container>>>          ("SmartMergeSort (using Bubble)",       to_sort);
+    TestSort<IncreasingSmartMergeSort<Container, IncreasingHeapSort<Container, BinaryHeap>>>("SmartMergeSort (using HeapSort)",     to_sort);
+
+    TestSortOperations<QuickSort>                                                           ("QuickSort",                           to_sort);
+    TestSortOperations<MergeSort>                                                           ("MergeSort",                           to_sort);
+
+    TestSort<IncreasingBinaryInsertionSort<Container>>                                      ("BinaryInsertionSort",                 to_sort);
+    TestSort<IncreasingSortingNetwork<Container>>                                           ("SortingNetwork",                      to_sort);
+    TestSort<IncreasingSmartQuickSort<Container, IncreasingInsertionSort<Container>>>       ("SmartQuickSort (using Insertion)",    to_sort);
+    TestSort<IncreasingSmartQuickSort<Container, IncreasingBubbleSort<Container>>>          ("SmartQuickSort (using Bubble)",       to_sort);
+    TestSort<IncreasingSmartQuickSort<Container, IncreasingHeapSort<Container, BinaryHeap>>>("SmartQuickSort (using HeapSort)",     to_sort);
+    TestSort<IncreasingTunedSmartMergeSort<Container>>                                      ("SmartMergeSort (tuned)",              to_sort);
+    TestSort<IncreasingTunedSmartQuickSort<Container>>                                      ("SmartQuickSort (tuned)",              to_sort);
+
+    TestIsas(to_search);
+
+    std::cout << "\nFinding\n";
+    MaximumSubarray<SignedContainer>::ReturnType ret = MaximumSubarray<SignedContainer>::Search(to_search);
+    std::cout << "From " << ret.start << " to " << ret.end << " with value " << ret.sum << '\n';
+
+    SignedContainer::value_type ith_stat = OrderStatistic<SignedContainer>::Search(to_search, count >> 2);
+    std::cout << "Order Statistic: Finding " << (count >> 2) << "th stat, " << ith_stat << '\n';
+    
+    int temp;
+    std::cin >> temp;
+
+    return 0;
 }
\ No newline at end of file
@@ -1,3 +1,12 @@
+newoption
+{
+	trigger = "arch",
+	value = "ARCH",
+	description = "-march for the optimized gcc/clang configurations, none to leave it out (default native)"
+}
+
+archflag = _OPTIONS["arch"] or "native"
+
 workspace "DS_AND_ALGO"
 	architecture "x86_64"
 	startproject "Test"
@@ -6,7 +15,14 @@ workspace "DS_AND_ALGO"
 	{
 		"Debug",
 		"Release",
-		"Dist"
+		"Dist",
+		"Profile",
+		"PGOInstrument",
+		"PGOUse",
+		"ThinLTO",
+		"ASan",
+		"UBSan",
+		"TSan"
 	}
 	
 	flags
@@ -14,6 +30,83 @@ workspace "DS_AND_ALGO"
 		"MultiProcessorCompile"
 	}
 
+	-- The configurations past Dist are the same for every project, so they live here instead of in each one
+
+	-- Release with symbols and frame pointers, for perf and friends
+	filter "configurations:Profile"
+		runtime "Release"
+		optimize "on"
+		symbols "on"
+
+	filter { "configurations:Profile", "system:not windows" }
+		buildoptions { "-fno-omit-frame-pointer", "-mno-omit-leaf-frame-pointer" }
+
+	-- PGOInstrument leaves profiles in bin-int/PGO when run, PGOUse builds against them. scripts/Linux-PGO.sh
+	-- trains on the Bench suite
+	filter "configurations:PGOInstrument or PGOUse"
+		runtime "Release"
+		optimize "on"
+
+	filter { "configurations:PGOInstrument", "system:not windows" }
+		buildoptions { "-fprofile-generate=%{wks.location}/bin-int/PGO" }
+		linkoptions { "-fprofile-generate=%{wks.location}/bin-int/PGO" }
+
+	filter { "configurations:PGOUse", "system:not windows" }
+		buildoptions { "-fprofile-use=%{wks.location}/bin-int/PGO" }
+
+	filter { "configurations:PGOUse", "toolset:gcc" }
+		buildoptions { "-fprofile-correction", "-Wno-missing-profile" }
+
+	filter "configurations:ThinLTO"
+		runtime "Release"
+		optimize "on"
+
+	filter { "configurations:ThinLTO", "toolset:clang" }
+		buildoptions { "-flto=thin" }
+		linkoptions { "-flto=thin", "-fuse-ld=lld" }
+
+	-- gcc has no ThinLTO, its partitioned whole program mode is the nearest thing
+	filter { "configurations:ThinLTO", "toolset:gcc" }
+		buildoptions { "-flto=auto", "-ffat-lto-objects" }
+		linkoptions { "-flto=auto" }
+
+	filter { "configurations:ThinLTO", "system:windows" }
+		flags { "LinkTimeOptimization" }
+
+	-- Checked builds for the concurrent structures, DEBUG keeps the heap asserts on
+	filter "configurations:ASan or UBSan or TSan"
+		runtime "Debug"
+		symbols "on"
+		optimize "Debug"
+
+		defines
+		{
+			"DEBUG"
+		}
+
+	filter { "configurations:ASan", "system:not windows" }
+		buildoptions { "-fsanitize=address", "-fno-omit-frame-pointer" }
+		linkoptions { "-fsanitize=address" }
+
+	filter { "configurations:ASan", "system:windows" }
+		buildoptions { "/fsanitize=address" }
+
+	filter { "configurations:UBSan", "system:not windows" }
+		buildoptions { "-fsanitize=undefined", "-fno-sanitize-recover=undefined" }
+		linkoptions { "-fsanitize=undefined" }
+
+	filter { "configurations:TSan", "system:not windows" }
+		buildoptions { "-fsanitize=thread" }
+		linkoptions { "-fsanitize=thread" }
+
+	-- Tuned for the build machine, pass --arch=none for a portable binary. Dist never gets it
+	filter { "configurations:Release or Profile or PGOInstrument or PGOUse or ThinLTO", "system:not windows" }
+		if archflag ~= "none" then
+			buildoptions { "-march=" .. archflag }
+		end
+
+	filter {}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 -- Include directories relative to root folder (solution directory)
@@ -32,7 +125,6 @@ project "Datastructures"
 	kind "StaticLib"
 	language "C++"
 	cppdialect "C++17"
-	staticruntime "on"
 
 	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
 	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
@@ -40,6 +132,7 @@ project "Datastructures"
 	files
 	{
 		"%{prj.name}/*.cpp",
+		"%{prj.name}/*.hpp",
 		"%{prj.name}/heaps/**",
 		"%{prj.name}/trees/**"
 	}
@@ -58,6 +151,7 @@ project "Datastructures"
 
 	filter "system:windows"
 		systemversion "latest"
+		staticruntime "on"
 
 		defines
 		{
@@ -80,12 +174,15 @@ project "Datastructures"
 		runtime "Release"
 		optimize "on"
 
+	-- gcc matches profiles up by object path, so both PGO builds share one object directory. Clean in between
+	filter "configurations:PGOInstrument or PGOUse"
+		objdir ("!bin-int/PGO-%{cfg.system}-%{cfg.architecture}/%{prj.name}")
+
 project "Algorithms"
 	location "Algorithms"
 	kind "StaticLib"
 	language "C++"
 	cppdialect "C++17"
-	staticruntime "on"
 
 	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
 	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
@@ -94,7 +191,8 @@ project "Algorithms"
 	{
 		"%{prj.name}/*.cpp",
 		"%{prj.name}/sort/**",
-		"%{prj.name}/search/**"
+		"%{prj.name}/search/**",
+		"%{prj.name}/simd/**"
 	}
 
 	defines
@@ -113,6 +211,7 @@ project "Algorithms"
 
 	filter "system:windows"
 		systemversion "latest"
+		staticruntime "on"
 
 		defines
 		{
@@ -135,12 +234,15 @@ project "Algorithms"
 		runtime "Release"
 		optimize "on"
 
+	-- gcc matches profiles up by object path, so both PGO builds share one object directory. Clean in between
+	filter "configurations:PGOInstrument or PGOUse"
+		objdir ("!bin-int/PGO-%{cfg.system}-%{cfg.architecture}/%{prj.name}")
+
 project "Test"
 	location "Test"
 	kind "ConsoleApp"
 	language "C++"
 	cppdialect "C++17"
-	staticruntime "on"
 
 	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
 	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
@@ -156,7 +258,70 @@ project "Test"
 		"Datastructures/heaps",
 		"Datastructures/trees",
 		"Algorithms/sort",
-		"Algorithms/search"
+		"Algorithms/search",
+		"Algorithms/simd",
+		"Bench"
+	}
+
+	links
+	{
+		"Datastructures",
+		"Algorithms"
+	}
+
+	filter "system:linux"
+		links
+		{
+			"pthread"
+		}
+
+	filter "system:windows"
+		systemversion "latest"
+		staticruntime "on"
+		
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+		defines
+		{
+			"DEBUG"
+		}
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		runtime "Release"
+		optimize "on"
+
+	-- gcc matches profiles up by object path, so both PGO builds share one object directory. Clean in between
+	filter "configurations:PGOInstrument or PGOUse"
+		objdir ("!bin-int/PGO-%{cfg.system}-%{cfg.architecture}/%{prj.name}")
+
+project "Bench"
+	location "Bench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/**.hpp",
+		"%{prj.name}/**.cpp"
+	}
+
+	includedirs
+	{
+		"Datastructures/heaps",
+		"Datastructures/trees",
+		"Algorithms/sort",
+		"Algorithms/search",
+		"Algorithms/simd"
 	}
 
 	links
@@ -165,8 +330,15 @@ project "Test"
 		"Algorithms"
 	}
 
+	filter "system:linux"
+		links
+		{
+			"pthread"
+		}
+
 	filter "system:windows"
 		systemversion "latest"
+		staticruntime "on"
 		
 	filter "configurations:Debug"
 		runtime "Debug"
@@ -184,3 +356,7 @@ project "Test"
 	filter "configurations:Dist"
 		runtime "Release"
 		optimize "on"
+
+	-- gcc matches profiles up by object path, so both PGO builds share one object directory. Clean in between
+	filter "configurations:PGOInstrument or PGOUse"
+		objdir ("!bin-int/PGO-%{cfg.system}-%{cfg.architecture}/%{prj.name}")
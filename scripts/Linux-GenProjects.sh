@@ -0,0 +1,5 @@
+#!/bin/sh
+# Makefiles for every configuration, then: make config=release (or profile, thinlto, asan, ...) -j$(nproc)
+# Extra arguments go to premake, e.g. --cc=clang or --arch=none
+cd "$(dirname "$0")/.."
+premake5 gmake2 "$@"
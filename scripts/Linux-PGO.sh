@@ -0,0 +1,24 @@
+#!/bin/sh
+# Profile guided Bench: an instrumented build runs the benchmark suite, then the optimized build reads what it left
+# in bin-int/PGO.  TOOLSET=clang to use clang, extra arguments go to the training run
+set -e
+cd "$(dirname "$0")/.."
+
+TOOLSET=${TOOLSET:-gcc}
+
+premake5 --cc="$TOOLSET" gmake2
+
+rm -rf bin-int/PGO
+make config=pgoinstrument clean
+make config=pgoinstrument Bench -j"$(nproc)"
+bin/PGOInstrument-linux-x86_64/Bench/Bench --reps 3 --warmup 1 "$@" > /dev/null
+
+# clang writes raw profiles that have to be merged first, gcc reads its own directly
+if [ "$TOOLSET" = "clang" ]; then
+    llvm-profdata merge -output=bin-int/PGO/default.profdata bin-int/PGO/*.profraw
+fi
+
+# Same object directory as the instrumented build, so it has to rebuild from scratch
+make config=pgouse clean
+make config=pgouse Bench -j"$(nproc)"
+echo "bin/PGOUse-linux-x86_64/Bench/Bench"